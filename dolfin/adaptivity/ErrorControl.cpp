@@ -18,8 +18,10 @@
 // Modified by Anders Logg, 2011.
 //
 // First added:  2010-09-16
-// Last changed: 2011-03-23
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <Eigen/Dense>
 
@@ -44,7 +46,9 @@
 #include <dolfin/la/solve.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Facet.h>
+#include <dolfin/parameter/GlobalParameters.h>
 
+#include "Extrapolation.h"
 #include "LocalAssembler.h"
 #include "ErrorControl.h"
 
@@ -162,10 +166,16 @@ void ErrorControl::compute_extrapolation(const Function& z,
 {
   log(PROGRESS, "Extrapolating dual solution.");
 
-  // Extrapolate
+  // Extrapolate (the extrapolation operator depends only on the
+  // function spaces and is reused)
   dolfin_assert(_extrapolation_space);
+  if (!_extrapolation)
+  {
+    _extrapolation.reset(new Extrapolation(z.function_space(),
+                                           _extrapolation_space));
+  }
   _Ez_h.reset(new Function(_extrapolation_space));
-  _Ez_h->extrapolate(z);
+  _extrapolation->apply(*_Ez_h, z);
 
   // Apply appropriate boundary conditions to extrapolation
   apply_bcs_to_extrapolation(bcs);
@@ -273,23 +283,11 @@ void ErrorControl::compute_cell_residual(Function& R_T, const Function& u)
     _L_R_T->set_coefficient(num_coeffs - 2, _u);
   }
 
-  // Create data structures for local assembly data
-  UFC ufc_lhs(*_a_R_T);
-  UFC ufc_rhs(*_L_R_T);
-
-  // Extract common space, mesh and dofmap
+  // Extract dofmap
   const FunctionSpace& V = *R_T.function_space();
-  dolfin_assert(V.mesh());
-  const Mesh& mesh(*V.mesh());
   dolfin_assert(V.dofmap());
   const GenericDofMap& dofmap = *V.dofmap();
 
-  // Define matrices for cell-residual problems
-  dolfin_assert(V.element());
-  const std::size_t N = V.element()->space_dimension();
-  Eigen::MatrixXd A(N, N), b(N, 1);
-  Eigen::VectorXd x(N);
-
   // Extract cell_domains etc from right-hand side form
   const MeshFunction<std::size_t>*
     cell_domains = _L_R_T->cell_domains().get();
@@ -299,31 +297,10 @@ void ErrorControl::compute_cell_residual(Function& R_T, const Function& u)
     interior_facet_domains = _L_R_T->interior_facet_domains().get();
 
   // Assemble and solve local linear systems
-  ufc::cell ufc_cell;
-  std::vector<double> vertex_coordinates;
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
-  {
-    // Get cell vertices
-    cell->get_vertex_coordinates(vertex_coordinates);
-
-    // Assemble local linear system
-    LocalAssembler::assemble(A, ufc_lhs, vertex_coordinates,
-                             ufc_cell, *cell, cell_domains,
-                             exterior_facet_domains, interior_facet_domains);
-    LocalAssembler::assemble(b, ufc_rhs, vertex_coordinates, ufc_cell,
-                             *cell, cell_domains,
-                             exterior_facet_domains, interior_facet_domains);
-
-    // Solve linear system and convert result
-    x = A.partialPivLu().solve(b);
-
-    // Get local-to-global dof map for cell
-    const std::vector<dolfin::la_index>& dofs = dofmap.cell_dofs(cell->index());
-
-    // Plug local solution into global vector
-    dolfin_assert(R_T.vector());
-    R_T.vector()->set(x.data(), N, &dofs[0]);
-  }
+  dolfin_assert(R_T.vector());
+  solve_local_problems(*R_T.vector(), *_a_R_T, *_L_R_T, dofmap,
+                       cell_domains, exterior_facet_domains,
+                       interior_facet_domains, false);
   end();
 }
 //-----------------------------------------------------------------------------
@@ -336,8 +313,6 @@ void ErrorControl::compute_facet_residual(SpecialFacetFunction& R_dT,
   // Extract function space for facet residual approximation
   dolfin_assert(R_dT[0].function_space());
   const FunctionSpace& V = *R_dT[0].function_space();
-  dolfin_assert(V.element());
-  const std::size_t N = V.element()->space_dimension();
 
   // Extract mesh
   dolfin_assert(V.mesh());
@@ -369,10 +344,6 @@ void ErrorControl::compute_facet_residual(SpecialFacetFunction& R_dT,
   dolfin_assert(V.dofmap());
   const GenericDofMap& dofmap = *V.dofmap();
 
-  // Define matrices for facet-residual problems
-  Eigen::MatrixXd A(N, N), b(N, 1);
-  Eigen::VectorXd x(N);
-
   // Variables to be used for the construction of the cone function
   const std::size_t num_cells = mesh.num_cells();
   const std::vector<double> ones(num_cells, 1.0);
@@ -410,49 +381,93 @@ void ErrorControl::compute_facet_residual(SpecialFacetFunction& R_dT,
     _a_R_dT->set_coefficient(0, _cell_cone);
     _L_R_dT->set_coefficient(L_R_dT_num_coefficients - 1, _cell_cone);
 
-    // Create data structures for local assembly data
-    UFC ufc_lhs(*_a_R_dT);
-    UFC ufc_rhs(*_L_R_dT);
-
     // Assemble and solve local linear systems
-    ufc::cell ufc_cell;
-    std::vector<double> vertex_coordinates;
-    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    dolfin_assert(R_dT[local_facet].vector());
+    solve_local_problems(*R_dT[local_facet].vector(), *_a_R_dT, *_L_R_dT,
+                         dofmap, cell_domains, exterior_facet_domains,
+                         interior_facet_domains, true);
+  }
+  end();
+}
+//-----------------------------------------------------------------------------
+void ErrorControl::solve_local_problems(GenericVector& x,
+                          const Form& a, const Form& L,
+                          const GenericDofMap& dofmap,
+                          const MeshFunction<std::size_t>* cell_domains,
+                          const MeshFunction<std::size_t>* exterior_facet_domains,
+                          const MeshFunction<std::size_t>* interior_facet_domains,
+                          bool nonsingularize)
+{
+  const Mesh& mesh = a.mesh();
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t N = dofmap.max_cell_dimension();
+
+  // Local problems are solved for owned cells only
+  const int num_cells = mesh.topology().ghost_offset(D);
+
+  // Facet connectivity used by the local assembler must be computed
+  // before the parallel loop (lazy initialisation is not thread-safe)
+  mesh.init(D - 1);
+  mesh.init(D, D - 1);
+  mesh.init(D - 1, D);
+
+  // Local solutions and dofs for all cells, inserted into x after the
+  // parallel loop (insertion into x is not thread-safe)
+  std::vector<double> values(num_cells*N);
+  std::vector<dolfin::la_index> dofs(num_cells*N);
+
+  // Data for local assembly. Each thread works on its own copy.
+  UFC ufc_lhs(a);
+  UFC ufc_rhs(L);
+  ufc::cell ufc_cell;
+  std::vector<double> vertex_coordinates;
+  Eigen::MatrixXd A(N, N), b(N, 1);
+  Eigen::VectorXd y(N);
+
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) dolfin::parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(guided, 20) \
+    firstprivate(ufc_lhs, ufc_rhs, ufc_cell, vertex_coordinates, A, b, y)
+  #endif
+  for (int i = 0; i < num_cells; ++i)
+  {
+    const Cell cell(mesh, i);
+    cell.get_vertex_coordinates(vertex_coordinates);
+
+    // Assemble local linear system
+    LocalAssembler::assemble(A, ufc_lhs, vertex_coordinates, ufc_cell,
+                             cell, cell_domains,
+                             exterior_facet_domains, interior_facet_domains);
+    LocalAssembler::assemble(b, ufc_rhs, vertex_coordinates, ufc_cell,
+                             cell, cell_domains,
+                             exterior_facet_domains, interior_facet_domains);
+
+    // Non-singularize local matrix
+    if (nonsingularize)
     {
-      // Get cell vertex_coordinates
-      cell->get_vertex_coordinates(vertex_coordinates);
-
-      // Assemble linear system
-      LocalAssembler::assemble(A, ufc_lhs, vertex_coordinates,
-                               ufc_cell, *cell, cell_domains,
-                               exterior_facet_domains, interior_facet_domains);
-      LocalAssembler::assemble(b, ufc_rhs, vertex_coordinates,
-                               ufc_cell, *cell, cell_domains,
-                               exterior_facet_domains, interior_facet_domains);
-
-      // Non-singularize local matrix
-      for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = 0; j < N; ++j)
       {
-        if (std::abs(A(i, i)) < 1.0e-10)
+        if (std::abs(A(j, j)) < 1.0e-10)
         {
-          A(i, i) = 1.0;
-          b(i) = 0.0;
+          A(j, j) = 1.0;
+          b(j) = 0.0;
         }
       }
+    }
 
-      // Solve linear system and convert result
-      x = A.partialPivLu().solve(b);
-
-      // Get local-to-global dof map for cell
-      const std::vector<dolfin::la_index>& dofs
-        = dofmap.cell_dofs(cell->index());
+    // Solve linear system
+    y = A.partialPivLu().solve(b);
 
-      // Plug local solution into global vector
-      dolfin_assert(R_dT[local_facet].vector());
-      R_dT[local_facet].vector()->set(x.data(), N, &dofs[0]);
-    }
+    // Store solution and local-to-global dof map for cell
+    const std::vector<dolfin::la_index>& cell_dofs = dofmap.cell_dofs(i);
+    dolfin_assert(cell_dofs.size() == N);
+    std::copy(y.data(), y.data() + N, values.begin() + i*N);
+    std::copy(cell_dofs.begin(), cell_dofs.end(), dofs.begin() + i*N);
   }
-  end();
+
+  // Plug local solutions into global vector
+  if (!values.empty())
+    x.set(values.data(), values.size(), dofs.data());
 }
 //-----------------------------------------------------------------------------
 void ErrorControl::apply_bcs_to_extrapolation(
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-08-19
-// Last changed: 2012-09-03
+// Last changed: 2026-10-19
 
 #ifndef __ERROR_CONTROL_H
 #define __ERROR_CONTROL_H
@@ -33,9 +33,12 @@ namespace dolfin
 {
 
   class DirichletBC;
+  class Extrapolation;
   class Form;
   class Function;
   class FunctionSpace;
+  class GenericDofMap;
+  class GenericVector;
   class SpecialFacetFunction;
   class Vector;
 
@@ -203,6 +206,19 @@ namespace dolfin
 
     void apply_bcs_to_extrapolation(const std::vector<std::shared_ptr<const DirichletBC> > bcs);
 
+    // Assemble and solve the local problem a(v, w) = L(w) on each
+    // cell and insert the solutions into x. Cells are processed in
+    // parallel (OpenMP) with one UFC object per thread. If
+    // nonsingularize is true, rows with a (near) zero diagonal are
+    // replaced by identity rows.
+    static void solve_local_problems(GenericVector& x,
+                                     const Form& a, const Form& L,
+                                     const GenericDofMap& dofmap,
+                                     const MeshFunction<std::size_t>* cell_domains,
+                                     const MeshFunction<std::size_t>* exterior_facet_domains,
+                                     const MeshFunction<std::size_t>* interior_facet_domains,
+                                     bool nonsingularize);
+
     // Bilinear and linear form for dual problem
     std::shared_ptr<Form> _a_star;
     std::shared_ptr<Form> _L_star;
@@ -224,6 +240,9 @@ namespace dolfin
     // Computed extrapolation
     std::shared_ptr<Function> _Ez_h;
 
+    // Extrapolation operator (built on first use)
+    std::shared_ptr<Extrapolation> _extrapolation;
+
     bool _is_linear;
 
     // Function spaces for extrapolation, cell bubble and cell cone:
@@ -19,281 +19,307 @@
 // Modified by Garth N. Wells, 2010
 //
 // First added:  2009-12-08
-// Last changed: 2011-11-12
+// Last changed: 2026-10-19
 //
 
+#include <algorithm>
 #include <vector>
 #include <Eigen/Dense>
 #include <ufc.h>
 
-#include <dolfin/common/Array.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/fem/BasisFunction.h>
-#include <dolfin/fem/DirichletBC.h>
 #include <dolfin/fem/GenericDofMap.h>
 #include <dolfin/function/Function.h>
 #include <dolfin/function/FunctionSpace.h>
 #include <dolfin/la/GenericVector.h>
 #include <dolfin/log/log.h>
-#include <dolfin/mesh/BoundaryMesh.h>
 #include <dolfin/mesh/Cell.h>
-#include <dolfin/mesh/FacetCell.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Extrapolation.h"
 
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-void Extrapolation::extrapolate(Function& w, const Function& v)
+Extrapolation::Extrapolation(std::shared_ptr<const FunctionSpace> V,
+                             std::shared_ptr<const FunctionSpace> W)
+  : _V(V), _W(W), _num_patches(0)
 {
   // Using set_local for simplicity here
   not_working_in_parallel("Extrapolation of functions");
 
   // Check that the meshes are the same
-  if (w.function_space()->mesh() != v.function_space()->mesh())
+  dolfin_assert(V);
+  dolfin_assert(W);
+  if (V->mesh() != W->mesh())
   {
     dolfin_error("Extrapolation.cpp",
                  "compute extrapolation",
                  "Extrapolation must be computed on the same mesh");
   }
 
-  // Extract mesh and function spaces
-  const FunctionSpace& V = *v.function_space();
-  const FunctionSpace& W = *w.function_space();
-  dolfin_assert(V.mesh());
-  const Mesh& mesh = *V.mesh();
+  Timer timer("Build extrapolation patches");
+
+  // Extract mesh
+  dolfin_assert(V->mesh());
+  const Mesh& mesh = *V->mesh();
 
   // Initialize cell-cell connectivity
   const std::size_t D = mesh.topology().dim();
   mesh.init(D, D);
 
-  // UFC cell view of center cell and vertex coordinate holder
-  ufc::cell c0;
-  std::vector<double> vertex_coordinates0;
+  // Extract non-mixed sub spaces (one patch per cell and sub space)
+  std::vector<std::shared_ptr<const FunctionSpace> > V_sub, W_sub;
+  extract_sub_spaces(V_sub, W_sub, V, W);
+  const std::size_t num_sub_spaces = V_sub.size();
+  _num_patches = mesh.num_cells()*num_sub_spaces;
 
-  // List of values for each dof of w (multivalued until we average)
-  std::vector<std::vector<double> > coefficients;
-  coefficients.resize(W.dim());
+  // Find largest dof index of V (dofs of sub spaces are numbered
+  // within the parent space)
+  std::size_t num_dofs = 0;
+  for (std::size_t k = 0; k < num_sub_spaces; k++)
+  {
+    dolfin_assert(V_sub[k]->dofmap());
+    const GenericDofMap& dofmap = *V_sub[k]->dofmap();
+    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    {
+      const std::vector<dolfin::la_index>& dofs
+        = dofmap.cell_dofs(cell->index());
+      for (std::size_t i = 0; i < dofs.size(); i++)
+        num_dofs = std::max(num_dofs, (std::size_t) dofs[i] + 1);
+    }
+  }
 
-  // Iterate over cells in mesh
-  dolfin_assert(W.dofmap());
+  // Cell and local dof for each row of the least-squares systems
+  std::vector<std::size_t> row_cells, row_local_dofs;
+
+  // Last patch in which a dof of V has been used (to keep dofs
+  // unique within each patch)
+  std::vector<std::size_t> last_patch(num_dofs, _num_patches);
+
+  // Build patches: the unique dofs of V on the center cell and its
+  // neighbours, and the dofs of W on the center cell
+  dolfin_assert(W->dofmap());
+  _num_contributions.assign(W->dim(), 0);
+  _patch_offsets.assign(1, 0);
+  _cell_offsets.assign(1, 0);
+  _operator_offsets.assign(1, 0);
+  std::vector<std::size_t> patch_cells;
+  std::size_t p = 0;
   for (CellIterator cell0(mesh); !cell0.end(); ++cell0)
   {
-    // Update UFC view
-    cell0->get_vertex_coordinates(vertex_coordinates0);
-    cell0->get_cell_data(c0);
+    const std::vector<dolfin::la_index>& W_dofs
+      = W->dofmap()->cell_dofs(cell0->index());
+    std::size_t offset = 0;
 
-    // Tabulate dofs for w on cell and store values
-    const std::vector<dolfin::la_index>& dofs
-      = W.dofmap()->cell_dofs(cell0->index());
+    // Center cell first, then neighbouring cells
+    patch_cells.assign(1, cell0->index());
+    for (CellIterator cell1(*cell0); !cell1.end(); ++cell1)
+      patch_cells.push_back(cell1->index());
 
-    // Compute coefficients on this cell
-    std::size_t offset = 0;
-    compute_coefficients(coefficients, v, V, W, *cell0, vertex_coordinates0,
-                         c0, dofs, offset);
+    for (std::size_t k = 0; k < num_sub_spaces; k++, p++)
+    {
+      const GenericDofMap& dofmap = *V_sub[k]->dofmap();
+      for (std::size_t c = 0; c < patch_cells.size(); c++)
+      {
+        const std::vector<dolfin::la_index>& dofs
+          = dofmap.cell_dofs(patch_cells[c]);
+        for (std::size_t i = 0; i < dofs.size(); i++)
+        {
+          // Ignore if this degree of freedom is already considered
+          if (last_patch[dofs[i]] == p)
+            continue;
+          last_patch[dofs[i]] = p;
+
+          _patch_dofs.push_back(dofs[i]);
+          row_cells.push_back(patch_cells[c]);
+          row_local_dofs.push_back(i);
+        }
+      }
+
+      // Check size of system
+      dolfin_assert(W_sub[k]->element());
+      const std::size_t N = W_sub[k]->element()->space_dimension();
+      const std::size_t M = _patch_dofs.size() - _patch_offsets.back();
+      if (M < N)
+      {
+        dolfin_error("Extrapolation.cpp",
+                     "compute extrapolation",
+                     "Not enough degrees of freedom on local patch to build extrapolation");
+      }
+
+      // Store dofs of W on center cell
+      for (std::size_t i = 0; i < N; i++)
+      {
+        _cell_dofs.push_back(W_dofs[i + offset]);
+        _num_contributions[W_dofs[i + offset]]++;
+      }
+      offset += N;
+
+      _patch_offsets.push_back(_patch_dofs.size());
+      _cell_offsets.push_back(_cell_dofs.size());
+      _operator_offsets.push_back(_operator_offsets.back() + N*M);
+    }
+  }
+  dolfin_assert(p == _num_patches);
+
+  // Compute least-squares operators in parallel
+  _operators.resize(_operator_offsets.back());
+  const int num_patches = _num_patches;
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(guided, 20)
+  #endif
+  for (int q = 0; q < num_patches; q++)
+  {
+    const std::size_t k = q % num_sub_spaces;
+    compute_operator(q, q/num_sub_spaces, *V_sub[k], *W_sub[k],
+                     row_cells, row_local_dofs);
   }
-
-  // Average coefficients
-  average_coefficients(w, coefficients);
 }
 //-----------------------------------------------------------------------------
-void
-Extrapolation::compute_coefficients(std::vector<std::vector<double> >& coefficients,
-                                    const Function& v,
-                                    const FunctionSpace& V,
-                                    const FunctionSpace& W,
-                                    const Cell& cell0,
-                                    const std::vector<double>& vertex_coordinates0,
-                                    const ufc::cell& c0,
-                                    const std::vector<dolfin::la_index>& dofs,
-                                    std::size_t& offset)
+Extrapolation::~Extrapolation()
 {
-  // Call recursively for mixed elements
-  dolfin_assert(V.element());
-  const std::size_t num_sub_spaces = V.element()->num_sub_elements();
-  if (num_sub_spaces > 0)
-  {
-    for (std::size_t k = 0; k < num_sub_spaces; k++)
-    {
-      compute_coefficients(coefficients, v[k], *V[k], *W[k], cell0,
-                           vertex_coordinates0, c0, dofs, offset);
-    }
-    return;
-  }
-
-  // Build data structures for keeping track of unique dofs
-  std::map<std::size_t, std::map<std::size_t, std::size_t> > cell2dof2row;
-  std::set<std::size_t> unique_dofs;
-  build_unique_dofs(unique_dofs, cell2dof2row, cell0, V);
-
-  // Compute size of linear system
-  dolfin_assert(W.element());
-  const std::size_t N = W.element()->space_dimension();
-  const std::size_t M = unique_dofs.size();
-
-  // Check size of system
-  if (M < N)
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void Extrapolation::apply(Function& w, const Function& v) const
+{
+  // Check function spaces
+  dolfin_assert(v.function_space());
+  dolfin_assert(w.function_space());
+  if (!(*v.function_space() == *_V) || !(*w.function_space() == *_W))
   {
     dolfin_error("Extrapolation.cpp",
                  "compute extrapolation",
-                 "Not enough degrees of freedom on local patch to build extrapolation");
+                 "Functions are not in the function spaces of the extrapolation");
   }
 
-  // Create matrix and vector for linear system
-  Eigen::MatrixXd A(M, N);
-  Eigen::VectorXd b(M);
-
-  // Add equations on cell and neighboring cells
-  add_cell_equations(A, b, cell0, cell0,
-                     vertex_coordinates0, vertex_coordinates0,
-                     c0, c0, V, W, v, cell2dof2row[cell0.index()]);
-  dolfin_assert(V.mesh());
-  ufc::cell c1;
-  std::vector<double> vertex_coordinates1;
-  for (CellIterator cell1(cell0); !cell1.end(); ++cell1)
+  // Get values of v
+  dolfin_assert(v.vector());
+  std::vector<double> v_values;
+  v.vector()->get_local(v_values);
+
+  // Solve least-squares problems on all patches
+  std::vector<double> values(_cell_dofs.size());
+  const int num_patches = _num_patches;
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int p = 0; p < num_patches; p++)
   {
-    if (cell2dof2row[cell1->index()].empty())
-      continue;
-
-    cell1->get_vertex_coordinates(vertex_coordinates1);
-    cell1->get_cell_data(c1);
-    add_cell_equations(A, b, cell0, *cell1,
-                       vertex_coordinates0, vertex_coordinates1,
-                       c0, c1, V, W, v,
-                       cell2dof2row[cell1->index()]);
+    const std::size_t N = _cell_offsets[p + 1] - _cell_offsets[p];
+    const std::size_t M = _patch_offsets[p + 1] - _patch_offsets[p];
+    const dolfin::la_index* dofs = _patch_dofs.data() + _patch_offsets[p];
+    const double* A = _operators.data() + _operator_offsets[p];
+    double* x = values.data() + _cell_offsets[p];
+
+    std::fill(x, x + N, 0.0);
+    for (std::size_t j = 0; j < M; j++)
+    {
+      const double b = v_values[dofs[j]];
+      const double* Aj = A + j*N;
+      for (std::size_t i = 0; i < N; i++)
+        x[i] += Aj[i]*b;
+    }
   }
 
-  // Solve least squares system
-  const Eigen::VectorXd x
-    = A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
-
-  // Insert resulting coefficients into global coefficient vector
-  dolfin_assert(W.dofmap());
-  for (std::size_t i = 0; i < W.dofmap()->cell_dimension(cell0.index()); ++i)
-    coefficients[dofs[i + offset]].push_back(x[i]);
+  // Average coefficients
+  std::vector<double> dof_values(_num_contributions.size(), 0.0);
+  for (std::size_t i = 0; i < _cell_dofs.size(); i++)
+    dof_values[_cell_dofs[i]] += values[i];
+  for (std::size_t i = 0; i < dof_values.size(); i++)
+    dof_values[i] /= static_cast<double>(_num_contributions[i]);
 
-  // Increase offset
-  offset += W.dofmap()->cell_dimension(cell0.index());
+  // Update dofs for w
+  dolfin_assert(w.vector());
+  w.vector()->set_local(dof_values);
 }
 //-----------------------------------------------------------------------------
-void
-Extrapolation::build_unique_dofs(std::set<std::size_t>& unique_dofs,
-                                 std::map<std::size_t, std::map<std::size_t, std::size_t> >& cell2dof2row,
-                                 const Cell& cell0,
-                                 const FunctionSpace& V)
+void Extrapolation::extrapolate(Function& w, const Function& v)
 {
-  // Counter for matrix row index
-  std::size_t row = 0;
-  dolfin_assert(V.mesh());
-
-  // Compute unique dofs on center cell
-  cell2dof2row[cell0.index()] = compute_unique_dofs(cell0, V, row, unique_dofs);
-
-  // Compute unique dofs on neighbouring cells
-  for (CellIterator cell1(cell0); !cell1.end(); ++cell1)
-  {
-    cell2dof2row[cell1->index()] = compute_unique_dofs(*cell1, V, row,
-                                                       unique_dofs);
-  }
+  Extrapolation extrapolation(v.function_space(), w.function_space());
+  extrapolation.apply(w, v);
 }
 //-----------------------------------------------------------------------------
-void
-Extrapolation::add_cell_equations(Eigen::MatrixXd& A,
-                                  Eigen::VectorXd& b,
-                                  const Cell& cell0,
-                                  const Cell& cell1,
-                                  const std::vector<double>& vertex_coordinates0,
-                                  const std::vector<double>& vertex_coordinates1,
-                                  const ufc::cell& c0,
-                                  const ufc::cell& c1,
-                                  const FunctionSpace& V,
-                                  const FunctionSpace& W,
-                                  const Function& v,
-                                  std::map<std::size_t, std::size_t>& dof2row)
+void Extrapolation::extract_sub_spaces(
+  std::vector<std::shared_ptr<const FunctionSpace> >& V_sub,
+  std::vector<std::shared_ptr<const FunctionSpace> >& W_sub,
+  std::shared_ptr<const FunctionSpace> V,
+  std::shared_ptr<const FunctionSpace> W)
 {
-  // Extract coefficients for v on patch cell
-  dolfin_assert(V.element());
-  std::vector<double> dof_values(V.element()->space_dimension());
-  v.restrict(&dof_values[0], *V.element(), cell1, vertex_coordinates1.data(),
-             c1);
-
-  // Iterate over given local dofs for V on patch cell
-  dolfin_assert(W.element());
-  for (std::map<std::size_t, std::size_t>::iterator it = dof2row.begin();
-       it!= dof2row.end(); it++)
+  // Call recursively for mixed elements
+  dolfin_assert(V->element());
+  const std::size_t num_sub_spaces = V->element()->num_sub_elements();
+  if (num_sub_spaces > 0)
   {
-    const std::size_t i = it->first;
-    const std::size_t row = it->second;
-
-    // Iterate over basis functions for W on center cell
-    for (std::size_t j = 0; j < W.element()->space_dimension(); ++j)
-    {
-      // Create basis function
-      const BasisFunction phi(j, *W.element(), vertex_coordinates0);
-
-      // Evaluate dof on basis function
-      const double dof_value
-        = V.element()->evaluate_dof(i, phi,  vertex_coordinates1.data(),
-                                    c1.orientation, c1);
-
-      // Insert dof_value into matrix
-      A(row, j) = dof_value;
-    }
-
-    // Insert coefficient into vector
-    b[row] = dof_values[i];
+    for (std::size_t k = 0; k < num_sub_spaces; k++)
+      extract_sub_spaces(V_sub, W_sub, (*V)[k], (*W)[k]);
+    return;
   }
+
+  V_sub.push_back(V);
+  W_sub.push_back(W);
 }
 //-----------------------------------------------------------------------------
-std::map<std::size_t, std::size_t>
-Extrapolation::compute_unique_dofs(const Cell& cell,
-                                   const FunctionSpace& V,
-                                   std::size_t& row,
-                                   std::set<std::size_t>& unique_dofs)
+void
+Extrapolation::compute_operator(std::size_t p, std::size_t cell_index,
+                                const FunctionSpace& V,
+                                const FunctionSpace& W,
+                                const std::vector<std::size_t>& row_cells,
+                                const std::vector<std::size_t>& row_local_dofs)
 {
-  dolfin_assert(V.dofmap());
-  const std::vector<dolfin::la_index>& dofs
-    = V.dofmap()->cell_dofs(cell.index());
-
-  // Data structure for current cell
-  std::map<std::size_t, std::size_t> dof2row;
-
-  for (std::size_t i = 0; i < V.dofmap()->cell_dimension(cell.index()); ++i)
-  {
-    // Ignore if this degree of freedom is already considered
-    if (unique_dofs.find(dofs[i]) != unique_dofs.end())
-      continue;
-
-    // Put global index into unique_dofs
-    unique_dofs.insert(dofs[i]);
-
-    // Map local dof index to current matrix row-index
-    dof2row[i] = row;
+  dolfin_assert(V.mesh());
+  dolfin_assert(V.element());
+  dolfin_assert(W.element());
+  const Mesh& mesh = *V.mesh();
+  const FiniteElement& V_element = *V.element();
+  const FiniteElement& W_element = *W.element();
 
-    // Increase row index
-    row++;
-  }
+  const std::size_t N = W_element.space_dimension();
+  const std::size_t M = _patch_offsets[p + 1] - _patch_offsets[p];
 
-  return dof2row;
-}
-//-----------------------------------------------------------------------------
-void Extrapolation::average_coefficients(Function& w,
-                                         std::vector<std::vector<double> >& coefficients)
-{
-  const FunctionSpace& W = *w.function_space();
-  std::vector<double> dof_values(W.dim());
+  // Center cell
+  const Cell cell0(mesh, cell_index);
+  std::vector<double> vertex_coordinates0;
+  cell0.get_vertex_coordinates(vertex_coordinates0);
 
-  for (std::size_t i = 0; i < W.dim(); i++)
+  // Evaluate dofs of V on patch cells for basis functions of W on
+  // center cell
+  Eigen::MatrixXd A(M, N);
+  ufc::cell c1;
+  std::vector<double> vertex_coordinates1;
+  std::size_t current_cell = mesh.num_cells();
+  for (std::size_t row = 0; row < M; row++)
   {
-    double s = 0.0;
-    for (std::size_t j = 0; j < coefficients[i].size(); ++j)
-      s += coefficients[i][j];
+    const std::size_t r = _patch_offsets[p] + row;
+    const Cell cell1(mesh, row_cells[r]);
+    if (row_cells[r] != current_cell)
+    {
+      cell1.get_vertex_coordinates(vertex_coordinates1);
+      cell1.get_cell_data(c1);
+      current_cell = row_cells[r];
+    }
 
-    s /= static_cast<double>(coefficients[i].size());
-    dof_values[i] = s;
+    for (std::size_t j = 0; j < N; ++j)
+    {
+      const BasisFunction phi(j, W_element, vertex_coordinates0);
+      A(row, j) = V_element.evaluate_dof(row_local_dofs[r], phi,
+                                         vertex_coordinates1.data(),
+                                         c1.orientation, c1);
+    }
   }
 
-  // Update dofs for w
-  dolfin_assert(w.vector());
-  w.vector()->set_local(dof_values);
+  // The least-squares solution is x = A^+ b, where only b depends on
+  // the function being extrapolated, so store the pseudo-inverse
+  const Eigen::MatrixXd A_plus
+    = A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV)
+       .solve(Eigen::MatrixXd::Identity(M, M));
+  dolfin_assert((std::size_t) A_plus.rows() == N);
+  dolfin_assert((std::size_t) A_plus.cols() == M);
+  std::copy(A_plus.data(), A_plus.data() + N*M,
+            _operators.begin() + _operator_offsets[p]);
 }
 //-----------------------------------------------------------------------------
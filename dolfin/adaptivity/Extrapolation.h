@@ -19,28 +19,19 @@
 // Modified by Garth N. Wells 2010.
 //
 // First added:  2009-12-08
-// Last changed: 2010-12-28
+// Last changed: 2026-10-19
 
 #ifndef __EXTRAPOLATION_H
 #define __EXTRAPOLATION_H
 
-#include <map>
-#include <set>
+#include <memory>
 #include <vector>
-#include <Eigen/Dense>
 
 #include <dolfin/common/types.h>
 
-namespace ufc
-{
-  class cell;
-}
-
 namespace dolfin
 {
 
-  class Cell;
-  class DirichletBC;
   class Function;
   class FunctionSpace;
 
@@ -55,55 +46,79 @@ namespace dolfin
   ///
   /// It is assumed that the extrapolation is computed on the same
   /// mesh as the original function.
+  ///
+  /// On each cell, the extrapolation is the least-squares fit of a
+  /// function in W to the degrees of freedom of v on the patch of
+  /// neighbouring cells. The patches and the least-squares operators
+  /// depend only on the mesh and the function spaces, so they are
+  /// computed once when an Extrapolation is created and reused by
+  /// each call to apply().
 
   class Extrapolation
   {
   public:
 
+    /// Create extrapolation from V to W
+    ///
+    /// *Arguments*
+    ///     V (_FunctionSpace_)
+    ///         the function space of the function to be extrapolated
+    ///     W (_FunctionSpace_)
+    ///         the function space of the extrapolation
+    Extrapolation(std::shared_ptr<const FunctionSpace> V,
+                  std::shared_ptr<const FunctionSpace> W);
+
+    /// Destructor
+    ~Extrapolation();
+
+    /// Compute extrapolation w from v, where v is in V and w is in W
+    void apply(Function& w, const Function& v) const;
+
     /// Compute extrapolation w from v
     static void extrapolate(Function& w, const Function& v);
 
   private:
 
-    // Build data structures for unique dofs on patch of given cell
-    static void build_unique_dofs(std::set<std::size_t>& unique_dofs,
-                        std::map<std::size_t, std::map<std::size_t, std::size_t> >& cell2dof2row,
-                                  const Cell& cell0,
-                                  const FunctionSpace& V);
-
-    // Compute unique dofs in given cell
-    static std::map<std::size_t, std::size_t>
-      compute_unique_dofs(const Cell& cell, const FunctionSpace& V,
-                          std::size_t& row, std::set<std::size_t>& unique_dofs);
-
-    // Compute coefficients on given cell
-    static void
-      compute_coefficients(std::vector<std::vector<double> >& coefficients,
-                           const Function&v, const FunctionSpace& V,
-                           const FunctionSpace& W, const Cell& cell0,
-                           const std::vector<double>& vertex_coordinates0,
-                           const ufc::cell& c0,
-                           const std::vector<dolfin::la_index>& dofs,
-                           std::size_t& offset);
-
-    // Add equations for current cell
-    static void add_cell_equations(Eigen::MatrixXd& A,
-                                 Eigen::VectorXd& b,
-                                 const Cell& cell0,
-                                 const Cell& cell1,
-                                 const std::vector<double>& vertex_coordinates0,
-                                 const std::vector<double>& vertex_coordinates1,
-                                 const ufc::cell& c0,
-                                 const ufc::cell& c1,
-                                 const FunctionSpace& V,
-                                 const FunctionSpace& W,
-                                 const Function& v,
-                                 std::map<std::size_t, std::size_t>& dof2row);
-
-    // Average coefficients
+    // Collect the non-mixed sub spaces of V and W (recursively)
     static void
-      average_coefficients(Function& w,
-                           std::vector<std::vector<double> >& coefficients);
+      extract_sub_spaces(std::vector<std::shared_ptr<const FunctionSpace> >& V_sub,
+                         std::vector<std::shared_ptr<const FunctionSpace> >& W_sub,
+                         std::shared_ptr<const FunctionSpace> V,
+                         std::shared_ptr<const FunctionSpace> W);
+
+    // Compute (pseudo-inverse) least-squares operator for patch p
+    // centered at given cell
+    void compute_operator(std::size_t p, std::size_t cell_index,
+                          const FunctionSpace& V,
+                          const FunctionSpace& W,
+                          const std::vector<std::size_t>& row_cells,
+                          const std::vector<std::size_t>& row_local_dofs);
+
+    // Function spaces
+    std::shared_ptr<const FunctionSpace> _V;
+    std::shared_ptr<const FunctionSpace> _W;
+
+    // Number of patches (cells times non-mixed sub spaces)
+    std::size_t _num_patches;
+
+    // Dofs of V on patch p (one per row of the least-squares system)
+    // are _patch_dofs[_patch_offsets[p]] ... _patch_dofs[_patch_offsets[p + 1] - 1]
+    std::vector<std::size_t> _patch_offsets;
+    std::vector<dolfin::la_index> _patch_dofs;
+
+    // Dofs of W on center cell of patch p, starting at
+    // _cell_offsets[p]
+    std::vector<std::size_t> _cell_offsets;
+    std::vector<dolfin::la_index> _cell_dofs;
+
+    // Least-squares operators (N x M, column-major, where M and N are
+    // the numbers of V and W dofs of patch p), starting at
+    // _operator_offsets[p]
+    std::vector<std::size_t> _operator_offsets;
+    std::vector<double> _operators;
+
+    // Number of patches contributing to each dof of W
+    std::vector<std::size_t> _num_contributions;
 
   };
 
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-02-10
-// Last changed: 2012-11-29
+// Last changed: 2026-10-19
 
 #include <map>
 #include <memory>
@@ -37,6 +37,7 @@
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/refinement/LocalMeshRefinement.h>
+#include <dolfin/refinement/MarkerTransfer.h>
 #include <dolfin/refinement/UniformMeshRefinement.h>
 #include "ErrorControl.h"
 #include "adapt.h"
@@ -531,48 +532,11 @@ const dolfin::MeshFunction<std::size_t>&
     return mesh_function.child();
   }
 
-  dolfin_assert(mesh_function.mesh());
-  const Mesh& mesh = *mesh_function.mesh();
-  const std::size_t dim = mesh.topology().dim();
-
-  // Extract parent map from data of refined mesh
-  const std::vector<std::size_t>* parent = NULL;
-  if (mesh_function.dim() == dim)
-  {
-    if (adapted_mesh->data().exists("parent_cell", dim))
-      parent = &(adapted_mesh->data().array("parent_cell", dim));
-  }
-  else if (mesh_function.dim() == (dim - 1))
-  {
-    if (adapted_mesh->data().exists("parent_facet", dim - 1))
-      parent = &(adapted_mesh->data().array("parent_facet", dim - 1));
-  }
-  else
-    dolfin_not_implemented();
-
-  // Check that parent map exists
-  if (!parent)
-  {
-    dolfin_error("adapt.cpp",
-                 "adapt mesh function",
-                 "Unable to extract information about parent mesh entities");
-  }
-
-  // Use very large value as 'undefined'
-  const std::size_t undefined = std::numeric_limits<std::size_t>::max();
-
   // Map values of mesh function into refined mesh function
-  std::shared_ptr<MeshFunction<std::size_t> >
-    adapted_mesh_function(new MeshFunction<std::size_t>(*adapted_mesh,
-                                                        mesh_function.dim()));
-  for (std::size_t i = 0; i < adapted_mesh_function->size(); i++)
-  {
-    const std::size_t parent_index = (*parent)[i];
-    if (parent_index < mesh_function.size())
-      (*adapted_mesh_function)[i] = mesh_function[parent_index];
-    else
-      (*adapted_mesh_function)[i] = undefined;
-  }
+  const std::vector<std::shared_ptr<const MeshFunction<std::size_t> > >
+    mesh_functions(1, reference_to_no_delete_pointer(mesh_function));
+  std::shared_ptr<MeshFunction<std::size_t> > adapted_mesh_function
+    = MarkerTransfer::transfer(mesh_functions, adapted_mesh)[0];
 
   // Set parent / child relations
   set_parent_child(mesh_function, adapted_mesh_function);
@@ -601,30 +565,36 @@ void dolfin::adapt_markers(std::vector<std::size_t>& refined_markers,
   const std::vector<std::size_t>& parent_facets
     = adapted_mesh.data().array("parent_facet", D - 1);
 
-  // Create map (parent_cell, parent_local_facet) -> [(child_cell,
-  // child_local_facet), ...] for boundary facets
-
-  std::map<std::size_t, std::vector<std::size_t> > children;
+  // Create map parent facet -> [child facet, ...] for boundary
+  // facets in compressed (offset) form
+  const std::size_t num_facets = mesh.num_entities(D - 1);
+  std::vector<std::size_t> offsets(num_facets + 1, 0);
   for (FacetIterator facet(adapted_mesh); !facet.end(); ++facet)
   {
-    // Ignore interior facets
-    if (facet->num_entities(D) == 2)
-      continue;
-
-    // Extract index of parent facet
     const std::size_t parent_facet_index = parent_facets[facet->index()];
+    if (facet->num_entities(D) != 2 && parent_facet_index < num_facets)
+      ++offsets[parent_facet_index + 1];
+  }
+  for (std::size_t i = 0; i < num_facets; ++i)
+    offsets[i + 1] += offsets[i];
 
-    children[parent_facet_index].push_back(facet->index());
+  std::vector<std::size_t> children(offsets[num_facets]);
+  std::vector<std::size_t> position(offsets.begin(), offsets.end() - 1);
+  for (FacetIterator facet(adapted_mesh); !facet.end(); ++facet)
+  {
+    const std::size_t parent_facet_index = parent_facets[facet->index()];
+    if (facet->num_entities(D) != 2 && parent_facet_index < num_facets)
+      children[position[parent_facet_index]++] = facet->index();
   }
 
   // Use above map to construct refined markers
-  std::vector<std::size_t> child_facets;
-  std::vector<std::size_t>::const_iterator it;
-  for (it = markers.begin(); it != markers.end(); ++it)
+  for (std::vector<std::size_t>::const_iterator it = markers.begin();
+       it != markers.end(); ++it)
   {
-    child_facets = children[*it];
-    for (std::size_t k = 0; k < child_facets.size(); k++)
-      refined_markers.push_back(child_facets[k]);
+    dolfin_assert(*it < num_facets);
+    refined_markers.insert(refined_markers.end(),
+                           children.begin() + offsets[*it],
+                           children.begin() + offsets[*it + 1]);
   }
 }
 //-----------------------------------------------------------------------------
@@ -18,8 +18,13 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2010-10-11
-// Last changed: 2011-11-12
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <dolfin/common/MPI.h>
 #include <dolfin/la/Vector.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
@@ -59,35 +64,197 @@ void dolfin::dorfler_mark(dolfin::MeshFunction<bool>& markers,
                           const dolfin::MeshFunction<double>& indicators,
                           const double fraction)
 {
+  // The Dorfler strategy marks the cells with the largest indicators
+  // until the sum of the marked indicators exceeds a fraction of the
+  // total. Instead of sorting all indicators, we search for the
+  // indicator value t of the last cell to be marked by repeated
+  // partitioning around a pivot (quickselect), which is O(n) on
+  // average. In parallel, the pivot is the weighted median of the
+  // local medians and the partial sums are reduced over all
+  // processes, so that the marking is the same as for the serial
+  // mesh.
+
   // Extract mesh
   const dolfin::Mesh& mesh = *markers.mesh();
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
 
   // Initialize marker mesh function
   markers.set_all(false);
 
-  // Sort cell indices by indicators and compute sum of error
+  // Only owned (regular) cells take part in the marking
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t num_cells = mesh.topology().ghost_offset(D);
+  const std::size_t rank = dolfin::MPI::rank(mpi_comm);
+
+  // Copy indicators (candidates for t) and compute sum of error
   // indicators
-  std::map<double, std::size_t> sorted_cells;
-  std::map<double, std::size_t>::reverse_iterator it;
-  double eta_T_H = 0;
-  for (std::size_t i = 0; i < mesh.num_cells(); i++)
+  std::vector<double> candidates(num_cells);
+  double eta_T_H = 0.0;
+  for (std::size_t i = 0; i < num_cells; i++)
   {
-    const double value = indicators[i];
-    eta_T_H += value;
-    sorted_cells[value] = i;
+    candidates[i] = indicators[i];
+    eta_T_H += candidates[i];
+  }
+  eta_T_H = dolfin::MPI::sum(mpi_comm, eta_T_H);
+
+  // If all indicators are zero, mark a single cell: the last owned
+  // cell of the first process that has any
+  std::vector<std::size_t> counts;
+  if (eta_T_H == 0.0)
+  {
+    dolfin::MPI::all_gather(mpi_comm, num_cells, counts);
+    std::size_t first = 0;
+    while (first < counts.size() && counts[first] == 0)
+      first++;
+    if (first == rank)
+      markers[num_cells - 1] = true;
+    return;
   }
 
   // Determine stopping criterion for marking
   const double stop = fraction*eta_T_H;
 
-  // Mark using Dorfler algorithm
-  double eta_A = 0.0;
-  for (it = sorted_cells.rbegin(); it != sorted_cells.rend(); it++) {
-    if (eta_A > stop)
-      return;
+  // Search for t, the largest indicator value such that the sum of
+  // all indicators >= t exceeds stop. eta_above is the sum of all
+  // indicators larger than the remaining candidates. For fraction
+  // >= 1, all cells are marked.
+  double eta_above = 0.0;
+  double threshold = 0.0;
+  bool found = false;
+  std::vector<double> medians;
+  std::vector<std::pair<double, std::size_t> > weighted_medians;
+  while (fraction < 1.0)
+  {
+    // Compute local median of candidates and gather on all processes
+    const std::size_t num_candidates = candidates.size();
+    double median = 0.0;
+    if (num_candidates > 0)
+    {
+      std::nth_element(candidates.begin(),
+                       candidates.begin() + num_candidates/2,
+                       candidates.end());
+      median = candidates[num_candidates/2];
+    }
+    dolfin::MPI::all_gather(mpi_comm, median, medians);
+    dolfin::MPI::all_gather(mpi_comm, num_candidates, counts);
+
+    // Pick pivot as the median of the local medians, weighted by the
+    // number of candidates
+    weighted_medians.clear();
+    std::size_t total_candidates = 0;
+    for (std::size_t p = 0; p < counts.size(); p++)
+    {
+      if (counts[p] > 0)
+      {
+        weighted_medians.push_back(std::make_pair(medians[p], counts[p]));
+        total_candidates += counts[p];
+      }
+    }
+
+    // No candidates left: the indicators do not exceed stop, so all
+    // cells are marked
+    if (total_candidates == 0)
+      break;
+
+    std::sort(weighted_medians.begin(), weighted_medians.end());
+    double pivot = weighted_medians.back().first;
+    std::size_t count = 0;
+    for (std::size_t p = 0; p < weighted_medians.size(); p++)
+    {
+      count += weighted_medians[p].second;
+      if (2*count >= total_candidates)
+      {
+        pivot = weighted_medians[p].first;
+        break;
+      }
+    }
+
+    // Partition candidates as [> pivot | == pivot | < pivot] and sum
+    // the first two parts
+    std::size_t num_greater = 0;
+    std::size_t num_less = num_candidates;
+    double eta_greater = 0.0;
+    double eta_equal = 0.0;
+    std::size_t i = 0;
+    while (i < num_less)
+    {
+      const double value = candidates[i];
+      if (value > pivot)
+      {
+        eta_greater += value;
+        std::swap(candidates[i++], candidates[num_greater++]);
+      }
+      else if (value < pivot)
+        std::swap(candidates[i], candidates[--num_less]);
+      else
+      {
+        eta_equal += value;
+        i++;
+      }
+    }
+    eta_greater = dolfin::MPI::sum(mpi_comm, eta_greater);
+    eta_equal = dolfin::MPI::sum(mpi_comm, eta_equal);
 
-    markers[it->second] = true;
-    eta_A += it->first;
+    if (eta_above + eta_greater > stop)
+    {
+      // t > pivot
+      candidates.resize(num_greater);
+    }
+    else if (eta_above + eta_greater + eta_equal > stop)
+    {
+      // t == pivot
+      eta_above += eta_greater;
+      threshold = pivot;
+      found = true;
+      break;
+    }
+    else
+    {
+      // t < pivot
+      eta_above += eta_greater + eta_equal;
+      candidates.erase(candidates.begin(), candidates.begin() + num_less);
+    }
+  }
+
+  // Mark all cells if stop is not exceeded by any subset
+  if (!found)
+  {
+    for (std::size_t i = 0; i < num_cells; i++)
+      markers[i] = true;
+    return;
+  }
+
+  // All cells with indicators > t are marked. Of the cells with
+  // indicator == t, only as many as needed to exceed stop are marked,
+  // in order of process rank and cell index.
+  std::size_t num_equal = 0;
+  for (std::size_t i = 0; i < num_cells; i++)
+  {
+    if (indicators[i] == threshold)
+      num_equal++;
+  }
+  dolfin::MPI::all_gather(mpi_comm, num_equal, counts);
+
+  dolfin_assert(threshold > 0.0);
+  const std::size_t num_needed
+    = (std::size_t) std::floor((stop - eta_above)/threshold) + 1;
+  std::size_t offset = 0;
+  for (std::size_t p = 0; p < rank; p++)
+    offset += counts[p];
+  std::size_t num_mark_equal = 0;
+  if (num_needed > offset)
+    num_mark_equal = std::min(num_needed - offset, num_equal);
+
+  for (std::size_t i = 0; i < num_cells; i++)
+  {
+    const double value = indicators[i];
+    if (value > threshold)
+      markers[i] = true;
+    else if (value == threshold && num_mark_equal > 0)
+    {
+      markers[i] = true;
+      num_mark_equal--;
+    }
   }
 }
 //-----------------------------------------------------------------------------
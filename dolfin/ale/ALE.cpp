@@ -18,7 +18,7 @@
 // Modified by Jan Blechta 2013
 //
 // First added:  2008-05-02
-// Last changed: 2013-03-06
+// Last changed: 2026-10-19
 
 #include <vector>
 #include <dolfin/function/GenericFunction.h>
@@ -102,6 +102,7 @@ std::shared_ptr<MeshDisplacement> ALE::move(Mesh& mesh0, const Mesh& mesh1)
     for (std::size_t i = 0; i < dim; i++)
       x[i] = v->x()[i];
   }
+  boundary0.geometry().changed();
 
   // Move mesh
   return HarmonicSmoothing::move(mesh0, boundary0);
@@ -132,5 +133,6 @@ void ALE::move(Mesh& mesh, const GenericFunction& displacement)
     for (std::size_t i = 0; i < N; i++)
       x[i*gdim + d] += vertex_values[d*N + i];
   }
+  mesh.geometry().changed();
 }
 //-----------------------------------------------------------------------------
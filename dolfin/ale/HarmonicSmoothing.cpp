@@ -16,12 +16,17 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2008-08-11
-// Last changed: 2013-12-02
+// Last changed: 2026-10-19
 
+#include <algorithm>
 #include <dolfin/common/Array.h>
+#include <dolfin/common/NoDeleter.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/fem/Assembler.h>
 #include <dolfin/fem/fem_utils.h>
+#include <dolfin/fem/GenericDofMap.h>
+#include <dolfin/la/KrylovSolver.h>
 #include <dolfin/la/Matrix.h>
 #include <dolfin/la/solve.h>
 #include <dolfin/la/Vector.h>
@@ -37,109 +42,70 @@
 
 using namespace dolfin;
 
+//-----------------------------------------------------------------------------
+HarmonicSmoothing::HarmonicSmoothing(std::shared_ptr<Mesh> mesh)
+  : _mesh(mesh)
+{
+  parameters = default_parameters();
+}
+//-----------------------------------------------------------------------------
+HarmonicSmoothing::HarmonicSmoothing(Mesh& mesh)
+  : _mesh(reference_to_no_delete_pointer(mesh))
+{
+  parameters = default_parameters();
+}
+//-----------------------------------------------------------------------------
+HarmonicSmoothing::~HarmonicSmoothing()
+{
+  // Do nothing
+}
 //-----------------------------------------------------------------------------
 std::shared_ptr<MeshDisplacement> HarmonicSmoothing::move(Mesh& mesh,
                                             const BoundaryMesh& new_boundary)
 {
-  // Now this works regardless of reorder_dofs_serial value
-  const bool reorder_dofs_serial = parameters["reorder_dofs_serial"];
-  if (!reorder_dofs_serial)
-  {
-    warning("The function HarmonicSmoothing::move no longer needs "
-            "parameters[\"reorder_dofs_serial\"] = false");
-  }
+  HarmonicSmoothing smoothing(mesh);
+  return smoothing.smooth(new_boundary);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<MeshDisplacement>
+HarmonicSmoothing::smooth(const BoundaryMesh& new_boundary)
+{
+  Timer timer("Harmonic smoothing");
 
-  const std::size_t D = mesh.topology().dim();
+  dolfin_assert(_mesh);
+  Mesh& mesh = *_mesh;
   const std::size_t d = mesh.geometry().dim();
-
-  // Choose form and function space
-  std::shared_ptr<FunctionSpace> V;
-  std::shared_ptr<Form> form;
-  switch (D)
-  {
-  case 1:
-    V.reset(new Poisson1D::FunctionSpace(mesh));
-    form.reset(new Poisson1D::BilinearForm(V, V));
-    break;
-  case 2:
-    V.reset(new Poisson2D::FunctionSpace(mesh));
-    form.reset(new Poisson2D::BilinearForm(V, V));
-    break;
-  case 3:
-    V.reset(new Poisson3D::FunctionSpace(mesh));
-    form.reset(new Poisson3D::BilinearForm(V, V));
-    break;
-  default:
-    dolfin_error("HarmonicSmoothing.cpp",
-                 "move mesh using harmonic smoothing",
-                 "Illegal mesh dimension (%d)", D);
-  }
-
-  // Assemble matrix
-  Matrix A;
-  Assembler assembler;
-  assembler.assemble(A, *form);
-
-  // Number of mesh vertices (local)
   const std::size_t num_vertices = mesh.num_vertices();
 
-  // Dof range
-  const dolfin::la_index n0 = V->dofmap()->ownership_range().first;
-  const dolfin::la_index n1 = V->dofmap()->ownership_range().second;
-  const dolfin::la_index num_owned_dofs = n1 - n0;
-
-  // Mapping of new_boundary vertex numbers to mesh vertex numbers
+  // Compute boundary dofs and matrix, or check that cached data can
+  // be reused (the boundary must consist of the same vertices)
   const MeshFunction<std::size_t>& vertex_map_mesh_func
     = new_boundary.entity_map(0);
   const std::size_t num_boundary_vertices = vertex_map_mesh_func.size();
-  const std::vector<std::size_t>
-    vertex_map(vertex_map_mesh_func.values(),
-               vertex_map_mesh_func.values() + num_boundary_vertices);
-
-  // Mapping of mesh vertex numbers to dofs (including ghost dofs)
-  const std::vector<dolfin::la_index> vertex_to_dofs = vertex_to_dof_map(*V);
-
-  // Array of all dofs (including ghosts) with local numbering
-  std::vector<dolfin::la_index> all_global_dofs(num_vertices);
-  for (std::size_t i = 0; i < num_vertices; i++)
-    all_global_dofs[i] = vertex_to_dofs[i];
+  const bool same_boundary = _V
+    && _vertex_map.size() == num_boundary_vertices
+    && std::equal(_vertex_map.begin(), _vertex_map.end(),
+                  vertex_map_mesh_func.values());
+  const bool reuse_operator = parameters["reuse_operator"];
+  if (!same_boundary)
+    init_boundary(new_boundary);
+  if (!same_boundary || !reuse_operator)
+    init_operator();
+  const std::size_t num_boundary_dofs = _boundary_dofs.size();
 
-  // Create arrays for setting bcs.  Their indexing does not matter -
-  // same ordering does.
-  std::size_t num_boundary_dofs = 0;
-  std::vector<dolfin::la_index> boundary_dofs;
-  boundary_dofs.reserve(num_boundary_vertices);
-  std::vector<std::size_t> boundary_vertices;
-  boundary_vertices.reserve(num_boundary_vertices);
-  for (std::size_t vert = 0; vert < num_boundary_vertices; vert++)
+  // Compute boundary displacement for all coordinate directions
+  std::vector<double> boundary_values(d*num_boundary_dofs);
+  for (std::size_t i = 0; i < num_boundary_dofs; i++)
   {
-    // Skip ghosts
-    const dolfin::la_index dof = vertex_to_dofs[vertex_map[vert]];
-    if (dof < num_owned_dofs)
+    const std::size_t vertex = _boundary_vertices[i];
+    for (std::size_t dim = 0; dim < d; dim++)
     {
-      // Global dof numbers
-      boundary_dofs.push_back(dof + n0);
-
-      // new_boundary vertex indices
-      boundary_vertices.push_back(vert);
-
-      num_boundary_dofs++;
+      boundary_values[dim*num_boundary_dofs + i]
+        = new_boundary.geometry().x(vertex, dim)
+        - mesh.geometry().x(_vertex_map[vertex], dim);
     }
   }
 
-  // Modify matrix (insert 1 on diagonal)
-  A.ident(num_boundary_dofs, boundary_dofs.data());
-  A.apply("insert");
-
-  // Arrays for storing Dirichlet condition and solution
-  std::vector<double> boundary_values(num_boundary_dofs);
-  std::vector<double> displacement;
-  displacement.reserve(d*num_vertices);
-
-  // Pick amg as preconditioner if available
-  const std::string
-    prec(has_krylov_solver_preconditioner("amg") ? "amg" : "default");
-
   // Displacement solution wrapped in Expression subclass
   // MeshDisplacement
   std::shared_ptr<MeshDisplacement> u(new MeshDisplacement(mesh));
@@ -147,35 +113,46 @@ std::shared_ptr<MeshDisplacement> HarmonicSmoothing::move(Mesh& mesh,
   // RHS vector
   Vector b(*(*u)[0].vector());
 
-  // Solve system for each dimension
+  // Start from previous displacement if available
+  const bool nonzero_initial_guess = parameters["nonzero_initial_guess"];
+  const bool warm_start = nonzero_initial_guess && _displacement.size() == d;
+  _solver->parameters["nonzero_initial_guess"] = warm_start;
+
+  // Solve system for each dimension (the matrix and preconditioner
+  // are shared by all dimensions)
+  std::vector<double> displacement(d*num_vertices);
   for (std::size_t dim = 0; dim < d; dim++)
   {
     // Get solution vector
     std::shared_ptr<GenericVector> x = (*u)[dim].vector();
 
-    if (dim > 0)
-      b.zero();
-
     // Store bc into RHS and solution so that CG solver can be used
-    for (std::size_t i = 0; i < num_boundary_dofs; i++)
+    const double* values = boundary_values.data() + dim*num_boundary_dofs;
+    b.zero();
+    b.set(values, num_boundary_dofs, _boundary_dofs.data());
+    b.apply("insert");
+    if (warm_start)
     {
-      boundary_values[i] = new_boundary.geometry().x(boundary_vertices[i], dim)
-        - mesh.geometry().x(vertex_map[boundary_vertices[i]], dim);
+      *x = *_displacement[dim];
+      x->set(values, num_boundary_dofs, _boundary_dofs.data());
+      x->apply("insert");
     }
-    b.set(boundary_values.data(), num_boundary_dofs, boundary_dofs.data());
-    b.apply("insert");
-    *x = b;
+    else
+      *x = b;
 
     // Solve system
-    solve(A, *x, b, "cg", prec);
+    _solver->solve(*x, b);
 
     // Get displacement
-    std::vector<double> _displacement(num_vertices);
-    x->get_local(_displacement.data(), num_vertices, all_global_dofs.data());
-    displacement.insert(displacement.end(), _displacement.begin(),
-                        _displacement.end());
+    x->get_local(displacement.data() + dim*num_vertices, num_vertices,
+                 _vertex_to_dofs.data());
   }
 
+  // Store displacement for next call
+  _displacement.resize(d);
+  for (std::size_t dim = 0; dim < d; dim++)
+    _displacement[dim] = (*u)[dim].vector()->copy();
+
   // Modify mesh coordinates
   MeshGeometry& geometry = mesh.geometry();
   std::vector<double> coord(d);
@@ -185,8 +162,103 @@ std::shared_ptr<MeshDisplacement> HarmonicSmoothing::move(Mesh& mesh,
       coord[dim] = displacement[dim*num_vertices + i] + geometry.x(i, dim);
     geometry.set(i, coord);
   }
+  geometry.changed();
 
   // Return calculated displacement
   return u;
 }
 //-----------------------------------------------------------------------------
+void HarmonicSmoothing::init_boundary(const BoundaryMesh& new_boundary)
+{
+  dolfin_assert(_mesh);
+  Mesh& mesh = *_mesh;
+
+  // Choose form and function space (once)
+  if (!_V)
+  {
+    // Now this works regardless of reorder_dofs_serial value
+    const bool reorder_dofs_serial = dolfin::parameters["reorder_dofs_serial"];
+    if (!reorder_dofs_serial)
+    {
+      warning("The function HarmonicSmoothing::move no longer needs "
+              "parameters[\"reorder_dofs_serial\"] = false");
+    }
+
+    const std::size_t D = mesh.topology().dim();
+    switch (D)
+    {
+    case 1:
+      _V.reset(new Poisson1D::FunctionSpace(mesh));
+      _form.reset(new Poisson1D::BilinearForm(_V, _V));
+      break;
+    case 2:
+      _V.reset(new Poisson2D::FunctionSpace(mesh));
+      _form.reset(new Poisson2D::BilinearForm(_V, _V));
+      break;
+    case 3:
+      _V.reset(new Poisson3D::FunctionSpace(mesh));
+      _form.reset(new Poisson3D::BilinearForm(_V, _V));
+      break;
+    default:
+      dolfin_error("HarmonicSmoothing.cpp",
+                   "move mesh using harmonic smoothing",
+                   "Illegal mesh dimension (%d)", D);
+    }
+
+    // Mapping of mesh vertex numbers to dofs (including ghost dofs)
+    _vertex_to_dofs = vertex_to_dof_map(*_V);
+  }
+
+  // Mapping of new_boundary vertex numbers to mesh vertex numbers
+  const MeshFunction<std::size_t>& vertex_map_mesh_func
+    = new_boundary.entity_map(0);
+  const std::size_t num_boundary_vertices = vertex_map_mesh_func.size();
+  _vertex_map.assign(vertex_map_mesh_func.values(),
+                     vertex_map_mesh_func.values() + num_boundary_vertices);
+
+  // Dof range
+  const dolfin::la_index n0 = _V->dofmap()->ownership_range().first;
+  const dolfin::la_index n1 = _V->dofmap()->ownership_range().second;
+  const dolfin::la_index num_owned_dofs = n1 - n0;
+
+  // Create arrays for setting bcs.  Their indexing does not matter -
+  // same ordering does.
+  _boundary_dofs.clear();
+  _boundary_vertices.clear();
+  for (std::size_t vert = 0; vert < num_boundary_vertices; vert++)
+  {
+    // Skip ghosts
+    const dolfin::la_index dof = _vertex_to_dofs[_vertex_map[vert]];
+    if (dof < num_owned_dofs)
+    {
+      // Global dof numbers
+      _boundary_dofs.push_back(dof + n0);
+
+      // new_boundary vertex indices
+      _boundary_vertices.push_back(vert);
+    }
+  }
+
+  // The previous displacement is no longer a good initial guess
+  _displacement.clear();
+}
+//-----------------------------------------------------------------------------
+void HarmonicSmoothing::init_operator()
+{
+  // Assemble matrix
+  dolfin_assert(_form);
+  _A.reset(new Matrix);
+  Assembler assembler;
+  assembler.assemble(*_A, *_form);
+
+  // Modify matrix (insert 1 on diagonal)
+  _A->ident(_boundary_dofs.size(), _boundary_dofs.data());
+  _A->apply("insert");
+
+  // Create solver. Pick amg as preconditioner if available.
+  const std::string
+    prec(has_krylov_solver_preconditioner("amg") ? "amg" : "default");
+  _solver.reset(new KrylovSolver("cg", prec));
+  _solver->set_operator(_A);
+}
+//-----------------------------------------------------------------------------
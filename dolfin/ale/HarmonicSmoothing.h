@@ -16,34 +16,107 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2008-08-11
-// Last changed: 2013-03-06
+// Last changed: 2026-10-19
 
 #ifndef __HARMONIC_SMOOTHING_H
 #define __HARMONIC_SMOOTHING_H
 
 #include <memory>
+#include <vector>
+#include <dolfin/common/types.h>
+#include <dolfin/common/Variable.h>
 #include "MeshDisplacement.h"
 
 namespace dolfin
 {
 
   class BoundaryMesh;
+  class Form;
+  class FunctionSpace;
+  class GenericVector;
+  class KrylovSolver;
+  class Matrix;
   class Mesh;
 
   /// This class implements harmonic mesh smoothing. Poisson's equation
   /// is solved with zero right-hand side (Laplace's equation) for each
   /// coordinate direction to compute new coordinates for all vertices,
   /// given new locations for the coordinates of the boundary.
+  ///
+  /// A HarmonicSmoothing object may be kept for repeated mesh motion
+  /// (ALE time stepping). The matrix, the solver (including the
+  /// preconditioner) and the boundary dofs are then computed on the
+  /// first call to smooth() and reused, and each solve is started from
+  /// the previous displacement. With parameters["reuse_operator"] =
+  /// false, the matrix is reassembled on the current mesh for each
+  /// call.
 
-  class HarmonicSmoothing
+  class HarmonicSmoothing : public Variable
   {
   public:
 
+    /// Create harmonic smoothing for mesh
+    explicit HarmonicSmoothing(std::shared_ptr<Mesh> mesh);
+
+    /// Create harmonic smoothing for mesh (reference version)
+    explicit HarmonicSmoothing(Mesh& mesh);
+
+    /// Destructor
+    ~HarmonicSmoothing();
+
+    /// Smooth coordinates of mesh according to new boundary
+    /// coordinates and return the displacement
+    std::shared_ptr<MeshDisplacement> smooth(const BoundaryMesh& new_boundary);
+
     /// Move coordinates of mesh according to new boundary coordinates
     /// and return the displacement
-    static std::shared_ptr<MeshDisplacement> move(Mesh& mesh, 
+    static std::shared_ptr<MeshDisplacement> move(Mesh& mesh,
                                         const BoundaryMesh& new_boundary);
 
+    /// Default parameter values
+    static Parameters default_parameters()
+    {
+      Parameters p("harmonic_smoothing");
+      p.add("reuse_operator", true);
+      p.add("nonzero_initial_guess", true);
+      return p;
+    }
+
+  private:
+
+    // Compute boundary dofs for given boundary
+    void init_boundary(const BoundaryMesh& new_boundary);
+
+    // Assemble matrix (with identity rows for boundary dofs) and
+    // create solver
+    void init_operator();
+
+    // The mesh
+    std::shared_ptr<Mesh> _mesh;
+
+    // Function space and bilinear form for Laplace operator
+    std::shared_ptr<FunctionSpace> _V;
+    std::shared_ptr<Form> _form;
+
+    // Matrix and solver
+    std::shared_ptr<Matrix> _A;
+    std::shared_ptr<KrylovSolver> _solver;
+
+    // Mapping of mesh vertex numbers to dofs (including ghost dofs)
+    std::vector<dolfin::la_index> _vertex_to_dofs;
+
+    // Mapping of boundary vertex numbers to mesh vertex numbers
+    std::vector<std::size_t> _vertex_map;
+
+    // Global numbers of owned boundary dofs and corresponding
+    // boundary vertex numbers
+    std::vector<dolfin::la_index> _boundary_dofs;
+    std::vector<std::size_t> _boundary_vertices;
+
+    // Displacement computed in previous call (one vector per
+    // coordinate direction)
+    std::vector<std::shared_ptr<GenericVector> > _displacement;
+
   };
 
 }
@@ -4,6 +4,7 @@
 // DOLFIN ALE interface
 
 #include <dolfin/ale/ALE.h>
+#include <dolfin/ale/HarmonicSmoothing.h>
 #include <dolfin/ale/MeshDisplacement.h>
 
 #endif
@@ -21,6 +21,8 @@
 // Modified by Niclas Jansson 2009
 // Modified by Joachim B Haga 2012
 
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <dolfin/log/dolfin_log.h>
 #include "SubSystemsManager.h"
@@ -122,6 +124,129 @@ void dolfin::MPI::barrier(const MPI_Comm comm)
 #endif
 }
 //-----------------------------------------------------------------------------
+std::vector<int>
+dolfin::MPI::compute_sources(const MPI_Comm comm,
+                             const std::vector<int>& destinations)
+{
+  std::vector<int> sources;
+
+#ifdef HAS_MPI
+#if MPI_VERSION >= 3
+  const int tag = nbx_tag(comm);
+
+  // Send (empty) synchronous message to each destination. A
+  // synchronous send completes only once it has been received.
+  std::vector<MPI_Request> send_requests(destinations.size());
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+  {
+    MPI_Issend(NULL, 0, MPI_BYTE, destinations[i], tag, comm,
+               &send_requests[i]);
+  }
+
+  // Receive messages until all processes have had all their messages
+  // received, which is detected by a non-blocking barrier entered
+  // once the local sends have completed
+  MPI_Request barrier_request;
+  bool barrier_active = false;
+  while (true)
+  {
+    int received = 0;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &received, &status);
+    if (received)
+    {
+      MPI_Recv(NULL, 0, MPI_BYTE, status.MPI_SOURCE, tag, comm,
+               MPI_STATUS_IGNORE);
+      sources.push_back(status.MPI_SOURCE);
+    }
+
+    if (barrier_active)
+    {
+      int done = 0;
+      MPI_Test(&barrier_request, &done, MPI_STATUS_IGNORE);
+      if (done)
+        break;
+    }
+    else
+    {
+      int sent = 0;
+      MPI_Testall(send_requests.size(), send_requests.data(), &sent,
+                  MPI_STATUSES_IGNORE);
+      if (sent)
+      {
+        MPI_Ibarrier(comm, &barrier_request);
+        barrier_active = true;
+      }
+    }
+  }
+#else
+  // Fall back to dense exchange of flags for MPI-2
+  return compute_sources_dense(comm, destinations);
+#endif
+#else
+  sources = destinations;
+#endif
+
+  std::sort(sources.begin(), sources.end());
+  return sources;
+}
+//-----------------------------------------------------------------------------
+std::vector<int>
+dolfin::MPI::compute_sources_dense(const MPI_Comm comm,
+                                   const std::vector<int>& destinations)
+{
+  std::vector<int> sources;
+
+#ifdef HAS_MPI
+  const std::size_t comm_size = size(comm);
+  std::vector<int> send_flags(comm_size, 0), recv_flags(comm_size);
+  for (std::size_t i = 0; i < destinations.size(); ++i)
+    send_flags[destinations[i]] = 1;
+  MPI_Alltoall(send_flags.data(), 1, MPI_INT, recv_flags.data(), 1, MPI_INT,
+               comm);
+  for (std::size_t p = 0; p < comm_size; ++p)
+  {
+    if (recv_flags[p])
+      sources.push_back(p);
+  }
+#else
+  sources = destinations;
+  std::sort(sources.begin(), sources.end());
+#endif
+
+  return sources;
+}
+//-----------------------------------------------------------------------------
+void dolfin::MPI::wait_all(std::vector<MPI_Request>& requests)
+{
+#ifdef HAS_MPI
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#endif
+  requests.clear();
+}
+//-----------------------------------------------------------------------------
+#ifdef HAS_MPI
+int dolfin::MPI::nbx_tag(const MPI_Comm comm)
+{
+  // The call count is cached on the communicator, so that it is
+  // consistent across the processes of the communicator
+  static int keyval = MPI_KEYVAL_INVALID;
+  if (keyval == MPI_KEYVAL_INVALID)
+  {
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, MPI_COMM_NULL_DELETE_FN,
+                           &keyval, NULL);
+  }
+
+  void* value = NULL;
+  int found = 0;
+  MPI_Comm_get_attr(comm, keyval, &value, &found);
+  const std::intptr_t count = found ? (std::intptr_t) value : 0;
+  MPI_Comm_set_attr(comm, keyval, (void*) (count + 1));
+
+  return 3 + count % 2;
+}
+#endif
+//-----------------------------------------------------------------------------
 std::size_t dolfin::MPI::global_offset(const MPI_Comm comm,
                                        std::size_t range, bool exclusive)
 {
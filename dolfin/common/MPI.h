@@ -40,6 +40,7 @@
 
 #ifndef HAS_MPI
 typedef int MPI_Comm;
+typedef int MPI_Request;
 #define MPI_COMM_WORLD 2
 #define MPI_COMM_SELF 1
 #define MPI_COMM_NULL 0
@@ -103,6 +104,60 @@ namespace dolfin
                              std::vector<std::vector<T> >& in_values,
                              std::vector<std::vector<T> >& out_values);
 
+    /// Compute the processes that send data to this process, given
+    /// the (distinct) processes that this process sends data to. A
+    /// non-blocking consensus algorithm (NBX) is used, so memory and
+    /// message counts scale with the number of neighbours rather than
+    /// with the number of processes. The returned sources are sorted.
+    static std::vector<int>
+      compute_sources(const MPI_Comm comm,
+                      const std::vector<int>& destinations);
+
+    /// Compute the processes that send data to this process, as
+    /// compute_sources, by a dense exchange of flags with all
+    /// processes. This is used by compute_sources when MPI-3 is not
+    /// available.
+    static std::vector<int>
+      compute_sources_dense(const MPI_Comm comm,
+                            const std::vector<int>& destinations);
+
+    /// Send send_data[send_offsets[i]] ... send_data[send_offsets[i +
+    /// 1] - 1] to process destinations[i]. On return, sources holds
+    /// the processes that sent data to this process (sorted) and
+    /// recv_data[recv_offsets[j]] ... recv_data[recv_offsets[j + 1] -
+    /// 1] holds the data received from sources[j]. Only neighbours
+    /// communicate, in contrast to all_to_all.
+    template<typename T>
+      static void neighbor_all_to_all(const MPI_Comm comm,
+                                      const std::vector<int>& destinations,
+                                      const std::vector<int>& send_offsets,
+                                      const std::vector<T>& send_data,
+                                      std::vector<int>& sources,
+                                      std::vector<int>& recv_offsets,
+                                      std::vector<T>& recv_data);
+
+    /// Start non-blocking version of neighbor_all_to_all with known
+    /// sources (see compute_sources). Message sizes are exchanged
+    /// before returning, so recv_offsets is available at once and
+    /// recv_data is sized. The exchange is completed by
+    /// wait_all(requests); send_data and recv_data must not be
+    /// modified before then, which leaves the caller free to do
+    /// other work while the data is in flight.
+    template<typename T>
+      static void
+      neighbor_all_to_all_begin(const MPI_Comm comm,
+                                const std::vector<int>& destinations,
+                                const std::vector<int>& send_offsets,
+                                const std::vector<T>& send_data,
+                                const std::vector<int>& sources,
+                                std::vector<int>& recv_offsets,
+                                std::vector<T>& recv_data,
+                                std::vector<MPI_Request>& requests);
+
+    /// Wait for completion of non-blocking requests (requests is
+    /// empty on return)
+    static void wait_all(std::vector<MPI_Request>& requests);
+
     /// Broadcast vector of value from broadcaster to all processes
     template<typename T>
       static void broadcast(const MPI_Comm comm, std::vector<T>& value,
@@ -220,6 +275,12 @@ namespace dolfin
     #endif
 
     #ifdef HAS_MPI
+    // Return tag for the next compute_sources call on communicator.
+    // Consecutive calls alternate between two tags, so that messages
+    // from a process that has moved on to the next call are not
+    // received by a process still in the current call.
+    static int nbx_tag(const MPI_Comm comm);
+
     // Return MPI data type
     template<typename T>
       struct dependent_false : std::false_type {};
@@ -640,6 +701,82 @@ namespace dolfin
     #endif
   }
   //---------------------------------------------------------------------------
+  template<typename T>
+    void dolfin::MPI::neighbor_all_to_all(const MPI_Comm comm,
+                                          const std::vector<int>& destinations,
+                                          const std::vector<int>& send_offsets,
+                                          const std::vector<T>& send_data,
+                                          std::vector<int>& sources,
+                                          std::vector<int>& recv_offsets,
+                                          std::vector<T>& recv_data)
+  {
+    sources = compute_sources(comm, destinations);
+    std::vector<MPI_Request> requests;
+    neighbor_all_to_all_begin(comm, destinations, send_offsets, send_data,
+                              sources, recv_offsets, recv_data, requests);
+    wait_all(requests);
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+    void dolfin::MPI::neighbor_all_to_all_begin(const MPI_Comm comm,
+                                     const std::vector<int>& destinations,
+                                     const std::vector<int>& send_offsets,
+                                     const std::vector<T>& send_data,
+                                     const std::vector<int>& sources,
+                                     std::vector<int>& recv_offsets,
+                                     std::vector<T>& recv_data,
+                                     std::vector<MPI_Request>& requests)
+  {
+    dolfin_assert(send_offsets.size() == destinations.size() + 1);
+    dolfin_assert((std::size_t) send_offsets.back() == send_data.size());
+
+    #ifdef HAS_MPI
+    const int size_tag = 1;
+    const int data_tag = 2;
+
+    // Exchange message sizes
+    std::vector<int> send_sizes(destinations.size());
+    std::vector<int> recv_sizes(sources.size());
+    requests.resize(sources.size() + destinations.size());
+    for (std::size_t j = 0; j < sources.size(); ++j)
+    {
+      MPI_Irecv(&recv_sizes[j], 1, MPI_INT, sources[j], size_tag, comm,
+                &requests[j]);
+    }
+    for (std::size_t i = 0; i < destinations.size(); ++i)
+    {
+      send_sizes[i] = send_offsets[i + 1] - send_offsets[i];
+      MPI_Isend(&send_sizes[i], 1, MPI_INT, destinations[i], size_tag, comm,
+                &requests[sources.size() + i]);
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    recv_offsets.resize(sources.size() + 1);
+    recv_offsets[0] = 0;
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     recv_offsets.begin() + 1);
+    recv_data.resize(recv_offsets.back());
+
+    // Post data messages
+    for (std::size_t j = 0; j < sources.size(); ++j)
+    {
+      MPI_Irecv(recv_data.data() + recv_offsets[j], recv_sizes[j],
+                mpi_type<T>(), sources[j], data_tag, comm, &requests[j]);
+    }
+    for (std::size_t i = 0; i < destinations.size(); ++i)
+    {
+      MPI_Isend(const_cast<T*>(send_data.data()) + send_offsets[i],
+                send_sizes[i], mpi_type<T>(), destinations[i], data_tag, comm,
+                &requests[sources.size() + i]);
+    }
+    #else
+    dolfin_assert(destinations.size() == sources.size());
+    recv_offsets = send_offsets;
+    recv_data = send_data;
+    requests.clear();
+    #endif
+  }
+  //---------------------------------------------------------------------------
   template<typename T>
     void dolfin::MPI::send_recv(const MPI_Comm comm,
                                 const std::vector<T>& send_value,
@@ -24,6 +24,7 @@
 #include <dolfin/log/dolfin_log.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/parameter/ParameterHandle.h>
 #include <dolfin/la/GenericTensor.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
@@ -55,7 +56,9 @@ void Assembler::assemble(GenericTensor& A, const Form& a)
 
   // Check whether we should call the multi-core assembler
   #ifdef HAS_OPENMP
-  const std::size_t num_threads = parameters["num_threads"];
+  static const ParameterHandle<int> num_threads_parameter(parameters,
+                                                          "num_threads");
+  const int num_threads = num_threads_parameter.value();
   if (num_threads > 0)
   {
     OpenMpAssembler assembler;
@@ -0,0 +1,342 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <sstream>
+#include <dolfin/common/NoDeleter.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/GenericVector.h>
+#include <dolfin/la/HaloExchange.h>
+#include <dolfin/la/Vector.h>
+#include <dolfin/log/dolfin_log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Facet.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "Form.h"
+#include "GenericDofMap.h"
+#include "UFC.h"
+#include "MatrixFreeOperator.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::MatrixFreeOperator(std::shared_ptr<const Form> a)
+  : LinearOperator(*create_vector(*a, 1), *create_vector(*a, 0)), _form(a)
+{
+  init();
+}
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::MatrixFreeOperator(const Form& a)
+  : LinearOperator(*create_vector(a, 1), *create_vector(a, 0)),
+    _form(reference_to_no_delete_pointer(a))
+{
+  init();
+}
+//-----------------------------------------------------------------------------
+MatrixFreeOperator::~MatrixFreeOperator()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+std::size_t MatrixFreeOperator::size(std::size_t dim) const
+{
+  if (dim > 1)
+  {
+    dolfin_error("MatrixFreeOperator.cpp",
+                 "return size of matrix-free operator",
+                 "Illegal dimension (%d)", dim);
+  }
+
+  dolfin_assert(_form);
+  return _form->function_space(dim)->dofmap()->global_dimension();
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::mult(const GenericVector& x, GenericVector& y) const
+{
+  // Start update of ghost values of x, compute cells that use owned
+  // values only, then complete update and compute remaining cells
+  x.get_local(_x_local);
+  dolfin_assert(_x_local.size() == _halo[1]->num_owned());
+  _x_local.resize(_halo[1]->num_owned() + _halo[1]->num_ghosts());
+  _halo[1]->update_begin(_x_local);
+  _y_local.assign(_halo[0]->num_owned() + _halo[0]->num_ghosts(), 0.0);
+  apply(_x_local, _y_local, false, false);
+  _halo[1]->update_end(_x_local);
+  apply(_x_local, _y_local, false, true);
+
+  scatter_local(_y_local, y);
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::get_diagonal(GenericVector& d) const
+{
+  dolfin_assert(_form);
+  if (!(*_form->function_space(0) == *_form->function_space(1)))
+  {
+    dolfin_error("MatrixFreeOperator.cpp",
+                 "compute diagonal of matrix-free operator",
+                 "Test and trial spaces must be equal");
+  }
+
+  // The cell tensors are reduced to their diagonals, so x is not used
+  _y_local.assign(_halo[0]->num_owned() + _halo[0]->num_ghosts(), 0.0);
+  apply(_x_local, _y_local, true, false);
+  apply(_x_local, _y_local, true, true);
+  scatter_local(_y_local, d);
+}
+//-----------------------------------------------------------------------------
+std::string MatrixFreeOperator::str(bool verbose) const
+{
+  std::stringstream s;
+  if (verbose)
+  {
+    warning("Verbose output for MatrixFreeOperator not implemented.");
+    s << str(false);
+  }
+  else
+  {
+    s << "<MatrixFreeOperator of size " << size(0) << " x " << size(1)
+      << ">";
+  }
+
+  return s.str();
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<GenericVector>
+MatrixFreeOperator::create_vector(const Form& a, std::size_t i)
+{
+  if (a.rank() != 2)
+  {
+    dolfin_error("MatrixFreeOperator.cpp",
+                 "create matrix-free operator",
+                 "Expecting a bilinear form but rank is %d", a.rank());
+  }
+
+  dolfin_assert(a.function_space(i));
+  dolfin_assert(a.function_space(i)->dofmap());
+  const GenericDofMap& dofmap = *a.function_space(i)->dofmap();
+
+  std::shared_ptr<GenericVector> x(new Vector);
+  x->init(a.mesh().mpi_comm(), dofmap.ownership_range());
+  return x;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HaloExchange>
+MatrixFreeOperator::create_halo(MPI_Comm comm, const GenericDofMap& dofmap)
+{
+  return std::shared_ptr<HaloExchange>(
+    new HaloExchange(comm, dofmap.ownership_range(),
+                     dofmap.local_to_global_unowned(),
+                     dofmap.off_process_owner(), dofmap.block_size));
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::init()
+{
+  dolfin_assert(_form);
+  _form->check();
+
+  // Interior facet and point integrals are not supported
+  std::shared_ptr<const ufc::form> ufc_form = _form->ufc_form();
+  dolfin_assert(ufc_form);
+  if (ufc_form->has_interior_facet_integrals()
+      || ufc_form->has_point_integrals())
+  {
+    dolfin_error("MatrixFreeOperator.cpp",
+                 "create matrix-free operator",
+                 "Only cell and exterior facet integrals are supported");
+  }
+
+  _ufc.reset(new UFC(*_form));
+  _ufc_coefficients = _form->coefficients();
+
+  const Mesh& mesh = _form->mesh();
+  for (std::size_t i = 0; i < 2; ++i)
+    _halo[i] = create_halo(mesh.mpi_comm(), *_form->function_space(i)->dofmap());
+
+  // Mark cells with unowned trial space dofs
+  const GenericDofMap& dofmap = *_form->function_space(1)->dofmap();
+  const dolfin::la_index num_owned = _halo[1]->num_owned();
+  _ghosted.assign(mesh.num_cells(), false);
+  for (std::size_t c = 0; c < mesh.num_cells(); ++c)
+  {
+    const std::vector<dolfin::la_index>& dofs = dofmap.cell_dofs(c);
+    for (std::size_t j = 0; j < dofs.size(); ++j)
+    {
+      if (dofs[j] >= num_owned)
+      {
+        _ghosted[c] = true;
+        break;
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::scatter_local(std::vector<double>& values,
+                                       GenericVector& y) const
+{
+  // Add contributions to unowned entries on owning processes
+  _halo[0]->accumulate(values);
+  values.resize(_halo[0]->num_owned());
+  y.set_local(values);
+  y.apply("insert");
+}
+//-----------------------------------------------------------------------------
+void MatrixFreeOperator::apply(const std::vector<double>& x,
+                               std::vector<double>& y, bool diagonal,
+                               bool ghosted) const
+{
+  const Form& a = *_form;
+  const Mesh& mesh = a.mesh();
+
+  // Recreate UFC data if coefficients of the form have been replaced
+  dolfin_assert(_ufc);
+  const std::vector<std::shared_ptr<const GenericFunction> >
+    coefficients = a.coefficients();
+  if (coefficients != _ufc_coefficients)
+  {
+    _ufc.reset(new UFC(a));
+    _ufc_coefficients = coefficients;
+  }
+  UFC& ufc = *_ufc;
+
+  const GenericDofMap& dofmap0 = *a.function_space(0)->dofmap();
+  const GenericDofMap& dofmap1 = *a.function_space(1)->dofmap();
+
+  ufc::cell ufc_cell;
+  std::vector<double> vertex_coordinates;
+
+  // Cell integrals
+  if (ufc.form.has_cell_integrals())
+  {
+    std::shared_ptr<const MeshFunction<std::size_t> > domains
+      = a.cell_domains();
+    const bool use_domains = domains && !domains->empty();
+    ufc::cell_integral* integral = ufc.default_cell_integral.get();
+
+    for (CellIterator cell(mesh); !cell.end(); ++cell)
+    {
+      if (_ghosted[cell->index()] != ghosted)
+        continue;
+      if (use_domains)
+        integral = ufc.get_cell_integral((*domains)[*cell]);
+      if (!integral)
+        continue;
+
+      dolfin_assert(!cell->is_ghost());
+
+      const std::vector<dolfin::la_index>& dofs0
+        = dofmap0.cell_dofs(cell->index());
+      const std::vector<dolfin::la_index>& dofs1
+        = dofmap1.cell_dofs(cell->index());
+      if (dofs0.empty() || dofs1.empty())
+        continue;
+
+      // Tabulate cell tensor and apply
+      cell->get_cell_data(ufc_cell);
+      cell->get_vertex_coordinates(vertex_coordinates);
+      ufc.update(*cell, vertex_coordinates, ufc_cell,
+                 integral->enabled_coefficients());
+      integral->tabulate_tensor(ufc.A.data(), ufc.w(),
+                                vertex_coordinates.data(),
+                                ufc_cell.orientation);
+      apply_element_tensor(ufc.A, dofs0, dofs1, x, y, diagonal);
+    }
+  }
+
+  // Exterior facet integrals
+  if (ufc.form.has_exterior_facet_integrals())
+  {
+    std::shared_ptr<const MeshFunction<std::size_t> > domains
+      = a.exterior_facet_domains();
+    const bool use_domains = domains && !domains->empty();
+    const ufc::exterior_facet_integral* integral
+      = ufc.default_exterior_facet_integral.get();
+
+    const std::size_t D = mesh.topology().dim();
+    mesh.init(D - 1);
+    mesh.init(D - 1, D);
+    dolfin_assert(mesh.ordered());
+
+    for (FacetIterator facet(mesh); !facet.end(); ++facet)
+    {
+      if (!facet->exterior())
+        continue;
+
+      if (use_domains)
+        integral = ufc.get_exterior_facet_integral((*domains)[*facet]);
+      if (!integral)
+        continue;
+
+      // Get cell to which facet belongs (there is only one)
+      dolfin_assert(facet->num_entities(D) == 1);
+      Cell cell(mesh, facet->entities(D)[0]);
+      dolfin_assert(!cell.is_ghost());
+      if (_ghosted[cell.index()] != ghosted)
+        continue;
+      const std::size_t local_facet = cell.index(*facet);
+
+      const std::vector<dolfin::la_index>& dofs0
+        = dofmap0.cell_dofs(cell.index());
+      const std::vector<dolfin::la_index>& dofs1
+        = dofmap1.cell_dofs(cell.index());
+
+      // Tabulate exterior facet tensor and apply
+      cell.get_cell_data(ufc_cell, local_facet);
+      cell.get_vertex_coordinates(vertex_coordinates);
+      ufc.update(cell, vertex_coordinates, ufc_cell,
+                 integral->enabled_coefficients());
+      integral->tabulate_tensor(ufc.A.data(), ufc.w(),
+                                vertex_coordinates.data(), local_facet,
+                                ufc_cell.orientation);
+      apply_element_tensor(ufc.A, dofs0, dofs1, x, y, diagonal);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void
+MatrixFreeOperator::apply_element_tensor(const std::vector<double>& A,
+                                 const std::vector<dolfin::la_index>& dofs0,
+                                 const std::vector<dolfin::la_index>& dofs1,
+                                 const std::vector<double>& x,
+                                 std::vector<double>& y,
+                                 bool diagonal)
+{
+  const std::size_t m = dofs0.size();
+  const std::size_t n = dofs1.size();
+  dolfin_assert(A.size() >= m*n);
+
+  if (diagonal)
+  {
+    dolfin_assert(m == n);
+    for (std::size_t i = 0; i < m; ++i)
+      y[dofs0[i]] += A[i*n + i];
+    return;
+  }
+
+  // Element tensor is stored row-wise (test function index first)
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    const double* Ai = A.data() + i*n;
+    double yi = 0.0;
+    for (std::size_t j = 0; j < n; ++j)
+      yi += Ai[j]*x[dofs1[j]];
+    y[dofs0[i]] += yi;
+  }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __MATRIX_FREE_OPERATOR_H
+#define __MATRIX_FREE_OPERATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/types.h>
+#include <dolfin/la/LinearOperator.h>
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class Form;
+  class GenericDofMap;
+  class GenericFunction;
+  class GenericVector;
+  class HaloExchange;
+  class UFC;
+
+  /// This class defines a linear operator from a bilinear form
+  /// without assembling a matrix. The action y = Ax is computed cell
+  /// by cell: the local values of x are extracted through the dofmap
+  /// of the trial space, multiplied by the element tensor computed by
+  /// tabulate_tensor, and added into y through the dofmap of the
+  /// test space. Only the vectors and one element tensor are stored,
+  /// which makes it possible to solve problems (typically with high
+  /// degree elements) for which the assembled matrix does not fit in
+  /// memory.
+  ///
+  /// In parallel, ghost values of x are exchanged while cells that
+  /// depend only on owned values are computed, and contributions to
+  /// ghost entries of y are returned to their owners, using a
+  /// _HaloExchange_ built once for each argument space.
+  ///
+  /// The operator may be passed to any Krylov solver accepting a
+  /// _GenericLinearOperator_. The diagonal is available through
+  /// get_diagonal() for Jacobi preconditioning.
+  ///
+  /// Cell and exterior facet integrals are supported. Interior facet
+  /// and point integrals are not.
+
+  class MatrixFreeOperator : public LinearOperator
+  {
+  public:
+
+    /// Create matrix-free operator for bilinear form
+    explicit MatrixFreeOperator(std::shared_ptr<const Form> a);
+
+    /// Create matrix-free operator for bilinear form (reference
+    /// version)
+    explicit MatrixFreeOperator(const Form& a);
+
+    /// Destructor
+    ~MatrixFreeOperator();
+
+    /// Return size of given dimension
+    std::size_t size(std::size_t dim) const;
+
+    /// Compute matrix-vector product y = Ax
+    void mult(const GenericVector& x, GenericVector& y) const;
+
+    /// Compute diagonal of operator (requires test and trial spaces
+    /// to be equal)
+    void get_diagonal(GenericVector& d) const;
+
+    /// Return informal string representation (pretty-print)
+    std::string str(bool verbose) const;
+
+    /// Return bilinear form
+    std::shared_ptr<const Form> form() const
+    { return _form; }
+
+  private:
+
+    // Create vector matching the parallel layout of the dofmap for
+    // the given argument of the form
+    static std::shared_ptr<GenericVector> create_vector(const Form& a,
+                                                        std::size_t i);
+
+    // Create halo exchange for dofmap
+    static std::shared_ptr<HaloExchange>
+      create_halo(MPI_Comm comm, const GenericDofMap& dofmap);
+
+    // Initialise halo exchanges and mark cells depending on ghost
+    // values of the trial space
+    void init();
+
+    // Add local (owned and unowned) values into y
+    void scatter_local(std::vector<double>& values, GenericVector& y) const;
+
+    // Compute action (or diagonal if diagonal == true) of cell and
+    // exterior facet tensors, operating on local values. Only cells
+    // with _ghosted[cell] == ghosted are computed.
+    void apply(const std::vector<double>& x, std::vector<double>& y,
+               bool diagonal, bool ghosted) const;
+
+    // Apply element tensor to local values
+    static void apply_element_tensor(const std::vector<double>& A,
+                                     const std::vector<dolfin::la_index>& dofs0,
+                                     const std::vector<dolfin::la_index>& dofs1,
+                                     const std::vector<double>& x,
+                                     std::vector<double>& y,
+                                     bool diagonal);
+
+    // The bilinear form
+    std::shared_ptr<const Form> _form;
+
+    // UFC data for the form (reused between calls) and the
+    // coefficients it was created for
+    mutable std::shared_ptr<UFC> _ufc;
+    mutable std::vector<std::shared_ptr<const GenericFunction> >
+      _ufc_coefficients;
+
+    // Halo exchange for test (0) and trial (1) spaces
+    std::shared_ptr<HaloExchange> _halo[2];
+
+    // True for cells with trial space dofs that are not owned
+    std::vector<bool> _ghosted;
+
+    // Work arrays for local values of x and y
+    mutable std::vector<double> _x_local, _y_local;
+
+  };
+
+}
+
+#endif
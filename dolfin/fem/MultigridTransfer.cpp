@@ -0,0 +1,196 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <dolfin/common/Timer.h>
+#include <dolfin/common/constants.h>
+#include <dolfin/function/FunctionSpace.h>
+#include <dolfin/la/GenericLinearAlgebraFactory.h>
+#include <dolfin/la/GenericMatrix.h>
+#include <dolfin/la/GenericSparsityPattern.h>
+#include <dolfin/la/TensorLayout.h>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/refinement/MeshHierarchy.h>
+#include "BasisFunction.h"
+#include "FiniteElement.h"
+#include "GenericDofMap.h"
+#include "MultigridTransfer.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+void MultigridTransfer::build_prolongation(GenericMatrix& P,
+                                           const FunctionSpace& V_coarse,
+                                           const FunctionSpace& V_fine,
+                                           const MeshHierarchy& hierarchy)
+{
+  build(P, V_coarse, V_fine, hierarchy, false);
+}
+//-----------------------------------------------------------------------------
+void MultigridTransfer::build_restriction(GenericMatrix& R,
+                                          const FunctionSpace& V_coarse,
+                                          const FunctionSpace& V_fine,
+                                          const MeshHierarchy& hierarchy)
+{
+  build(R, V_coarse, V_fine, hierarchy, true);
+}
+//-----------------------------------------------------------------------------
+void MultigridTransfer::build(GenericMatrix& A,
+                              const FunctionSpace& V_coarse,
+                              const FunctionSpace& V_fine,
+                              const MeshHierarchy& hierarchy, bool transpose)
+{
+  Timer timer("Build multigrid transfer matrix");
+
+  dolfin_assert(V_coarse.mesh());
+  dolfin_assert(V_fine.mesh());
+  const Mesh& coarse_mesh = *V_coarse.mesh();
+  const Mesh& fine_mesh = *V_fine.mesh();
+
+  // Check that meshes are on consecutive levels
+  const std::size_t level = hierarchy.level(fine_mesh);
+  if (level == 0 || hierarchy.mesh(level - 1).get() != &coarse_mesh)
+  {
+    dolfin_error("MultigridTransfer.cpp",
+                 "build multigrid transfer matrix",
+                 "Function spaces must be defined on consecutive levels of the mesh hierarchy");
+  }
+  const std::vector<std::size_t>& parent_cells = hierarchy.parent_cells(level);
+
+  // Check elements
+  dolfin_assert(V_coarse.element());
+  dolfin_assert(V_fine.element());
+  const FiniteElement& coarse_element = *V_coarse.element();
+  const FiniteElement& fine_element = *V_fine.element();
+  if (coarse_element.signature() != fine_element.signature())
+  {
+    dolfin_error("MultigridTransfer.cpp",
+                 "build multigrid transfer matrix",
+                 "Function spaces must have the same finite element");
+  }
+
+  // Dofmaps for rows (0) and columns (1)
+  dolfin_assert(V_coarse.dofmap());
+  dolfin_assert(V_fine.dofmap());
+  const GenericDofMap* dofmaps[2] = {V_fine.dofmap().get(),
+                                     V_coarse.dofmap().get()};
+  if (transpose)
+    std::swap(dofmaps[0], dofmaps[1]);
+
+  // Initialise tensor layout
+  std::shared_ptr<TensorLayout> layout = A.factory().create_layout(2);
+  dolfin_assert(layout);
+  std::vector<std::size_t> global_dimensions(2);
+  std::vector<std::pair<std::size_t, std::size_t> > local_range(2);
+  std::vector<const std::vector<std::size_t>* > local_to_global(2);
+  std::vector<const std::vector<int>* > off_process_owner(2);
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    global_dimensions[i] = dofmaps[i]->global_dimension();
+    local_range[i] = dofmaps[i]->ownership_range();
+    local_to_global[i] = &dofmaps[i]->local_to_global_unowned();
+    off_process_owner[i] = &dofmaps[i]->off_process_owner();
+  }
+  layout->init(fine_mesh.mpi_comm(), global_dimensions, 1, local_range);
+  layout->local_to_global_map.resize(2);
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    const std::size_t bs = dofmaps[i]->block_size;
+    const std::size_t local_size = local_range[i].second - local_range[i].first;
+    layout->local_to_global_map[i].resize(local_size
+                                          + bs*local_to_global[i]->size());
+    for (std::size_t j = 0; j < layout->local_to_global_map[i].size(); ++j)
+      layout->local_to_global_map[i][j] = dofmaps[i]->local_to_global_index(j);
+  }
+
+  // Build sparsity pattern: fine cell dofs couple to the dofs of the
+  // parent cell
+  std::vector<const std::vector<dolfin::la_index>* > dofs(2);
+  if (layout->sparsity_pattern())
+  {
+    GenericSparsityPattern& pattern = *layout->sparsity_pattern();
+    pattern.init(fine_mesh.mpi_comm(), global_dimensions, local_range,
+                 local_to_global, off_process_owner, 1);
+    for (std::size_t c = 0; c < fine_mesh.num_cells(); ++c)
+    {
+      dofs[0] = &V_fine.dofmap()->cell_dofs(c);
+      dofs[1] = &V_coarse.dofmap()->cell_dofs(parent_cells[c]);
+      if (transpose)
+        std::swap(dofs[0], dofs[1]);
+      pattern.insert_local(dofs);
+    }
+    pattern.apply();
+  }
+  A.init(*layout);
+
+  // Compute local transfer matrices: entry (i, j) is fine dof i
+  // applied to coarse basis function j on the parent cell
+  const std::size_t fine_dim = fine_element.space_dimension();
+  const std::size_t coarse_dim = coarse_element.space_dimension();
+  std::vector<double> values(fine_dim), A_local(fine_dim*coarse_dim);
+  std::vector<double> fine_coordinates, coarse_coordinates;
+  ufc::cell ufc_cell;
+  for (CellIterator cell(fine_mesh); !cell.end(); ++cell)
+  {
+    const Cell parent(coarse_mesh, parent_cells[cell->index()]);
+    cell->get_vertex_coordinates(fine_coordinates);
+    cell->get_cell_data(ufc_cell);
+    parent.get_vertex_coordinates(coarse_coordinates);
+
+    for (std::size_t j = 0; j < coarse_dim; ++j)
+    {
+      const BasisFunction phi(j, coarse_element, coarse_coordinates);
+      fine_element.evaluate_dofs(values.data(), phi, fine_coordinates.data(),
+                                 ufc_cell.orientation, ufc_cell);
+      for (std::size_t i = 0; i < fine_dim; ++i)
+      {
+        // Drop round-off
+        const double v = std::abs(values[i]) < DOLFIN_EPS ? 0.0 : values[i];
+        if (transpose)
+          A_local[j*fine_dim + i] = v;
+        else
+          A_local[i*coarse_dim + j] = v;
+      }
+    }
+
+    // Entries for dofs shared between cells are equal, so they are
+    // inserted rather than added
+    const std::vector<dolfin::la_index>& fine_dofs
+      = V_fine.dofmap()->cell_dofs(cell->index());
+    const std::vector<dolfin::la_index>& coarse_dofs
+      = V_coarse.dofmap()->cell_dofs(parent.index());
+    if (transpose)
+    {
+      A.set_local(A_local.data(), coarse_dofs.size(), coarse_dofs.data(),
+                  fine_dofs.size(), fine_dofs.data());
+    }
+    else
+    {
+      A.set_local(A_local.data(), fine_dofs.size(), fine_dofs.data(),
+                  coarse_dofs.size(), coarse_dofs.data());
+    }
+  }
+  A.apply("insert");
+}
+//-----------------------------------------------------------------------------
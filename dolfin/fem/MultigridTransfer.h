@@ -0,0 +1,77 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __MULTIGRID_TRANSFER_H
+#define __MULTIGRID_TRANSFER_H
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class FunctionSpace;
+  class GenericMatrix;
+  class MeshHierarchy;
+
+  /// This class builds transfer operators between function spaces
+  /// on consecutive levels of a _MeshHierarchy_, for use in
+  /// geometric multigrid.
+  ///
+  /// The prolongation P maps coefficients of a function on the coarse
+  /// space to the coefficients of the same function on the fine
+  /// space. Row i of P holds the degree of freedom i of the fine
+  /// element applied to the coarse basis functions of the parent
+  /// cell. The restriction is the transpose of P. Both matrices are
+  /// sparse and are built in one pass over the cells of the fine
+  /// mesh.
+  ///
+  /// The matrices can be passed on to a multigrid preconditioner of
+  /// a linear algebra backend (e.g. PCMG in PETSc).
+
+  class MultigridTransfer
+  {
+  public:
+
+    /// Build prolongation matrix from V_coarse to V_fine, where
+    /// the meshes of V_coarse and V_fine are on consecutive levels
+    /// of the hierarchy
+    static void build_prolongation(GenericMatrix& P,
+                                   const FunctionSpace& V_coarse,
+                                   const FunctionSpace& V_fine,
+                                   const MeshHierarchy& hierarchy);
+
+    /// Build restriction matrix (the transpose of the prolongation)
+    /// from V_fine to V_coarse
+    static void build_restriction(GenericMatrix& R,
+                                  const FunctionSpace& V_coarse,
+                                  const FunctionSpace& V_fine,
+                                  const MeshHierarchy& hierarchy);
+
+  private:
+
+    // Build prolongation (or its transpose)
+    static void build(GenericMatrix& A, const FunctionSpace& V_coarse,
+                      const FunctionSpace& V_fine,
+                      const MeshHierarchy& hierarchy, bool transpose);
+
+  };
+
+}
+
+#endif
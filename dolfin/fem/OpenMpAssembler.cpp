@@ -21,7 +21,7 @@
 // Modified by Anders Logg 2010-2013
 //
 // First added:  2010-11-10
-// Last changed: 2013-02-26
+// Last changed: 2026-10-19
 
 #ifdef HAS_OPENMP
 
@@ -34,6 +34,7 @@
 #include <dolfin/log/dolfin_log.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/parameter/ParameterHandle.h>
 #include <dolfin/la/GenericTensor.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
@@ -122,7 +123,9 @@ void OpenMpAssembler::assemble_cells(GenericTensor& A, const Form& a,
   Timer timer("Assemble cells");
 
   // Set number of OpenMP threads (from parameter systems)
-  const std::size_t num_threads = parameters["num_threads"];
+  static const ParameterHandle<int> num_threads_parameter(parameters,
+                                                          "num_threads");
+  const std::size_t num_threads = num_threads_parameter.value();
   omp_set_num_threads(num_threads);
 
   // Extract mesh
@@ -251,7 +254,9 @@ void OpenMpAssembler::assemble_cells_and_exterior_facets(GenericTensor& A,
   Timer timer("Assemble cells and exterior facets");
 
   // Set number of OpenMP threads (from parameter systems)
-  const int num_threads = parameters["num_threads"];
+  static const ParameterHandle<int> num_threads_parameter(parameters,
+                                                          "num_threads");
+  const int num_threads = num_threads_parameter.value();
   omp_set_num_threads(num_threads);
 
   // Extract mesh
@@ -13,6 +13,8 @@
 #include <dolfin/fem/PointSource.h>
 #include <dolfin/fem/assemble.h>
 #include <dolfin/fem/LocalSolver.h>
+#include <dolfin/fem/MatrixFreeOperator.h>
+#include <dolfin/fem/MultigridTransfer.h>
 #include <dolfin/fem/solve.h>
 #include <dolfin/fem/Form.h>
 #include <dolfin/fem/AssemblerBase.h>
@@ -20,7 +20,7 @@
 // Modified by Andre Massing 2009
 //
 // First added:  2003-11-28
-// Last changed: 2014-06-04
+// Last changed: 2026-10-19
 
 #include <algorithm>
 #include <map>
@@ -316,13 +316,47 @@ void Function::operator=(const FunctionAXPY& axpy)
                  "FunctionAXPY is empty.");
   }
 
+  // If all functions are in the function space of this function (and
+  // none is a sub-function), compute the linear combination in place
+  // in a single pass over the vectors. Terms with the vector of this
+  // function are collected in the scale of y in y = beta*y + sum a*x.
+  dolfin_assert(_vector);
+  dolfin_assert(_function_space);
+  bool same_space = _vector->size() == _function_space->dim();
+  std::vector<std::pair<double, const Function*> >::const_iterator it;
+  for (it = axpy.pairs().begin(); it != axpy.pairs().end() && same_space; ++it)
+  {
+    dolfin_assert(it->second);
+    same_space = it->second->_vector->size() == _function_space->dim()
+      && (it->second->_function_space == _function_space
+          || *it->second->_function_space == *_function_space);
+  }
+
+  if (same_space)
+  {
+    double beta = 0.0;
+    std::vector<double> a;
+    std::vector<const GenericVector*> x;
+    for (it = axpy.pairs().begin(); it != axpy.pairs().end(); ++it)
+    {
+      if (it->second->_vector == _vector)
+        beta += it->first;
+      else
+      {
+        a.push_back(it->first);
+        x.push_back(it->second->_vector.get());
+      }
+    }
+    _vector->maxpy(beta, a, x);
+    return;
+  }
+
   // Make an initial assign and scale
   *this = *(axpy.pairs()[0].second);
   if (axpy.pairs()[0].first != 1.0)
     *_vector *= axpy.pairs()[0].first;
 
   // Start from item 2 and axpy
-  std::vector<std::pair<double, const Function*> >::const_iterator it;
   for (it = axpy.pairs().begin()+1; it != axpy.pairs().end(); it++)
     _vector->axpy(it->first, *(it->second->vector()));
 }
@@ -16,8 +16,9 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-09-20
-// Last changed: 2014-02-28
+// Last changed: 2026-10-19
 
+#include <algorithm>
 #include <utility>
 
 #include <map>
@@ -43,6 +44,7 @@ FunctionAssigner::FunctionAssigner(std::shared_ptr<const FunctionSpace> receivin
 
   // Build vectors of indices
   _check_and_build_indices(mesh, _receiving_spaces, _assigning_spaces);
+  _build_segments();
 }
 //-----------------------------------------------------------------------------
 FunctionAssigner::FunctionAssigner(std::vector<std::shared_ptr<const FunctionSpace> > receiving_spaces,
@@ -74,6 +76,7 @@ FunctionAssigner::FunctionAssigner(std::vector<std::shared_ptr<const FunctionSpa
 
   // Build vectors of indices
   _check_and_build_indices(mesh, _receiving_spaces, assigning_sub_spaces);
+  _build_segments();
 }
 //-----------------------------------------------------------------------------
 FunctionAssigner::FunctionAssigner(std::shared_ptr<const FunctionSpace> receiving_space,
@@ -105,6 +108,7 @@ FunctionAssigner::FunctionAssigner(std::shared_ptr<const FunctionSpace> receivin
 
   // Build vectors of indices
   _check_and_build_indices(mesh, receiving_sub_spaces, _assigning_spaces);
+  _build_segments();
 }
 //-----------------------------------------------------------------------------
 FunctionAssigner::~FunctionAssigner()
@@ -177,8 +181,8 @@ void FunctionAssigner::assign(std::vector<std::shared_ptr<Function> > receiving_
   _assign(receiving_funcs, assigning_funcs);
 }
 //-----------------------------------------------------------------------------
-void FunctionAssigner::_assign(std::vector<std::shared_ptr<Function> > receiving_funcs,
-			       std::vector<std::shared_ptr<const Function> > assigning_funcs) const
+void FunctionAssigner::_assign(const std::vector<std::shared_ptr<Function> >& receiving_funcs,
+			       const std::vector<std::shared_ptr<const Function> >& assigning_funcs) const
 {
   // Num spaces
   const std::size_t N = std::max(_assigning_spaces.size(),
@@ -200,9 +204,20 @@ void FunctionAssigner::_assign(std::vector<std::shared_ptr<Function> > receiving
 		 "the number of receiving (sub)spaces.");
   }
 
-  // Flag to determine if the receiving vector is the same
-  bool same_receiving_vector = true;
-  const GenericVector* recieving_vector = receiving_funcs[0]->_vector.get();
+  // Check if values can be copied directly between the vector data
+  bool direct = true;
+  for (std::size_t i = 0; i < N && direct; i++)
+  {
+    dolfin_assert(assigning_funcs[i] && assigning_funcs[i]->_vector);
+    dolfin_assert(receiving_funcs[i] && receiving_funcs[i]->_vector);
+    direct = !_segments[i].empty()
+      && assigning_funcs[i]->_vector->has_data()
+      && receiving_funcs[i]->_vector->has_data();
+  }
+
+  // Pointers to vector data for each space (direct copy only)
+  std::vector<const double*> assigning_data(direct ? N : 0);
+  std::vector<double*> receiving_data(direct ? N : 0);
 
   // Iterate over the spaces and do the assignments
   for (std::size_t i = 0; i < N; i++)
@@ -291,13 +306,15 @@ void FunctionAssigner::_assign(std::vector<std::shared_ptr<Function> > receiving
       }
     }
 
-    // Check if the receiving vector is the same
-    if (i != 0)
+    // Copy values directly using the strided segments
+    if (direct)
     {
-      dolfin_assert(receiving_funcs[i]->_vector);
-      same_receiving_vector
-        = (recieving_vector != receiving_funcs[i]->_vector.get())
-	&& same_receiving_vector;
+      const GenericVector& assigning_vector = *assigning_funcs[i]->_vector;
+      assigning_data[i] = assigning_vector.data();
+      receiving_data[i] = receiving_funcs[i]->_vector->data();
+      if (!_batched)
+        _transfer_segments(i, assigning_data[i], receiving_data[i]);
+      continue;
     }
 
     // Get assigning values
@@ -309,15 +326,121 @@ void FunctionAssigner::_assign(std::vector<std::shared_ptr<Function> > receiving
     receiving_funcs[i]->_vector->set_local(&_transfer[i][0],
                                            _transfer[i].size(),
                                            &_receiving_indices[i][0]);
+  }
+
+  // Transfer all sub functions in one pass
+  if (direct && _batched)
+    _transfer_batched(assigning_data, receiving_data);
 
-    // If not same receiving vector
-    if (!same_receiving_vector)
+  // Finalise receiving vectors (sub functions share the vector of
+  // their parent)
+  receiving_funcs[0]->_vector->apply("insert");
+  for (std::size_t i = 1; i < N; i++)
+  {
+    if (receiving_funcs[i]->_vector != receiving_funcs[0]->_vector)
       receiving_funcs[i]->_vector->apply("insert");
   }
+}
+//-----------------------------------------------------------------------------
+void FunctionAssigner::_transfer_segments(std::size_t i,
+                                          const double* assigning_values,
+                                          double* receiving_values) const
+{
+  std::vector<Segment>::const_iterator segment;
+  for (segment = _segments[i].begin(); segment != _segments[i].end();
+       ++segment)
+  {
+    const double* x = assigning_values + segment->assigning_offset;
+    double* y = receiving_values + segment->receiving_offset;
+    const la_index xs = segment->assigning_stride;
+    const la_index ys = segment->receiving_stride;
+    if (xs == 1 && ys == 1)
+      std::copy(x, x + segment->count, y);
+    else
+    {
+      const la_index count = segment->count;
+      for (la_index k = 0; k < count; ++k)
+        y[k*ys] = x[k*xs];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void FunctionAssigner::_transfer_batched(
+  const std::vector<const double*>& assigning_values,
+  const std::vector<double*>& receiving_values) const
+{
+  const std::size_t N = _segments.size();
+  dolfin_assert(_batched);
+  dolfin_assert(assigning_values.size() == N);
+  dolfin_assert(receiving_values.size() == N);
+  const la_index count = _segments[0][0].count;
+  for (la_index k = 0; k < count; ++k)
+  {
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      const Segment& segment = _segments[i][0];
+      receiving_values[i][segment.receiving_offset
+                          + k*segment.receiving_stride]
+        = assigning_values[i][segment.assigning_offset
+                              + k*segment.assigning_stride];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void FunctionAssigner::_build_segments()
+{
+  // Segments are only used if they hold this many values on average
+  const std::size_t min_average_count = 8;
 
-  // If same receiving vector
-  if (same_receiving_vector)
-    receiving_funcs[0]->_vector->apply("insert");
+  const std::size_t N = _receiving_indices.size();
+  _segments.resize(N);
+  for (std::size_t i = 0; i < N; i++)
+  {
+    const std::vector<la_index>& r = _receiving_indices[i];
+    const std::vector<la_index>& a = _assigning_indices[i];
+    dolfin_assert(r.size() == a.size());
+    const std::size_t n = r.size();
+
+    // Greedily extend segments while both strides are unchanged
+    std::vector<Segment>& segments = _segments[i];
+    segments.clear();
+    std::size_t k = 0;
+    while (k < n)
+    {
+      Segment segment;
+      segment.count = 1;
+      segment.receiving_offset = r[k];
+      segment.assigning_offset = a[k];
+      segment.receiving_stride = 0;
+      segment.assigning_stride = 0;
+      if (k + 1 < n)
+      {
+        segment.receiving_stride = r[k + 1] - r[k];
+        segment.assigning_stride = a[k + 1] - a[k];
+        while (k + segment.count < n
+               && r[k + segment.count] - r[k + segment.count - 1]
+                  == segment.receiving_stride
+               && a[k + segment.count] - a[k + segment.count - 1]
+                  == segment.assigning_stride)
+        {
+          ++segment.count;
+        }
+      }
+      segments.push_back(segment);
+      k += segment.count;
+    }
+
+    if (segments.size()*min_average_count > n)
+      segments.clear();
+  }
+
+  // Check if all spaces can be transferred in one pass
+  _batched = N > 1 && _segments[0].size() == 1;
+  for (std::size_t i = 1; i < N && _batched; i++)
+  {
+    _batched = _segments[i].size() == 1
+      && _segments[i][0].count == _segments[0][0].count;
+  }
 }
 //-----------------------------------------------------------------------------
 const Mesh& FunctionAssigner::_get_mesh() const
@@ -16,13 +16,14 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-09-20
-// Last changed: 2013-11-11
+// Last changed: 2026-10-19
 
 #ifndef __DOLFIN_FUNCTION_ASSIGNER_H
 #define __DOLFIN_FUNCTION_ASSIGNER_H
 
 #include <vector>
 #include <memory>
+#include <dolfin/common/types.h>
 
 namespace dolfin
 {
@@ -37,6 +38,12 @@ namespace dolfin
   /// perform the actual assignment. Optionally can a MeshFunction be
   /// passed together with a label, facilitating FunctionAssignment
   /// over sub domains.
+  ///
+  /// The maps are compressed into segments of strided copies when
+  /// possible (e.g. extracting a component from a vector-valued
+  /// function). For backends giving direct access to the vector data,
+  /// values are then copied without intermediate buffers, and
+  /// several sub functions are transferred in a single pass.
   class FunctionAssigner
   {
   public:
@@ -129,8 +136,20 @@ namespace dolfin
   private:
 
     // Utility function to actually do the assignment
-    void _assign(std::vector<std::shared_ptr<Function> > receiving_funcs,
-	std::vector<std::shared_ptr<const Function> > assigning_funcs) const;
+    void _assign(const std::vector<std::shared_ptr<Function> >& receiving_funcs,
+	const std::vector<std::shared_ptr<const Function> >& assigning_funcs) const;
+
+    // Transfer values for space i using the strided segments
+    void _transfer_segments(std::size_t i, const double* assigning_values,
+                            double* receiving_values) const;
+
+    // Transfer values for all spaces in a single pass (requires a
+    // single segment of the same length for each space)
+    void _transfer_batched(const std::vector<const double*>& assigning_values,
+                           const std::vector<double*>& receiving_values) const;
+
+    // Compress index maps into strided segments
+    void _build_segments();
 
     // Check the compatibility of the meshes and return a reference to
     // the mesh
@@ -155,6 +174,23 @@ namespace dolfin
     // Vector for value transfer between assigning and receiving Function
     mutable std::vector<std::vector<double> > _transfer;
 
+    // A segment of count values, copied from assigning index
+    // assigning_offset + k*assigning_stride to receiving index
+    // receiving_offset + k*receiving_stride
+    struct Segment
+    {
+      std::size_t count;
+      la_index receiving_offset, receiving_stride;
+      la_index assigning_offset, assigning_stride;
+    };
+
+    // Strided segments for each space (empty if the index maps do
+    // not compress well)
+    std::vector<std::vector<Segment> > _segments;
+
+    // True if all spaces have a single segment of the same length
+    bool _batched;
+
   };
 }
 
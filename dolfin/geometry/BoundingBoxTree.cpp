@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-04-09
-// Last changed: 2014-05-12
+// Last changed: 2026-10-19
 
 #include <dolfin/common/NoDeleter.h>
 #include <dolfin/geometry/Point.h>
@@ -30,7 +30,7 @@
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-BoundingBoxTree::BoundingBoxTree() : _mesh(0)
+BoundingBoxTree::BoundingBoxTree() : _mesh(0), _tdim(0), _topology_version(0)
 {
   // Do nothing
 }
@@ -72,6 +72,8 @@ void BoundingBoxTree::build(const Mesh& mesh, std::size_t tdim)
 
   // Store mesh
   _mesh = &mesh;
+  _tdim = tdim;
+  _topology_version = mesh.topology().version();
 }
 //-----------------------------------------------------------------------------
 void BoundingBoxTree::build(const std::vector<Point>& points, std::size_t gdim)
@@ -98,6 +100,39 @@ void BoundingBoxTree::build(const std::vector<Point>& points, std::size_t gdim)
   // Build tree
   dolfin_assert(_tree);
   _tree->build(points);
+
+  // No mesh
+  _mesh = 0;
+  _tdim = 0;
+}
+//-----------------------------------------------------------------------------
+bool BoundingBoxTree::refit(double max_cost_ratio)
+{
+  // Check that tree has been built
+  _check_built();
+  if (!_mesh)
+  {
+    dolfin_error("BoundingBoxTree.cpp",
+                 "refit bounding box tree",
+                 "Bounding box tree was not built for a mesh");
+  }
+
+  // Rebuild if the topology has changed
+  if (_mesh->topology().version() != _topology_version)
+  {
+    build(*_mesh, _tdim);
+    return true;
+  }
+
+  return _tree->refit(*_mesh, max_cost_ratio);
+}
+//-----------------------------------------------------------------------------
+double BoundingBoxTree::compute_sah_cost() const
+{
+  // Check that tree has been built
+  _check_built();
+
+  return _tree->compute_sah_cost();
 }
 //-----------------------------------------------------------------------------
 std::vector<unsigned int>
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-04-09
-// Last changed: 2014-05-12
+// Last changed: 2026-10-19
 
 #ifndef __BOUNDING_BOX_TREE_H
 #define __BOUNDING_BOX_TREE_H
@@ -73,6 +73,35 @@ namespace dolfin
     ///         The geometric dimension.
     void build(const std::vector<Point>& points, std::size_t gdim);
 
+    /// Update bounding box tree after the mesh for which it was built
+    /// has moved. If the mesh topology is unchanged, the bounding
+    /// boxes are recomputed bottom-up (refit) in linear time, keeping
+    /// the tree structure. The tree is rebuilt if the topology has
+    /// changed, or if the quality of the refitted tree has degraded
+    /// too much.
+    ///
+    /// *Arguments*
+    ///     max_cost_ratio (double)
+    ///         Rebuild if the surface area heuristic cost (see
+    ///         compute_sah_cost) grows past this factor times the cost
+    ///         of the tree when built.
+    ///
+    /// *Returns*
+    ///     bool
+    ///         True if the tree was rebuilt.
+    bool refit(double max_cost_ratio=2.0);
+
+    /// Compute surface area heuristic (SAH) cost of tree, measuring
+    /// the expected number of bounding box tests for a query. It is
+    /// computed as the sum of surface areas (lengths in 1D,
+    /// perimeters in 2D) of all bounding boxes, divided by the
+    /// surface area of the root box.
+    ///
+    /// *Returns*
+    ///     double
+    ///         The SAH cost.
+    double compute_sah_cost() const;
+
     /// Compute all collisions between bounding boxes and _Point_.
     ///
     /// *Returns*
@@ -258,6 +287,11 @@ namespace dolfin
     // tree_A.compute_entity_intersections(tree_B, mesh_A, mesh_B).
     const Mesh* _mesh;
 
+    // Topological dimension of entities and topology version of the
+    // mesh when the tree was built
+    std::size_t _tdim;
+    std::size_t _topology_version;
+
   };
 
 }
@@ -16,18 +16,21 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-05-02
-// Last changed: 2014-02-06
+// Last changed: 2026-10-19
 
 // Define a maximum dimension used for a local array in the recursive
 // build function. Speeds things up compared to allocating it in each
 // recursion and is more convenient than sending it around.
 #define MAX_DIM 6
 
+#include <limits>
 #include <dolfin/geometry/Point.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/MeshEntity.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
+#include <dolfin/mesh/MeshRange.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "BoundingBoxTree1D.h" // used for internal point search tree
 #include "BoundingBoxTree2D.h" // used for internal point search tree
 #include "BoundingBoxTree3D.h" // used for internal point search tree
@@ -36,7 +39,7 @@
 using namespace dolfin;
 
 //-----------------------------------------------------------------------------
-GenericBoundingBoxTree::GenericBoundingBoxTree() : _tdim(0)
+GenericBoundingBoxTree::GenericBoundingBoxTree() : _tdim(0), _built_cost(0.0)
 {
   // Do nothing
 }
@@ -62,20 +65,68 @@ void GenericBoundingBoxTree::build(const Mesh& mesh, std::size_t tdim)
   // Initialize entities of given dimension if they don't exist
   mesh.init(tdim);
 
+  // Check that there is at least one entity (the tree would have no
+  // root)
+  const unsigned int num_leaves = mesh.num_entities(tdim);
+  if (num_leaves == 0)
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "compute bounding box tree",
+                 "Mesh has no entities of dimension %d", tdim);
+  }
+
   // Create bounding boxes for all entities (leaves)
   const std::size_t _gdim = gdim();
-  const unsigned int num_leaves = mesh.num_entities(tdim);
   std::vector<double> leaf_bboxes(2*_gdim*num_leaves);
-  for (MeshEntityIterator it(mesh, tdim); !it.end(); ++it)
-    compute_bbox_of_entity(leaf_bboxes.data() + 2*_gdim*it->index(), *it, _gdim);
+  const IndexRange entities = MeshRange::entities(mesh, tdim);
+  const StridedArray<unsigned int> vertices
+    = MeshRange::entity_vertices(mesh, tdim);
+  const double* x = MeshRange::coordinates(mesh).data();
+  const int num_entities = entities.end_index();
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #else
+  const int num_threads = 1;
+  #endif
+  for (int i = 0; i < num_entities; ++i)
+  {
+    compute_bbox_of_entity(leaf_bboxes.data() + 2*_gdim*i, vertices[i],
+                           vertices.stride(), x, _gdim);
+  }
 
   // Create leaf partition (to be sorted)
   std::vector<unsigned int> leaf_partition(num_leaves);
   for (unsigned int i = 0; i < num_leaves; ++i)
     leaf_partition[i] = i;
 
-  // Recursively build the bounding box tree from the leaves
-  _build(leaf_bboxes, leaf_partition.begin(), leaf_partition.end(), _gdim);
+  // Allocate nodes (a tree with n leaves has 2n - 1 nodes)
+  _bboxes.resize(2*num_leaves - 1);
+  _bbox_coordinates.resize(2*_gdim*_bboxes.size());
+
+  // Build the top of the tree, leaving subtrees of roughly equal
+  // size to be built in parallel
+  std::vector<SubTree> subtrees;
+  const std::size_t grain
+    = num_threads > 1 ? num_leaves/(8*num_threads) + 1 : num_leaves;
+  const std::vector<unsigned int>::iterator first = leaf_partition.begin();
+  _build(leaf_bboxes, first, leaf_partition.end(), first, 0, _gdim, grain,
+         &subtrees);
+
+  // Build subtrees
+  const int num_subtrees = subtrees.size();
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  #endif
+  for (int i = 0; i < num_subtrees; ++i)
+  {
+    const SubTree& t = subtrees[i];
+    _build(leaf_bboxes, first + t.begin, first + t.end, first, t.offset,
+           _gdim, grain, 0);
+  }
+
+  // Store cost for checking quality after refit
+  _built_cost = compute_sah_cost();
 
   log(PROGRESS,
       "Computed bounding box tree with %d nodes for %d entities.",
@@ -100,6 +151,108 @@ void GenericBoundingBoxTree::build(const std::vector<Point>& points)
        num_bboxes(), num_leaves);
 }
 //-----------------------------------------------------------------------------
+bool GenericBoundingBoxTree::refit(const Mesh& mesh, double max_cost_ratio)
+{
+  // Refit only implemented for mesh entities
+  if (_tdim == 0)
+  {
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "refit bounding box tree",
+                 "Bounding box tree was not built for mesh entities");
+  }
+  dolfin_assert(2*mesh.topology().size(_tdim) == num_bboxes() + 1);
+
+  // Compute levels if not already done
+  if (_refit_levels.empty())
+    compute_refit_levels();
+
+  // Get entity vertices and coordinates
+  const std::size_t _gdim = gdim();
+  const StridedArray<unsigned int> vertices
+    = MeshRange::entity_vertices(mesh, _tdim);
+  const double* x = MeshRange::coordinates(mesh).data();
+  const std::size_t num_regular = MeshRange::entities(mesh, _tdim).size();
+
+  // Recompute bounding boxes level by level, starting with the
+  // deepest level. Nodes on the same level are independent.
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+  for (std::size_t level = 0; level + 1 < _refit_levels.size(); ++level)
+  {
+    const int begin = _refit_levels[level];
+    const int end = _refit_levels[level + 1];
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    #endif
+    for (int i = begin; i < end; ++i)
+    {
+      const unsigned int node = _refit_nodes[i];
+      const BBox& bbox = _bboxes[node];
+      double* b = _bbox_coordinates.data() + 2*_gdim*node;
+
+      if (is_leaf(bbox, node))
+      {
+        // Ghost entities are skipped as in build()
+        if (bbox.child_1 < num_regular)
+        {
+          compute_bbox_of_entity(b, vertices[bbox.child_1],
+                                 vertices.stride(), x, _gdim);
+        }
+      }
+      else
+      {
+        const double* b0 = _bbox_coordinates.data() + 2*_gdim*bbox.child_0;
+        const double* b1 = _bbox_coordinates.data() + 2*_gdim*bbox.child_1;
+        for (std::size_t j = 0; j < _gdim; ++j)
+        {
+          b[j] = std::min(b0[j], b1[j]);
+          b[_gdim + j] = std::max(b0[_gdim + j], b1[_gdim + j]);
+        }
+      }
+    }
+  }
+
+  // Point search tree (for cell midpoints) is out of date
+  _point_search_tree.reset();
+
+  // Rebuild tree if quality has degraded too much
+  const double cost = compute_sah_cost();
+  if (cost > max_cost_ratio*_built_cost)
+  {
+    log(PROGRESS,
+        "Rebuilding bounding box tree (SAH cost %g, %g when built).",
+        cost, _built_cost);
+    build(mesh, _tdim);
+    return true;
+  }
+
+  return false;
+}
+//-----------------------------------------------------------------------------
+double GenericBoundingBoxTree::compute_sah_cost() const
+{
+  const int num_nodes = num_bboxes();
+  if (num_nodes == 0)
+    return 0.0;
+
+  // Sum surface areas of all boxes
+  const std::size_t _gdim = gdim();
+  const double* b = _bbox_coordinates.data();
+  double area = 0.0;
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static) reduction(+:area)
+  #endif
+  for (int node = 0; node < num_nodes; ++node)
+    area += compute_bbox_area(b + 2*_gdim*node, _gdim);
+
+  // Normalize by area of root (added last)
+  const double root_area = compute_bbox_area(b + 2*_gdim*(num_nodes - 1),
+                                             _gdim);
+  return root_area > 0.0 ? area/root_area : 0.0;
+}
+//-----------------------------------------------------------------------------
 std::vector<unsigned int>
 GenericBoundingBoxTree::compute_collisions(const Point& point) const
 {
@@ -260,30 +413,53 @@ void GenericBoundingBoxTree::clear()
   _bboxes.clear();
   _bbox_coordinates.clear();
   _point_search_tree.reset();
+  _built_cost = 0.0;
+  _refit_nodes.clear();
+  _refit_levels.clear();
 }
 //-----------------------------------------------------------------------------
 unsigned int
 GenericBoundingBoxTree::_build(const std::vector<double>& leaf_bboxes,
                                const std::vector<unsigned int>::iterator& begin,
                                const std::vector<unsigned int>::iterator& end,
-                               std::size_t gdim)
+                               const std::vector<unsigned int>::iterator& first,
+                               unsigned int offset,
+                               std::size_t gdim,
+                               std::size_t grain,
+                               std::vector<SubTree>* subtrees)
 {
   dolfin_assert(begin < end);
 
+  // Root of subtree is stored last
+  const unsigned int num_leaves = end - begin;
+  const unsigned int node = offset + 2*num_leaves - 2;
+
   // Create empty bounding box data
   BBox bbox;
 
   // Reached leaf
-  if (end - begin == 1)
+  if (num_leaves == 1)
   {
     // Get bounding box coordinates for leaf
     const unsigned int entity_index = *begin;
     const double* b = leaf_bboxes.data() + 2*gdim*entity_index;
 
     // Store bounding box data
-    bbox.child_0 = num_bboxes(); // child_0 == node denotes a leaf
+    bbox.child_0 = node;         // child_0 == node denotes a leaf
     bbox.child_1 = entity_index; // index of entity contained in leaf
-    return add_bbox(bbox, b, gdim);
+    set_bbox(node, bbox, b, gdim);
+    return node;
+  }
+
+  // Leave subtree to be built later
+  if (subtrees && num_leaves <= grain)
+  {
+    SubTree t;
+    t.begin = begin - first;
+    t.end = end - first;
+    t.offset = offset;
+    subtrees->push_back(t);
+    return node;
   }
 
   // Compute bounding box of all bounding boxes
@@ -291,16 +467,165 @@ GenericBoundingBoxTree::_build(const std::vector<double>& leaf_bboxes,
   std::size_t axis;
   compute_bbox_of_bboxes(b, axis, leaf_bboxes, begin, end);
 
-  // Sort bounding boxes along longest axis
+  // Split bounding boxes into two groups and call recursively. The
+  // left subtree is stored first.
+  std::vector<unsigned int>::iterator middle
+    = split_bboxes(leaf_bboxes, begin, end, axis, gdim);
+  const unsigned int offset_1 = offset + 2*(middle - begin) - 1;
+  bbox.child_0 = _build(leaf_bboxes, begin, middle, first, offset, gdim,
+                        grain, subtrees);
+  bbox.child_1 = _build(leaf_bboxes, middle, end, first, offset_1, gdim,
+                        grain, subtrees);
+
+  // Store bounding box data
+  set_bbox(node, bbox, b, gdim);
+  return node;
+}
+//-----------------------------------------------------------------------------
+std::vector<unsigned int>::iterator
+GenericBoundingBoxTree::split_bboxes(const std::vector<double>& leaf_bboxes,
+                                     const std::vector<unsigned int>::iterator& begin,
+                                     const std::vector<unsigned int>::iterator& end,
+                                     std::size_t axis,
+                                     std::size_t gdim)
+{
+  // Number of bins and minimum number of boxes for SAH split
+  const std::size_t num_bins = 16;
+  const std::size_t min_sah_size = 8;
+
+  // Use median split along longest axis for small groups
   std::vector<unsigned int>::iterator middle = begin + (end - begin) / 2;
-  sort_bboxes(axis, leaf_bboxes, begin, middle, end);
+  if ((std::size_t) (end - begin) < min_sah_size)
+  {
+    sort_bboxes(axis, leaf_bboxes, begin, middle, end);
+    return middle;
+  }
 
-  // Split bounding boxes into two groups and call recursively
-  bbox.child_0 = _build(leaf_bboxes, begin, middle, gdim);
-  bbox.child_1 = _build(leaf_bboxes, middle, end, gdim);
+  // Compute range of box midpoints (times two) along each axis
+  double cmin[MAX_DIM/2], cmax[MAX_DIM/2];
+  for (std::size_t j = 0; j < gdim; ++j)
+  {
+    cmin[j] = std::numeric_limits<double>::max();
+    cmax[j] = -std::numeric_limits<double>::max();
+  }
+  for (std::vector<unsigned int>::iterator it = begin; it != end; ++it)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*(*it);
+    for (std::size_t j = 0; j < gdim; ++j)
+    {
+      const double c = b[j] + b[gdim + j];
+      cmin[j] = std::min(cmin[j], c);
+      cmax[j] = std::max(cmax[j], c);
+    }
+  }
 
-  // Store bounding box data. Note that root box will be added last.
-  return add_bbox(bbox, b, gdim);
+  // Find split (axis and bin) with lowest cost A_0*N_0 + A_1*N_1
+  double best_cost = std::numeric_limits<double>::max();
+  std::size_t best_axis = 0, best_bin = 0;
+  for (std::size_t j = 0; j < gdim; ++j)
+  {
+    if (!(cmax[j] > cmin[j]))
+      continue;
+    const double scale = num_bins/(cmax[j] - cmin[j]);
+
+    // Compute number of boxes and bounding box for each bin
+    std::size_t count[num_bins];
+    double bin_bbox[num_bins][MAX_DIM];
+    for (std::size_t k = 0; k < num_bins; ++k)
+    {
+      count[k] = 0;
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        bin_bbox[k][i] = std::numeric_limits<double>::max();
+        bin_bbox[k][gdim + i] = -std::numeric_limits<double>::max();
+      }
+    }
+    for (std::vector<unsigned int>::iterator it = begin; it != end; ++it)
+    {
+      const double* b = leaf_bboxes.data() + 2*gdim*(*it);
+      const std::size_t k
+        = std::min(num_bins - 1,
+                   (std::size_t) (scale*(b[j] + b[gdim + j] - cmin[j])));
+      ++count[k];
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        bin_bbox[k][i] = std::min(bin_bbox[k][i], b[i]);
+        bin_bbox[k][gdim + i] = std::max(bin_bbox[k][gdim + i], b[gdim + i]);
+      }
+    }
+
+    // Sweep from the right, storing cost of right part for each split
+    double right_cost[num_bins];
+    double acc[MAX_DIM];
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      acc[i] = std::numeric_limits<double>::max();
+      acc[gdim + i] = -std::numeric_limits<double>::max();
+    }
+    for (std::size_t k = num_bins - 1; k > 0; --k)
+    {
+      n += count[k];
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        acc[i] = std::min(acc[i], bin_bbox[k][i]);
+        acc[gdim + i] = std::max(acc[gdim + i], bin_bbox[k][gdim + i]);
+      }
+      right_cost[k] = n > 0 ? n*compute_bbox_area(acc, gdim) : 0.0;
+    }
+
+    // Sweep from the left and compute total cost for each split
+    // (split k puts bins [0, k) to the left)
+    n = 0;
+    for (std::size_t i = 0; i < gdim; ++i)
+    {
+      acc[i] = std::numeric_limits<double>::max();
+      acc[gdim + i] = -std::numeric_limits<double>::max();
+    }
+    for (std::size_t k = 1; k < num_bins; ++k)
+    {
+      n += count[k - 1];
+      for (std::size_t i = 0; i < gdim; ++i)
+      {
+        acc[i] = std::min(acc[i], bin_bbox[k - 1][i]);
+        acc[gdim + i] = std::max(acc[gdim + i], bin_bbox[k - 1][gdim + i]);
+      }
+      if (n == 0 || n == (std::size_t) (end - begin))
+        continue;
+      const double cost = n*compute_bbox_area(acc, gdim) + right_cost[k];
+      if (cost < best_cost)
+      {
+        best_cost = cost;
+        best_axis = j;
+        best_bin = k;
+      }
+    }
+  }
+
+  // Fall back to median split if no split was found (all midpoints
+  // coincide)
+  if (best_cost == std::numeric_limits<double>::max())
+  {
+    sort_bboxes(axis, leaf_bboxes, begin, middle, end);
+    return middle;
+  }
+
+  // Partition boxes according to best split
+  const std::size_t j = best_axis;
+  const double scale = num_bins/(cmax[j] - cmin[j]);
+  middle = begin;
+  for (std::vector<unsigned int>::iterator it = begin; it != end; ++it)
+  {
+    const double* b = leaf_bboxes.data() + 2*gdim*(*it);
+    const std::size_t k
+      = std::min(num_bins - 1,
+                 (std::size_t) (scale*(b[j] + b[gdim + j] - cmin[j])));
+    if (k < best_bin)
+      std::iter_swap(it, middle++);
+  }
+  dolfin_assert(middle != begin && middle != end);
+
+  return middle;
 }
 //-----------------------------------------------------------------------------
 unsigned int
@@ -645,12 +970,24 @@ void GenericBoundingBoxTree::build_point_search_tree(const Mesh& mesh) const
   info("Building point search tree to accelerate distance queries.");
 
   // Create list of midpoints for all cells
-  std::vector<Point> points;
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
-    points.push_back(cell->midpoint());
+  const std::size_t gdim = mesh.geometry().dim();
+  const StridedArray<unsigned int> cells = MeshRange::cells(mesh);
+  const StridedArray<double> x = MeshRange::coordinates(mesh);
+  const std::size_t num_vertices = cells.stride();
+  const int num_cells
+    = MeshRange::entities(mesh, mesh.topology().dim()).end_index();
+  std::vector<Point> points(num_cells);
+  for (int c = 0; c < num_cells; ++c)
+  {
+    const unsigned int* v = cells[c];
+    Point& p = points[c];
+    for (std::size_t i = 0; i < num_vertices; ++i)
+      for (std::size_t j = 0; j < gdim; ++j)
+        p[j] += x[v[i]][j];
+    p /= static_cast<double>(num_vertices);
+  }
 
   // Select implementation
-  const std::size_t gdim = mesh.geometry().dim();
   switch (gdim)
   {
   case 1:
@@ -674,33 +1011,85 @@ void GenericBoundingBoxTree::build_point_search_tree(const Mesh& mesh) const
   _point_search_tree->build(points);
 }
 //-----------------------------------------------------------------------------
+void GenericBoundingBoxTree::compute_refit_levels()
+{
+  // Compute depth of each node. Children are always added before
+  // their parents, so the root is last and a reverse sweep visits
+  // each parent before its children.
+  const unsigned int num_nodes = num_bboxes();
+  std::vector<unsigned int> depth(num_nodes, 0);
+  unsigned int max_depth = 0;
+  for (unsigned int node = num_nodes; node-- > 0; )
+  {
+    const BBox& bbox = _bboxes[node];
+    if (is_leaf(bbox, node))
+      continue;
+    depth[bbox.child_0] = depth[bbox.child_1] = depth[node] + 1;
+    max_depth = std::max(max_depth, depth[node] + 1);
+  }
+
+  // Sort nodes by decreasing depth (counting sort)
+  _refit_levels.assign(max_depth + 2, 0);
+  for (unsigned int node = 0; node < num_nodes; ++node)
+    ++_refit_levels[max_depth - depth[node] + 1];
+  for (unsigned int level = 0; level <= max_depth; ++level)
+    _refit_levels[level + 1] += _refit_levels[level];
+  _refit_nodes.resize(num_nodes);
+  std::vector<unsigned int> position(_refit_levels.begin(),
+                                     _refit_levels.end() - 1);
+  for (unsigned int node = 0; node < num_nodes; ++node)
+    _refit_nodes[position[max_depth - depth[node]]++] = node;
+}
+//-----------------------------------------------------------------------------
+double GenericBoundingBoxTree::compute_bbox_area(const double* b,
+                                                 std::size_t gdim)
+{
+  switch (gdim)
+  {
+  case 1:
+    return b[1] - b[0];
+  case 2:
+    return 2.0*((b[2] - b[0]) + (b[3] - b[1]));
+  case 3:
+    {
+      const double dx = b[3] - b[0];
+      const double dy = b[4] - b[1];
+      const double dz = b[5] - b[2];
+      return 2.0*(dx*dy + dy*dz + dz*dx);
+    }
+  default:
+    dolfin_error("GenericBoundingBoxTree.cpp",
+                 "compute surface area of bounding box",
+                 "Not implemented for geometric dimension %d", gdim);
+  }
+
+  return 0.0;
+}
+//-----------------------------------------------------------------------------
 void GenericBoundingBoxTree::compute_bbox_of_entity(double* b,
-                                                    const MeshEntity& entity,
-                                                    std::size_t gdim) const
+                                                    const unsigned int* vertices,
+                                                    std::size_t num_vertices,
+                                                    const double* x,
+                                                    std::size_t gdim)
 {
   // Get bounding box coordinates
   double* xmin = b;
   double* xmax = b + gdim;
-
-  // Get mesh entity data
-  const MeshGeometry& geometry = entity.mesh().geometry();
-  const size_t num_vertices = entity.num_entities(0);
-  const unsigned int* vertices = entity.entities(0);
   dolfin_assert(num_vertices >= 2);
 
   // Get coordinates for first vertex
-  const double* x = geometry.x(vertices[0]);
+  const double* x0 = x + vertices[0]*gdim;
   for (std::size_t j = 0; j < gdim; ++j)
-    xmin[j] = xmax[j] = x[j];
+    xmin[j] = xmax[j] = x0[j];
 
   // Compute min and max over remaining vertices
   for (unsigned int i = 1; i < num_vertices; ++i)
   {
-    const double* x = geometry.x(vertices[i]);
+    const double* xi = x + vertices[i]*gdim;
     for (std::size_t j = 0; j < gdim; ++j)
     {
-      xmin[j] = std::min(xmin[j], x[j]);
-      xmax[j] = std::max(xmax[j], x[j]);
+      xmin[j] = std::min(xmin[j], xi[j]);
+      xmax[j] = std::max(xmax[j], xi[j]);
     }
   }
 }
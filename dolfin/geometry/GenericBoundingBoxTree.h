@@ -16,11 +16,12 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-04-23
-// Last changed: 2014-02-06
+// Last changed: 2026-10-19
 
 #ifndef __GENERIC_BOUNDING_BOX_TREE_H
 #define __GENERIC_BOUNDING_BOX_TREE_H
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <vector>
@@ -52,6 +53,16 @@ namespace dolfin
     /// Build bounding box tree for point cloud
     void build(const std::vector<Point>& points);
 
+    /// Recompute bounding boxes for mesh entities bottom-up after
+    /// the mesh has moved, keeping the tree structure (the topology
+    /// must be unchanged). The tree is rebuilt if its SAH cost has
+    /// grown past max_cost_ratio times the cost when built. Returns
+    /// true if the tree was rebuilt.
+    bool refit(const Mesh& mesh, double max_cost_ratio);
+
+    /// Compute surface area heuristic (SAH) cost of tree
+    double compute_sah_cost() const;
+
     /// Compute all collisions between bounding boxes and _Point_
     std::vector<unsigned int>
     compute_collisions(const Point& point) const;
@@ -107,16 +118,52 @@ namespace dolfin
     // Point search tree used to accelerate distance queries
     mutable std::unique_ptr<GenericBoundingBoxTree> _point_search_tree;
 
+    // SAH cost of tree when built
+    double _built_cost;
+
+    // Nodes sorted by decreasing depth, and offsets into this list
+    // for each level (computed on first refit)
+    std::vector<unsigned int> _refit_nodes;
+    std::vector<unsigned int> _refit_levels;
+
     // Clear existing data if any
     void clear();
 
     //--- Recursive build functions ---
 
-    // Build bounding box tree for entities (recursive)
+    // Range of leaves and position of a subtree to be built
+    struct SubTree
+    {
+      unsigned int begin;
+      unsigned int end;
+      unsigned int offset;
+    };
+
+    // Build bounding box tree for entities (recursive). The subtree
+    // for the leaves in [begin, end) is stored in post-order at the
+    // 2*(end - begin) - 1 nodes starting at offset, so subtrees may
+    // be built in parallel. Subtrees with at most grain leaves are
+    // added to subtrees (if not null) instead of being built. Returns
+    // the root node of the subtree.
     unsigned int _build(const std::vector<double>& leaf_bboxes,
                         const std::vector<unsigned int>::iterator& begin,
                         const std::vector<unsigned int>::iterator& end,
-                        std::size_t gdim);
+                        const std::vector<unsigned int>::iterator& first,
+                        unsigned int offset,
+                        std::size_t gdim,
+                        std::size_t grain,
+                        std::vector<SubTree>* subtrees);
+
+    // Split leaf bounding boxes in [begin, end) into two groups using
+    // the surface area heuristic (SAH), evaluated for a number of
+    // bins of the box midpoints along each axis. Falls back to a
+    // median split along the longest axis. Returns the split point.
+    std::vector<unsigned int>::iterator
+    split_bboxes(const std::vector<double>& leaf_bboxes,
+                 const std::vector<unsigned int>::iterator& begin,
+                 const std::vector<unsigned int>::iterator& end,
+                 std::size_t axis,
+                 std::size_t gdim);
 
     // Build bounding box tree for points (recursive)
     unsigned int _build(const std::vector<Point>& points,
@@ -182,10 +229,20 @@ namespace dolfin
     // Compute point search tree if not already done
     void build_point_search_tree(const Mesh& mesh) const;
 
-    // Compute bounding box of mesh entity
-    void compute_bbox_of_entity(double* b,
-                                const MeshEntity& entity,
-                                std::size_t gdim) const;
+    // Compute levels of nodes used for refitting
+    void compute_refit_levels();
+
+    // Compute surface area of bounding box (length in 1D and
+    // perimeter in 2D)
+    static double compute_bbox_area(const double* b, std::size_t gdim);
+
+    // Compute bounding box of mesh entity with given vertices, from
+    // the coordinate array x (stride gdim)
+    static void compute_bbox_of_entity(double* b,
+                                       const unsigned int* vertices,
+                                       std::size_t num_vertices,
+                                       const double* x,
+                                       std::size_t gdim);
 
     // Sort points along given axis
     void sort_points(std::size_t axis,
@@ -209,6 +266,16 @@ namespace dolfin
       return _bboxes.size() - 1;
     }
 
+    // Set bounding box and coordinates for given (allocated) node
+    inline void set_bbox(unsigned int node,
+                         const BBox& bbox,
+                         const double* b,
+                         std::size_t gdim)
+    {
+      _bboxes[node] = bbox;
+      std::copy(b, b + 2*gdim, _bbox_coordinates.begin() + 2*gdim*node);
+    }
+
     // Return bounding box for given node
     inline const BBox& get_bbox(unsigned int node) const
     {
@@ -0,0 +1,185 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __CSR_GRAPH_H
+#define __CSR_GRAPH_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <dolfin/log/log.h>
+#include "Graph.h"
+
+namespace dolfin
+{
+
+  /// This class provides a compressed sparse row (CSR) graph. The
+  /// neighbours of vertex i are stored contiguously in
+  /// adjacency()[offsets()[i]] ... adjacency()[offsets()[i + 1] - 1].
+  /// Compared to Graph, which holds one heap-allocated set per
+  /// vertex, the whole graph lives in two arrays.
+
+  template<typename T>
+  class CSRGraph
+  {
+  public:
+
+    /// Create empty graph
+    CSRGraph() : _offsets(1, 0) {}
+
+    /// Create graph from offsets and adjacency arrays. The arrays are
+    /// swapped into the graph and are empty on return. Vertex indices
+    /// in adjacency may be global (e.g. for a distributed graph).
+    CSRGraph(std::vector<T>& offsets, std::vector<T>& adjacency)
+    {
+      dolfin_assert(!offsets.empty());
+      dolfin_assert((std::size_t) offsets.back() == adjacency.size());
+      _offsets.swap(offsets);
+      _adjacency.swap(adjacency);
+      offsets.clear();
+      adjacency.clear();
+    }
+
+    /// Create graph from a Graph (vector of sets)
+    explicit CSRGraph(const Graph& graph) : _offsets(graph.size() + 1, 0)
+    {
+      for (std::size_t i = 0; i < graph.size(); ++i)
+        _offsets[i + 1] = _offsets[i] + graph[i].size();
+      _adjacency.reserve(_offsets.back());
+      for (std::size_t i = 0; i < graph.size(); ++i)
+        _adjacency.insert(_adjacency.end(), graph[i].begin(), graph[i].end());
+    }
+
+    /// Destructor
+    ~CSRGraph() {}
+
+    /// Return number of vertices
+    std::size_t num_vertices() const
+    { return _offsets.size() - 1; }
+
+    /// Return number of (directed) edges
+    std::size_t num_edges() const
+    { return _adjacency.size(); }
+
+    /// Return number of neighbours of vertex i
+    std::size_t degree(std::size_t i) const
+    {
+      dolfin_assert(i + 1 < _offsets.size());
+      return _offsets[i + 1] - _offsets[i];
+    }
+
+    /// Return pointer to first neighbour of vertex i
+    const T* begin(std::size_t i) const
+    {
+      dolfin_assert(i + 1 < _offsets.size());
+      return _adjacency.data() + _offsets[i];
+    }
+
+    /// Return pointer to one past the last neighbour of vertex i
+    const T* end(std::size_t i) const
+    {
+      dolfin_assert(i + 1 < _offsets.size());
+      return _adjacency.data() + _offsets[i + 1];
+    }
+
+    /// Return offsets array (size num_vertices() + 1)
+    const std::vector<T>& offsets() const
+    { return _offsets; }
+
+    /// Return adjacency array (size num_edges())
+    const std::vector<T>& adjacency() const
+    { return _adjacency; }
+
+    /// Return vertex weights (empty if graph is unweighted)
+    const std::vector<T>& vertex_weights() const
+    { return _vertex_weights; }
+
+    /// Return edge weights, aligned with adjacency() (empty if graph
+    /// is unweighted)
+    const std::vector<T>& edge_weights() const
+    { return _edge_weights; }
+
+    /// Set vertex weights. The array is swapped into the graph and is
+    /// empty on return.
+    void set_vertex_weights(std::vector<T>& weights)
+    {
+      dolfin_assert(weights.empty() || weights.size() == num_vertices());
+      _vertex_weights.swap(weights);
+      weights.clear();
+    }
+
+    /// Set edge weights. The array is swapped into the graph and is
+    /// empty on return.
+    void set_edge_weights(std::vector<T>& weights)
+    {
+      dolfin_assert(weights.empty() || weights.size() == num_edges());
+      _edge_weights.swap(weights);
+      weights.clear();
+    }
+
+    /// Compute transpose graph. Vertex j of the transpose has
+    /// neighbours {i : j in neighbours(i)}, with num_columns vertices
+    /// in total. Neighbour lists of the transpose are sorted.
+    CSRGraph<T> transpose(std::size_t num_columns) const
+    {
+      std::vector<T> offsets(num_columns + 1, 0);
+      for (std::size_t k = 0; k < _adjacency.size(); ++k)
+      {
+        dolfin_assert((std::size_t) _adjacency[k] < num_columns);
+        ++offsets[_adjacency[k] + 1];
+      }
+      for (std::size_t j = 0; j < num_columns; ++j)
+        offsets[j + 1] += offsets[j];
+
+      std::vector<T> adjacency(_adjacency.size());
+      std::vector<T> position(offsets.begin(), offsets.end() - 1);
+      for (std::size_t i = 0; i < num_vertices(); ++i)
+        for (T k = _offsets[i]; k < _offsets[i + 1]; ++k)
+          adjacency[position[_adjacency[k]]++] = i;
+
+      return CSRGraph<T>(offsets, adjacency);
+    }
+
+    /// Swap contents with another graph
+    void swap(CSRGraph<T>& graph)
+    {
+      _offsets.swap(graph._offsets);
+      _adjacency.swap(graph._adjacency);
+      _vertex_weights.swap(graph._vertex_weights);
+      _edge_weights.swap(graph._edge_weights);
+    }
+
+  private:
+
+    // Position of first neighbour for each vertex
+    std::vector<T> _offsets;
+
+    // Neighbours of all vertices stored as a contiguous array
+    std::vector<T> _adjacency;
+
+    // Optional vertex and edge weights
+    std::vector<T> _vertex_weights;
+    std::vector<T> _edge_weights;
+
+  };
+
+}
+
+#endif
@@ -18,9 +18,10 @@
 // Modified by Chris Richardson, 2012
 //
 // First added:  2010-02-19
-// Last changed: 2013-01-31
+// Last changed: 2026-10-19
 
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <set>
 #include <utility>
@@ -28,6 +29,10 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <dolfin/log/log.h>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
@@ -37,6 +42,7 @@
 #include <dolfin/mesh/LocalMeshData.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "GraphBuilder.h"
 
 using namespace dolfin;
@@ -151,6 +157,112 @@ Graph GraphBuilder::local_graph(const Mesh& mesh,
   return graph;
 }
 //-----------------------------------------------------------------------------
+CSRGraph<int> GraphBuilder::local_csr_graph(const Mesh& mesh,
+                                      const std::vector<std::size_t>& path)
+{
+  Timer timer("Build local CSR graph");
+
+  dolfin_assert(path.size() >= 2);
+
+  // Initialise mesh
+  for (std::size_t i = 0; i < path.size(); ++i)
+    mesh.init(path[i]);
+  for (std::size_t i = 1; i < path.size(); ++i)
+    mesh.init(path[i - 1], path[i]);
+
+  // Get connectivities along path
+  std::vector<const MeshConnectivity*> connectivity;
+  for (std::size_t i = 1; i < path.size(); ++i)
+    connectivity.push_back(&mesh.topology()(path[i - 1], path[i]));
+
+  // Exclude self-connections when start and end dimension coincide
+  const bool exclude_self = (path.front() == path.back());
+
+  // Number of graph vertices
+  const std::size_t num_vertices = mesh.num_entities(path[0]);
+
+  // Number of threads
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+
+  // Degree of each vertex (stored shifted by one, to become offsets)
+  std::vector<int> offsets(num_vertices + 1, 0);
+
+  // Each thread builds the adjacency for a contiguous block of
+  // vertices, so blocks can be concatenated in thread order
+  std::vector<std::vector<int> > block_adjacency;
+
+  #ifdef HAS_OPENMP
+  #pragma omp parallel num_threads(num_threads)
+  #endif
+  {
+    #ifdef HAS_OPENMP
+    const std::size_t thread = omp_get_thread_num();
+    const std::size_t nthreads = omp_get_num_threads();
+    #else
+    const std::size_t thread = 0;
+    const std::size_t nthreads = 1;
+    #endif
+
+    #ifdef HAS_OPENMP
+    #pragma omp single
+    #endif
+    block_adjacency.resize(nthreads);
+
+    const std::size_t v0 = thread*num_vertices/nthreads;
+    const std::size_t v1 = (thread + 1)*num_vertices/nthreads;
+
+    std::vector<unsigned int> entities0, entities1;
+    std::vector<int>& adjacency = block_adjacency[thread];
+    for (std::size_t v = v0; v < v1; ++v)
+    {
+      // Walk along path, keeping sorted list of unique entities
+      entities0.assign(1, v);
+      for (std::size_t level = 0; level < connectivity.size(); ++level)
+      {
+        const MeshConnectivity& c = *connectivity[level];
+        entities1.clear();
+        for (std::size_t i = 0; i < entities0.size(); ++i)
+        {
+          const unsigned int* e = c(entities0[i]);
+          entities1.insert(entities1.end(), e, e + c.size(entities0[i]));
+        }
+        std::sort(entities1.begin(), entities1.end());
+        entities1.erase(std::unique(entities1.begin(), entities1.end()),
+                        entities1.end());
+        entities0.swap(entities1);
+      }
+
+      // Add edges
+      std::size_t degree = 0;
+      for (std::size_t i = 0; i < entities0.size(); ++i)
+      {
+        if (!exclude_self || entities0[i] != v)
+        {
+          adjacency.push_back(entities0[i]);
+          ++degree;
+        }
+      }
+      offsets[v + 1] = degree;
+    }
+  }
+
+  // Compute offsets and concatenate blocks
+  for (std::size_t v = 0; v < num_vertices; ++v)
+    offsets[v + 1] += offsets[v];
+  std::vector<int> adjacency;
+  adjacency.reserve(offsets.back());
+  for (std::size_t i = 0; i < block_adjacency.size(); ++i)
+  {
+    adjacency.insert(adjacency.end(), block_adjacency[i].begin(),
+                     block_adjacency[i].end());
+    std::vector<int>().swap(block_adjacency[i]);
+  }
+
+  return CSRGraph<int>(offsets, adjacency);
+}
+//-----------------------------------------------------------------------------
 void GraphBuilder::compute_dual_graph(const MPI_Comm mpi_comm,
                                       const LocalMeshData& mesh_data,
                             std::vector<std::set<std::size_t> >& local_graph,
@@ -247,20 +359,50 @@ void GraphBuilder::compute_nonlocal_dual_graph(const MPI_Comm mpi_comm,
                             FacetCellMap& facet_cell_map,
                             std::set<std::size_t>& ghost_vertices)
 {
-  Timer timer("Compute non-local dual graph");
-
   // At this stage facet_cell map only contains facets->cells with
   // edge facets either interprocess or external boundaries
 
-  // List of cell vertices
-  const boost::multi_array<std::size_t, 2>& cell_vertices
-    = mesh_data.cell_vertices;
-  const std::size_t num_local_cells = mesh_data.global_cell_indices.size();
-  const std::size_t num_vertices_per_cell = mesh_data.num_vertices_per_cell;
-  const std::size_t num_vertices_per_facet = num_vertices_per_cell - 1;
+  const std::size_t num_vertices_per_facet
+    = mesh_data.num_vertices_per_cell - 1;
 
-  dolfin_assert(num_local_cells == cell_vertices.shape()[0]);
-  dolfin_assert(num_vertices_per_cell == cell_vertices.shape()[1]);
+  // Flatten facet-cell map
+  std::vector<std::size_t> boundary_facets;
+  boundary_facets.reserve(facet_cell_map.size()*(num_vertices_per_facet + 1));
+  FacetCellMap::const_iterator it;
+  for (it = facet_cell_map.begin(); it != facet_cell_map.end(); ++it)
+  {
+    boundary_facets.insert(boundary_facets.end(), it->first.begin(),
+                           it->first.end());
+    boundary_facets.push_back(it->second);
+  }
+
+  // Match facets across processes
+  std::vector<std::size_t> remote_edges;
+  compute_nonlocal_dual_graph(mpi_comm, mesh_data, boundary_facets,
+                              remote_edges);
+
+  // Clear ghost vertices
+  ghost_vertices.clear();
+
+  // Insert connected cells into local map
+  for (std::size_t i = 0; i < remote_edges.size(); i += 2)
+  {
+    dolfin_assert(remote_edges[i] < local_graph.size());
+    local_graph[remote_edges[i]].insert(remote_edges[i + 1]);
+    ghost_vertices.insert(remote_edges[i + 1]);
+  }
+}
+//-----------------------------------------------------------------------------
+void GraphBuilder::compute_nonlocal_dual_graph(const MPI_Comm mpi_comm,
+                                               const LocalMeshData& mesh_data,
+                             const std::vector<std::size_t>& boundary_facets,
+                                        std::vector<std::size_t>& remote_edges)
+{
+  Timer timer("Compute non-local dual graph");
+
+  const std::size_t num_local_cells = mesh_data.global_cell_indices.size();
+  const std::size_t num_vertices_per_facet
+    = mesh_data.num_vertices_per_cell - 1;
 
   // Compute local edges (cell-cell connections) using global
   // (internal to this function, not the user numbering) numbering
@@ -274,24 +416,25 @@ void GraphBuilder::compute_nonlocal_dual_graph(const MPI_Comm mpi_comm,
   std::vector<std::vector<std::size_t> > send_buffer(num_processes);
   std::vector<std::vector<std::size_t> > received_buffer(num_processes);
 
-  // Pack map data and send to match-maker process
-  boost::unordered_map<std::vector<std::size_t>,
-                     std::size_t>::const_iterator it;
-  for (it = facet_cell_map.begin(); it != facet_cell_map.end(); ++it)
+  // Pack facet data and send to match-maker process
+  for (std::size_t f = 0; f < boundary_facets.size();
+       f += (num_vertices_per_facet + 1))
   {
     // FIXME: Could use a better index? First vertex is slightly skewed
     //        towards low values - may not be important
 
     // Use first vertex of facet to partition into blocks
-    std::size_t dest_proc = MPI::index_owner(mpi_comm, (it->first)[0],
-                                             mesh_data.num_global_vertices);
+    const std::size_t dest_proc
+      = MPI::index_owner(mpi_comm, boundary_facets[f],
+                         mesh_data.num_global_vertices);
 
-    // Pack map into vectors to send
+    // Pack facet vertices into vectors to send
     for (std::size_t i = 0; i < num_vertices_per_facet; ++i)
-      send_buffer[dest_proc].push_back((it->first)[i]);
+      send_buffer[dest_proc].push_back(boundary_facets[f + i]);
 
     // Add offset to cell numbers sent off process
-    send_buffer[dest_proc].push_back(it->second + offset);
+    send_buffer[dest_proc].push_back(boundary_facets[f + num_vertices_per_facet]
+                                     + offset);
   }
 
   // Send data
@@ -348,21 +491,242 @@ void GraphBuilder::compute_nonlocal_dual_graph(const MPI_Comm mpi_comm,
   // Send matches to other processes
   MPI::all_to_all(mpi_comm, send_buffer, received_buffer);
 
-  // Clear ghost vertices
-  ghost_vertices.clear();
-
-  // Flatten received data and insert connected cells into local map
+  // Flatten received data, converting to local cell index
+  remote_edges.clear();
   for (std::size_t p = 0; p < received_buffer.size(); ++p)
   {
     const std::vector<std::size_t>& cell_list = received_buffer[p];
     for (std::size_t i = 0; i < cell_list.size(); i += 2)
     {
       dolfin_assert(cell_list[i] >= offset);
-      dolfin_assert(cell_list[i] - offset < local_graph.size());
+      dolfin_assert(cell_list[i] - offset < num_local_cells);
+      remote_edges.push_back(cell_list[i] - offset);
+      remote_edges.push_back(cell_list[i + 1]);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void GraphBuilder::compute_local_dual_graph(const LocalMeshData& mesh_data,
+                                 std::vector<std::size_t>& facet_neighbours)
+{
+  Timer timer("Compute local dual graph (CSR)");
+
+  // List of cell vertices
+  const boost::multi_array<std::size_t, 2>& cell_vertices
+    = mesh_data.cell_vertices;
+  const std::size_t num_local_cells = mesh_data.global_cell_indices.size();
+  const std::size_t num_vertices_per_cell = mesh_data.num_vertices_per_cell;
+  const std::size_t num_vertices_per_facet = num_vertices_per_cell - 1;
+
+  dolfin_assert(num_local_cells == cell_vertices.shape()[0]);
+  dolfin_assert(num_vertices_per_cell == cell_vertices.shape()[1]);
+
+  const std::size_t* cv = cell_vertices.data();
+  const std::size_t num_entries = num_local_cells*num_vertices_per_cell;
+
+  // Number vertices locally (sorted global indices)
+  std::vector<std::size_t> vertices(cv, cv + num_entries);
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+  std::vector<std::size_t>(vertices).swap(vertices);
+
+  // Number of threads
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+
+  // Cell vertices in local numbering
+  std::vector<unsigned int> local_cell_vertices(num_entries);
+  const std::int64_t _num_entries = num_entries;
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (std::int64_t i = 0; i < _num_entries; ++i)
+  {
+    local_cell_vertices[i]
+      = std::lower_bound(vertices.begin(), vertices.end(), cv[i])
+      - vertices.begin();
+  }
+
+  // Build vertex-to-cell incidence in CSR format
+  const std::size_t num_vertices = vertices.size();
+  std::vector<std::size_t>().swap(vertices);
+  std::vector<std::size_t> vertex_offsets(num_vertices + 1, 0);
+  for (std::size_t i = 0; i < num_entries; ++i)
+    ++vertex_offsets[local_cell_vertices[i] + 1];
+  for (std::size_t v = 0; v < num_vertices; ++v)
+    vertex_offsets[v + 1] += vertex_offsets[v];
+  std::vector<unsigned int> vertex_cells(num_entries);
+  {
+    std::vector<std::size_t> position(vertex_offsets.begin(),
+                                      vertex_offsets.end() - 1);
+    for (std::size_t i = 0; i < num_entries; ++i)
+    {
+      vertex_cells[position[local_cell_vertices[i]]++]
+        = i/num_vertices_per_cell;
+    }
+  }
+
+  // Two cells are neighbours across a facet if they share
+  // num_vertices_per_facet vertices. Cells sharing a vertex with
+  // cell c are found through the vertex-to-cell incidence.
+  facet_neighbours.assign(num_entries, num_local_cells);
+  const std::int64_t _num_local_cells = num_local_cells;
+  #ifdef HAS_OPENMP
+  #pragma omp parallel num_threads(num_threads)
+  #endif
+  {
+    std::vector<unsigned int> candidates;
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(guided, 256)
+    #endif
+    for (std::int64_t c = 0; c < _num_local_cells; ++c)
+    {
+      const unsigned int* vc = &local_cell_vertices[c*num_vertices_per_cell];
+
+      // Collect cells sharing a vertex with c (with multiplicity)
+      candidates.clear();
+      for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+      {
+        candidates.insert(candidates.end(),
+                          vertex_cells.data() + vertex_offsets[vc[j]],
+                          vertex_cells.data() + vertex_offsets[vc[j] + 1]);
+      }
+      std::sort(candidates.begin(), candidates.end());
+
+      // Find cells sharing a facet
+      std::vector<unsigned int>::iterator run = candidates.begin();
+      while (run != candidates.end())
+      {
+        const std::vector<unsigned int>::iterator next
+          = std::upper_bound(run, candidates.end(), *run);
+        const unsigned int d = *run;
+        if ((std::int64_t) d != c
+            && (std::size_t) (next - run) == num_vertices_per_facet)
+        {
+          // Facet of c shared with d is opposite the vertex of c not
+          // in d
+          const unsigned int* vd = &local_cell_vertices[d*num_vertices_per_cell];
+          for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+          {
+            if (std::find(vd, vd + num_vertices_per_cell, vc[j])
+                == vd + num_vertices_per_cell)
+            {
+              facet_neighbours[c*num_vertices_per_cell + j] = d;
+              break;
+            }
+          }
+        }
+        run = next;
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template<typename T>
+std::size_t GraphBuilder::compute_dual_graph(const MPI_Comm mpi_comm,
+                                             const LocalMeshData& mesh_data,
+                                             CSRGraph<T>& local_graph)
+{
+  Timer timer("Compute dual graph (CSR)");
+
+  const boost::multi_array<std::size_t, 2>& cell_vertices
+    = mesh_data.cell_vertices;
+  const std::size_t num_local_cells = mesh_data.global_cell_indices.size();
+  const std::size_t num_vertices_per_cell = mesh_data.num_vertices_per_cell;
+  const std::size_t num_vertices_per_facet = num_vertices_per_cell - 1;
+
+  // Get offset for this process
+  const std::size_t cell_offset = MPI::global_offset(mpi_comm,
+                                                     num_local_cells, true);
+
+  // Compute local neighbour across each facet
+  std::vector<std::size_t> facet_neighbours;
+  compute_local_dual_graph(mesh_data, facet_neighbours);
+
+  // Collect facets without a local neighbour (sorted global vertex
+  // indices followed by the local cell index)
+  std::vector<std::size_t> boundary_facets;
+  std::vector<std::size_t> facet(num_vertices_per_facet);
+  for (std::size_t c = 0; c < num_local_cells; ++c)
+  {
+    for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+    {
+      if (facet_neighbours[c*num_vertices_per_cell + j] != num_local_cells)
+        continue;
+      for (std::size_t k = 0, m = 0; k < num_vertices_per_cell; ++k)
+        if (k != j)
+          facet[m++] = cell_vertices[c][k];
+      std::sort(facet.begin(), facet.end());
+      boundary_facets.insert(boundary_facets.end(), facet.begin(),
+                             facet.end());
+      boundary_facets.push_back(c);
+    }
+  }
+
+  // Match facets across processes
+  std::vector<std::size_t> remote_edges;
+  #ifdef HAS_MPI
+  compute_nonlocal_dual_graph(mpi_comm, mesh_data, boundary_facets,
+                              remote_edges);
+  #endif
+  std::vector<std::size_t>().swap(boundary_facets);
 
-      local_graph[cell_list[i] - offset].insert(cell_list[i + 1]);
-      ghost_vertices.insert(cell_list[i + 1]);
+  // Count neighbours of each cell
+  std::vector<T> offsets(num_local_cells + 1, 0);
+  for (std::size_t c = 0; c < num_local_cells; ++c)
+  {
+    for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+      if (facet_neighbours[c*num_vertices_per_cell + j] != num_local_cells)
+        ++offsets[c + 1];
+  }
+  for (std::size_t i = 0; i < remote_edges.size(); i += 2)
+    ++offsets[remote_edges[i] + 1];
+  for (std::size_t c = 0; c < num_local_cells; ++c)
+    offsets[c + 1] += offsets[c];
+
+  // Fill adjacency (global numbering)
+  std::vector<T> adjacency(offsets.back());
+  std::vector<T> position(offsets.begin(), offsets.end() - 1);
+  for (std::size_t c = 0; c < num_local_cells; ++c)
+  {
+    for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+    {
+      const std::size_t d = facet_neighbours[c*num_vertices_per_cell + j];
+      if (d != num_local_cells)
+        adjacency[position[c]++] = d + cell_offset;
     }
   }
+  std::vector<std::size_t>().swap(facet_neighbours);
+
+  std::vector<std::size_t> ghost_vertices;
+  ghost_vertices.reserve(remote_edges.size()/2);
+  for (std::size_t i = 0; i < remote_edges.size(); i += 2)
+  {
+    adjacency[position[remote_edges[i]]++] = remote_edges[i + 1];
+    ghost_vertices.push_back(remote_edges[i + 1]);
+  }
+  std::sort(ghost_vertices.begin(), ghost_vertices.end());
+  const std::size_t num_ghost_vertices
+    = std::unique(ghost_vertices.begin(), ghost_vertices.end())
+    - ghost_vertices.begin();
+
+  CSRGraph<T> graph(offsets, adjacency);
+  local_graph.swap(graph);
+
+  return num_ghost_vertices;
 }
 //-----------------------------------------------------------------------------
+// Explicit instantiation for the index types used by graph
+// partitioners
+template std::size_t
+GraphBuilder::compute_dual_graph(const MPI_Comm, const LocalMeshData&,
+                                 CSRGraph<int>&);
+template std::size_t
+GraphBuilder::compute_dual_graph(const MPI_Comm, const LocalMeshData&,
+                                 CSRGraph<long>&);
+template std::size_t
+GraphBuilder::compute_dual_graph(const MPI_Comm, const LocalMeshData&,
+                                 CSRGraph<long long>&);
+//-----------------------------------------------------------------------------
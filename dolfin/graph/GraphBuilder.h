@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-02-19
-// Last changed: 2013-01-16
+// Last changed: 2026-10-19
 
 #ifndef __GRAPH_BUILDER_H
 #define __GRAPH_BUILDER_H
@@ -26,6 +26,7 @@
 #include <vector>
 #include <boost/multi_array.hpp>
 #include <dolfin/common/MPI.h>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -55,6 +56,15 @@ namespace dolfin
     static Graph local_graph(const Mesh& mesh, std::size_t dim0,
                                                std::size_t dim1);
 
+    /// Build local CSR graph from mesh. The path of topological
+    /// dimensions [d0, d1, ..., dn] connects two entities of dimension
+    /// d0 and dn if they can be reached by walking through the
+    /// incidence relations of the path. If d0 == dn, an entity is not
+    /// connected to itself. The graph is built in parallel using
+    /// parameters["num_threads"] threads.
+    static CSRGraph<int> local_csr_graph(const Mesh& mesh,
+                                         const std::vector<std::size_t>& path);
+
     /// Build distributed dual graph (cell-cell connections) for from
     /// LocalMeshData
     static void
@@ -63,6 +73,18 @@ namespace dolfin
                          std::vector<std::set<std::size_t> >& local_graph,
                          std::set<std::size_t>& ghost_vertices);
 
+    /// Build distributed dual graph (cell-cell connections across
+    /// facets) from LocalMeshData as a CSR graph, using global
+    /// (process offset) numbering of graph vertices. The local part
+    /// is built in parallel from vertex-cell incidence, without
+    /// per-cell sets. Returns the number of distinct off-process
+    /// (ghost) vertices. T is the index type of the graph partitioner
+    /// (int, long or long long).
+    template<typename T>
+    static std::size_t compute_dual_graph(const MPI_Comm mpi_comm,
+                                          const LocalMeshData& mesh_data,
+                                          CSRGraph<T>& local_graph);
+
   private:
 
     friend class MeshPartitioning;
@@ -86,6 +108,24 @@ namespace dolfin
                                   FacetCellMap& facet_cell_map,
                                   std::set<std::size_t>& ghost_vertices);
 
+    // Compute the neighbouring local cell across each facet (facet j
+    // of a cell is opposite its vertex j). Entries are set to
+    // num_local_cells for facets without a local neighbour.
+    static void
+      compute_local_dual_graph(const LocalMeshData& mesh_data,
+                               std::vector<std::size_t>& facet_neighbours);
+
+    // Match facets without a local neighbour across processes. The
+    // array boundary_facets contains for each facet the sorted
+    // (global) facet vertex indices followed by the local cell index.
+    // On return, remote_edges holds pairs (local cell, global index
+    // of neighbouring cell on another process).
+    static void
+      compute_nonlocal_dual_graph(const MPI_Comm mpi_comm,
+                                  const LocalMeshData& mesh_data,
+                             const std::vector<std::size_t>& boundary_facets,
+                                  std::vector<std::size_t>& remote_edges);
+
   };
 
 }
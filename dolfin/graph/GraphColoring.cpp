@@ -19,13 +19,20 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2011-02-21
-// Last changed: 2011-05-11
+// Last changed: 2026-10-19
 
 // Included here to avoid a C++ problem with some MPI implementations
 #include <dolfin/common/MPI.h>
 
+#include <algorithm>
 #include <string>
+
+#ifdef HAS_OPENMP
+#include <omp.h>
+#endif
+
 #include <dolfin/common/Array.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/log/log.h>
 #include <dolfin/parameter/GlobalParameters.h>
 #include "BoostGraphColoring.h"
@@ -35,6 +42,90 @@
 
 using namespace dolfin;
 
+// Neighbour loops for distance-1 coloring of a CSR graph
+struct Distance1Neighbours
+{
+  Distance1Neighbours(const CSRGraph<int>& graph) : graph(graph) {}
+
+  // Mark colors of neighbours of v as forbidden (tagged with v). Colors
+  // of neighbours may be written concurrently by other threads.
+  void mark(int v, const int* colors, std::vector<int>& forbidden) const
+  {
+    for (const int* w = graph.begin(v); w != graph.end(v); ++w)
+    {
+      if (*w == v)
+        continue;
+      int c;
+      #ifdef HAS_OPENMP
+      #pragma omp atomic read
+      #endif
+      c = colors[*w];
+      if (c >= 0)
+      {
+        if ((std::size_t) c >= forbidden.size())
+          forbidden.resize(2*c + 1, -1);
+        forbidden[c] = v;
+      }
+    }
+  }
+
+  // Check whether v has a lower-numbered neighbour of the same color
+  bool conflict(int v, const int* colors) const
+  {
+    for (const int* w = graph.begin(v); w != graph.end(v); ++w)
+      if (*w < v && colors[*w] == colors[v])
+        return true;
+    return false;
+  }
+
+  const CSRGraph<int>& graph;
+};
+
+// Neighbour loops for partial distance-2 coloring of the rows of a
+// bipartite graph, using the transpose graph to get from columns back
+// to rows
+struct Distance2Neighbours
+{
+  Distance2Neighbours(const CSRGraph<int>& graph,
+                      const CSRGraph<int>& transpose)
+    : graph(graph), transpose(transpose) {}
+
+  void mark(int v, const int* colors, std::vector<int>& forbidden) const
+  {
+    for (const int* x = graph.begin(v); x != graph.end(v); ++x)
+    {
+      for (const int* w = transpose.begin(*x); w != transpose.end(*x); ++w)
+      {
+        if (*w == v)
+          continue;
+        int c;
+        #ifdef HAS_OPENMP
+        #pragma omp atomic read
+        #endif
+        c = colors[*w];
+        if (c >= 0)
+        {
+          if ((std::size_t) c >= forbidden.size())
+            forbidden.resize(2*c + 1, -1);
+          forbidden[c] = v;
+        }
+      }
+    }
+  }
+
+  bool conflict(int v, const int* colors) const
+  {
+    for (const int* x = graph.begin(v); x != graph.end(v); ++x)
+      for (const int* w = transpose.begin(*x); w != transpose.end(*x); ++w)
+        if (*w < v && colors[*w] == colors[v])
+          return true;
+    return false;
+  }
+
+  const CSRGraph<int>& graph;
+  const CSRGraph<int>& transpose;
+};
+
 //-----------------------------------------------------------------------------
 std::size_t GraphColoring::compute_local_vertex_coloring(const Graph& graph,
                                               std::vector<std::size_t>& colors)
@@ -45,14 +136,172 @@ std::size_t GraphColoring::compute_local_vertex_coloring(const Graph& graph,
   // Color mesh
   if (colorer == "Boost")
     return BoostGraphColoring::compute_local_vertex_coloring(graph, colors);
+  else if (colorer == "greedy")
+  {
+    const CSRGraph<int> csr_graph(graph);
+    const bool balanced = parameters["balanced_graph_coloring"];
+    return compute_local_vertex_coloring(csr_graph, colors, balanced);
+  }
   else if (colorer == "Zoltan")
     return ZoltanInterface::compute_local_vertex_coloring(graph, colors);
   else
   {
     dolfin_error("GraphColoring.cpp",
                  "compute mesh coloring",
-                 "Unknown coloring type. Known types are \"Boost\" and \"Zoltan\"");
+                 "Unknown coloring type. Known types are \"Boost\", \"greedy\" and \"Zoltan\"");
     return 0;
   }
 }
-//----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+std::size_t
+GraphColoring::compute_local_vertex_coloring(const CSRGraph<int>& graph,
+                                             std::vector<std::size_t>& colors,
+                                             bool balanced)
+{
+  Timer timer("Speculative greedy graph coloring");
+  const Distance1Neighbours neighbours(graph);
+  return speculative_coloring(neighbours, graph.num_vertices(), colors,
+                              balanced);
+}
+//-----------------------------------------------------------------------------
+std::size_t
+GraphColoring::compute_local_distance2_coloring(const CSRGraph<int>& graph,
+                                                std::size_t num_columns,
+                                             std::vector<std::size_t>& colors,
+                                                bool balanced)
+{
+  Timer timer("Speculative greedy distance-2 graph coloring");
+  const CSRGraph<int> transpose = graph.transpose(num_columns);
+  const Distance2Neighbours neighbours(graph, transpose);
+  return speculative_coloring(neighbours, graph.num_vertices(), colors,
+                              balanced);
+}
+//-----------------------------------------------------------------------------
+template<typename Neighbours>
+std::size_t GraphColoring::speculative_coloring(const Neighbours& neighbours,
+                                                std::size_t num_vertices,
+                                              std::vector<std::size_t>& colors,
+                                                bool balanced)
+{
+  // Number of threads
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+
+  // Colors (-1 denotes uncolored)
+  std::vector<int> _colors(num_vertices, -1);
+  int* c = _colors.data();
+
+  // Vertices to (re)color
+  std::vector<int> work(num_vertices);
+  for (std::size_t i = 0; i < num_vertices; ++i)
+    work[i] = i;
+
+  std::vector<int> conflicts;
+  while (!work.empty())
+  {
+    const int num_work = work.size();
+
+    // Tentatively color vertices in work list concurrently. Each
+    // vertex gets the smallest color not used by its neighbours, as
+    // seen at the time of coloring.
+    #ifdef HAS_OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #endif
+    {
+      std::vector<int> forbidden;
+      #ifdef HAS_OPENMP
+      #pragma omp for schedule(guided, 64)
+      #endif
+      for (int i = 0; i < num_work; ++i)
+      {
+        const int v = work[i];
+        neighbours.mark(v, c, forbidden);
+        int color = 0;
+        while ((std::size_t) color < forbidden.size() && forbidden[color] == v)
+          ++color;
+        #ifdef HAS_OPENMP
+        #pragma omp atomic write
+        #endif
+        c[v] = color;
+      }
+    }
+
+    // Detect conflicts. Of two adjacent vertices with the same color,
+    // the higher-numbered one is recolored in the next round.
+    conflicts.clear();
+    #ifdef HAS_OPENMP
+    #pragma omp parallel num_threads(num_threads)
+    #endif
+    {
+      std::vector<int> thread_conflicts;
+      #ifdef HAS_OPENMP
+      #pragma omp for schedule(guided, 64) nowait
+      #endif
+      for (int i = 0; i < num_work; ++i)
+      {
+        if (neighbours.conflict(work[i], c))
+          thread_conflicts.push_back(work[i]);
+      }
+
+      #ifdef HAS_OPENMP
+      #pragma omp critical
+      #endif
+      conflicts.insert(conflicts.end(), thread_conflicts.begin(),
+                       thread_conflicts.end());
+    }
+
+    // Recolor conflicting vertices in increasing order
+    std::sort(conflicts.begin(), conflicts.end());
+    work.swap(conflicts);
+  }
+
+  // Count colors
+  std::size_t num_colors = 0;
+  for (std::size_t i = 0; i < num_vertices; ++i)
+    num_colors = std::max(num_colors, (std::size_t) _colors[i] + 1);
+
+  // Balance size of color classes
+  if (balanced)
+    balance_coloring(neighbours, _colors, num_colors);
+
+  colors.assign(_colors.begin(), _colors.end());
+  return num_colors;
+}
+//-----------------------------------------------------------------------------
+template<typename Neighbours>
+void GraphColoring::balance_coloring(const Neighbours& neighbours,
+                                     std::vector<int>& colors,
+                                     std::size_t num_colors)
+{
+  // Size of color classes
+  std::vector<std::size_t> count(num_colors, 0);
+  for (std::size_t i = 0; i < colors.size(); ++i)
+    ++count[colors[i]];
+
+  // Target size of color classes
+  const std::size_t target = (colors.size() + num_colors - 1)/num_colors;
+
+  // Move vertices in large color classes to the first permissible
+  // color class that is smaller than the target size
+  std::vector<int> forbidden(num_colors, -1);
+  for (std::size_t v = 0; v < colors.size(); ++v)
+  {
+    const int c = colors[v];
+    if (count[c] <= target)
+      continue;
+
+    neighbours.mark(v, colors.data(), forbidden);
+    for (std::size_t k = 0; k < num_colors; ++k)
+    {
+      if (count[k] < target && forbidden[k] != (int) v)
+      {
+        colors[v] = k;
+        --count[c];
+        ++count[k];
+        break;
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
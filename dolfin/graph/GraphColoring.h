@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2011-02-21
-// Last changed:
+// Last changed: 2026-10-19
 
 #ifndef __GRAPH_COLORING_H
 #define __GRAPH_COLORING_H
@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <vector>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -40,6 +41,46 @@ namespace dolfin
     static std::size_t compute_local_vertex_coloring(const Graph& graph,
                                             std::vector<std::size_t>& colors);
 
+    /// Compute vertex colors of a CSR graph using a threaded
+    /// speculative greedy algorithm (Gebremedhin and Manne): vertices
+    /// are colored concurrently, conflicts are detected and the
+    /// conflicting vertices are recolored until none remain. If
+    /// balanced is true, vertices are moved from large to small color
+    /// classes afterwards. Returns the number of colors.
+    static std::size_t
+      compute_local_vertex_coloring(const CSRGraph<int>& graph,
+                                    std::vector<std::size_t>& colors,
+                                    bool balanced=false);
+
+    /// Compute partial distance-2 coloring of the rows of a bipartite
+    /// graph with num_columns columns, i.e. two rows get different
+    /// colors if they share a column. This is the coloring of the
+    /// squared graph without building it, e.g. cells sharing a vertex
+    /// from the cell-vertex graph. Returns the number of colors.
+    static std::size_t
+      compute_local_distance2_coloring(const CSRGraph<int>& graph,
+                                       std::size_t num_columns,
+                                       std::vector<std::size_t>& colors,
+                                       bool balanced=false);
+
+  private:
+
+    // Speculative greedy coloring with conflict repair. The Neighbours
+    // type provides the neighbour loops for distance-1 and distance-2
+    // colorings.
+    template<typename Neighbours>
+    static std::size_t speculative_coloring(const Neighbours& neighbours,
+                                            std::size_t num_vertices,
+                                            std::vector<std::size_t>& colors,
+                                            bool balanced);
+
+    // Move vertices from color classes larger than average to smaller
+    // classes, without increasing the number of colors
+    template<typename Neighbours>
+    static void balance_coloring(const Neighbours& neighbours,
+                                 std::vector<int>& colors,
+                                 std::size_t num_colors);
+
   };
 }
 
@@ -19,7 +19,7 @@
 // Modified by Chris Richardson 2013
 //
 // First added:  2010-02-10
-// Last changed: 2014-01-09
+// Last changed: 2026-10-19
 
 #include <dolfin/log/dolfin_log.h>
 
@@ -52,10 +52,11 @@ namespace dolfin
     // Destructor
     ~ParMETISDualGraph();
 
+    // Dual graph, passed to ParMETIS without copying
+    CSRGraph<idx_t> graph;
+
     // ParMETIS data
     std::vector<idx_t> elmdist;
-    std::vector<idx_t> eptr;
-    std::vector<idx_t> eind;
     idx_t numflag;
     idx_t* xadj;
     idx_t* adjncy;
@@ -91,7 +92,7 @@ void ParMETIS::compute_partition(
   // Build dual graph
   ParMETISDualGraph g(mpi_comm, mesh_data);
 
-  dolfin_assert(g.eptr.size() - 1 == mesh_data.cell_vertices.size());
+  dolfin_assert(g.graph.num_vertices() == mesh_data.cell_vertices.size());
 
   // Partition graph
   if (mode == "partition")
@@ -130,7 +131,7 @@ void ParMETIS::partition(
   dolfin_assert(!g.ubvec.empty());
 
   // Call ParMETIS to partition graph
-  const std::size_t num_local_cells = g.eptr.size() - 1;
+  const std::size_t num_local_cells = g.graph.num_vertices();
   std::vector<idx_t> part(num_local_cells);
   dolfin_assert(!part.empty());
   int err = ParMETIS_V3_PartKway(g.elmdist.data(), g.xadj, g.adjncy, g.elmwgt,
@@ -265,7 +266,7 @@ void ParMETIS::adaptive_repartition(MPI_Comm mpi_comm,
   // Call ParMETIS to partition graph
   const double itr = parameters["ParMETIS_repartitioning_weight"];
   real_t _itr = itr;
-  std::vector<idx_t> part(g.eptr.size() - 1);
+  std::vector<idx_t> part(g.graph.num_vertices());
   std::vector<idx_t> vsize(part.size(), 1);
   dolfin_assert(!part.empty());
   int err = ParMETIS_V3_AdaptiveRepart(g.elmdist.data(), g.xadj, g.adjncy,
@@ -306,7 +307,7 @@ void ParMETIS::refine(MPI_Comm mpi_comm,
 
   // Partitioning array to be computed by ParMETIS. Prefill with
   // process_number.
-  const std::size_t num_local_cells = g.eptr.size() - 1;
+  const std::size_t num_local_cells = g.graph.num_vertices();
   std::vector<idx_t> part(num_local_cells, process_number);
   dolfin_assert(!part.empty());
 
@@ -330,7 +331,6 @@ ParMETISDualGraph::ParMETISDualGraph(MPI_Comm mpi_comm,
 
   // Get dimensions of local mesh_data
   const std::size_t num_local_cells = mesh_data.cell_vertices.size();
-  const std::size_t num_cell_vertices = mesh_data.num_vertices_per_cell;
 
   // Check that number of local graph nodes (cells) is > 0
   if (num_local_cells == 0)
@@ -349,36 +349,15 @@ ParMETISDualGraph::ParMETISDualGraph(MPI_Comm mpi_comm,
   for (std::size_t i = 1; i < num_processes + 1; ++i)
     elmdist[i] = elmdist[i - 1] + num_cells[i - 1];
 
-  eptr.resize(num_local_cells + 1);
-  eind.assign(num_local_cells*num_cell_vertices, 0);
-  for (std::size_t i = 0; i < num_local_cells; i++)
-  {
-    dolfin_assert(mesh_data.cell_vertices[i].size() == num_cell_vertices);
-    eptr[i] = i*num_cell_vertices;
-    for (std::size_t j = 0; j < num_cell_vertices; j++)
-      eind[eptr[i] + j] = mesh_data.cell_vertices[i][j];
-  }
-  eptr[num_local_cells] = num_local_cells*num_cell_vertices;
-
-  dolfin_assert(!eptr.empty());
-  dolfin_assert(!eind.empty());
+  // Build dual graph (partition along facets)
+  GraphBuilder::compute_dual_graph(mpi_comm, mesh_data, graph);
+  dolfin_assert(graph.num_vertices() == num_local_cells);
 
-  // Number of nodes shared for dual graph (partition along facets)
-  idx_t ncommonnodes = num_cell_vertices - 1;
+  // ParMETIS does not modify the graph arrays, but does not take
+  // const pointers
   numflag = 0;
-  xadj = 0;
-  adjncy = 0;
-
-  dolfin_assert(!eptr.empty());
-  dolfin_assert(!eind.empty());
-
-  // Could use GraphBuilder::compute_dual_graph() instead
-  int err = ParMETIS_V3_Mesh2Dual(elmdist.data(), eptr.data(), eind.data(),
-                                  &numflag, &ncommonnodes,
-                                  &xadj, &adjncy,
-                                  &mpi_comm);
-  dolfin_assert(err == METIS_OK);
-
+  xadj = const_cast<idx_t*>(graph.offsets().data());
+  adjncy = const_cast<idx_t*>(graph.adjacency().data());
 
   // Number of partitions (one for each process)
   nparts = num_processes;
@@ -388,17 +367,17 @@ ParMETISDualGraph::ParMETISDualGraph(MPI_Comm mpi_comm,
   tpwgts.assign(ncon*nparts, 1.0/static_cast<real_t>(nparts));
   ubvec.assign(ncon, 1.05);
 
-  // Prepare remaining arguments for ParMETIS
-  elmwgt = NULL;
-  wgtflag = 0;
+  // Prepare remaining arguments for ParMETIS (vertex weights only, if
+  // provided)
+  elmwgt = graph.vertex_weights().empty() ? NULL
+    : const_cast<idx_t*>(graph.vertex_weights().data());
+  wgtflag = graph.vertex_weights().empty() ? 0 : 2;
   edgecut = 0;
 }
 //-----------------------------------------------------------------------------
 ParMETISDualGraph::~ParMETISDualGraph()
 {
-  // Free metis data structures
-  METIS_Free(xadj);
-  METIS_Free(adjncy);
+  // Do nothing
 }
 //-----------------------------------------------------------------------------
 #else
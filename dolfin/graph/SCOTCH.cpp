@@ -19,7 +19,7 @@
 // Modified by Chris Richardson 2013
 //
 // First added:  2010-02-10
-// Last changed: 2014-09-09
+// Last changed: 2026-10-19
 
 #include <algorithm>
 #include <map>
@@ -55,19 +55,16 @@ void SCOTCH::compute_partition(
   std::map<std::size_t, dolfin::Set<unsigned int> >& ghost_procs,
   const LocalMeshData& mesh_data)
 {
-  // Create data structures to hold graph
-  std::vector<std::set<std::size_t> > local_graph;
-  std::set<std::size_t> ghost_vertices;
-
-  // Compute local dual graph
-  GraphBuilder::compute_dual_graph(mpi_comm, mesh_data, local_graph,
-                                   ghost_vertices);
+  // Compute local dual graph, stored directly in SCOTCH format
+  CSRGraph<SCOTCH_Num> local_graph;
+  const std::size_t num_ghost_vertices
+    = GraphBuilder::compute_dual_graph(mpi_comm, mesh_data, local_graph);
 
   // Compute partitions
   const std::size_t num_global_vertices = mesh_data.num_global_cells;
   const std::vector<std::size_t>& global_cell_indices
     = mesh_data.global_cell_indices;
-  partition(mpi_comm, local_graph, ghost_vertices, global_cell_indices,
+  partition(mpi_comm, local_graph, num_ghost_vertices, global_cell_indices,
             num_global_vertices, cell_partition, ghost_procs);
 
 }
@@ -196,10 +193,11 @@ void SCOTCH::compute_reordering(const Graph& graph,
             inverse_permutation_indices.end(), inverse_permutation.begin());
 }
 //-----------------------------------------------------------------------------
+template<typename T>
 void SCOTCH::partition(
   const MPI_Comm mpi_comm,
-  const std::vector<std::set<std::size_t> >& local_graph,
-  const std::set<std::size_t>& ghost_vertices,
+  const CSRGraph<T>& local_graph,
+  const std::size_t num_ghost_vertices,
   const std::vector<std::size_t>& global_cell_indices,
   const std::size_t num_global_vertices,
   std::vector<std::size_t>& cell_partition,
@@ -219,37 +217,33 @@ void SCOTCH::partition(
   // Local data ---------------------------------
 
   // Number of local graph vertices (cells)
-  const SCOTCH_Num vertlocnbr = local_graph.size();
-  const std::size_t vertgstnbr = vertlocnbr + ghost_vertices.size();
-
-  // Data structures for graph input to SCOTCH (add 1 for case that
-  // local graph size is zero)
-  std::vector<SCOTCH_Num> vertloctab;
-  vertloctab.reserve(local_graph.size() + 1);
-  std::vector<SCOTCH_Num> edgeloctab;
+  const SCOTCH_Num vertlocnbr = local_graph.num_vertices();
+  const std::size_t vertgstnbr = vertlocnbr + num_ghost_vertices;
 
-  // Build local graph input for SCOTCH
-  // (number of local + ghost graph vertices (cells),
-  // number of local edges + edges connecting to ghost vertices)
-  SCOTCH_Num edgelocnbr = 0;
-  vertloctab.push_back((SCOTCH_Num) 0);
-  std::vector<std::set<std::size_t> >::const_iterator vertex;
-  for(vertex = local_graph.begin(); vertex != local_graph.end(); ++vertex)
-  {
-    edgelocnbr += vertex->size();
-    vertloctab.push_back(vertloctab.back() + vertex->size());
-    edgeloctab.insert(edgeloctab.end(), vertex->begin(), vertex->end());
-  }
+  // Local graph input for SCOTCH is used in place (number of local
+  // edges + edges connecting to ghost vertices). SCOTCH does not
+  // modify the arrays, but does not take const pointers.
+  const SCOTCH_Num edgelocnbr = local_graph.num_edges();
+  SCOTCH_Num* vertloctab
+    = const_cast<SCOTCH_Num*>(local_graph.offsets().data());
 
   // Handle case that local graph size is zero
-  if (edgeloctab.empty())
-    edgeloctab.resize(1);
+  SCOTCH_Num edgeloctab_dummy = 0;
+  SCOTCH_Num* edgeloctab = local_graph.adjacency().empty()
+    ? &edgeloctab_dummy
+    : const_cast<SCOTCH_Num*>(local_graph.adjacency().data());
+
+  // Optional vertex and edge weights
+  SCOTCH_Num* veloloctab = local_graph.vertex_weights().empty() ? NULL
+    : const_cast<SCOTCH_Num*>(local_graph.vertex_weights().data());
+  SCOTCH_Num* edloloctab = local_graph.edge_weights().empty() ? NULL
+    : const_cast<SCOTCH_Num*>(local_graph.edge_weights().data());
 
   // Global data ---------------------------------
 
   // Number of local vertices (cells) on each process
   std::vector<SCOTCH_Num> proccnttab;
-  const SCOTCH_Num local_graph_size = local_graph.size();
+  const SCOTCH_Num local_graph_size = local_graph.num_vertices();
   MPI::all_gather(mpi_comm, local_graph_size, proccnttab);
 
   // FIXME: explain this test
@@ -270,7 +264,8 @@ void SCOTCH::partition(
   // Print graph data -------------------------------------
   /*
   {
-    const SCOTCH_Num vertgstnbr = local_graph.size() + ghost_vertices.size();
+    const SCOTCH_Num vertgstnbr = local_graph.num_vertices()
+      + num_ghost_vertices;
 
     // Total  (global) number of vertices (cells) in the graph
     const SCOTCH_Num vertglbnbr = num_global_vertices;
@@ -304,11 +299,11 @@ void SCOTCH::partition(
         cout << "(*) Num vert (inc ghost) (vertgstnbr): " << vertgstnbr << endl;
         cout << "(*) Num edges (edgelocnbr)           : " << edgelocnbr << endl;
         cout << "(*) Vertloctab: " << endl;
-        for (std::size_t i = 0; i < vertloctab.size(); ++i)
+        for (std::size_t i = 0; i < local_graph.offsets().size(); ++i)
           cout << "  " << vertloctab[i];
         cout << endl;
         cout << "edgeloctab: " << endl;
-        for (std::size_t i = 0; i < edgeloctab.size(); ++i)
+        for (std::size_t i = 0; i < local_graph.adjacency().size(); ++i)
           cout << "  " << edgeloctab[i];
         cout << endl;
         cout << "--------------------------------------------------" << endl;
@@ -331,9 +326,9 @@ void SCOTCH::partition(
 
   // Build SCOTCH distributed graph
   if (SCOTCH_dgraphBuild(&dgrafdat, baseval, vertlocnbr, vertlocnbr,
-                              &vertloctab[0], NULL, NULL, NULL,
+                              vertloctab, NULL, veloloctab, NULL,
                               edgelocnbr, edgelocnbr,
-                              &edgeloctab[0], NULL, NULL) )
+                              edgeloctab, NULL, edloloctab) )
   {
     dolfin_error("SCOTCH.cpp",
                  "partition mesh using SCOTCH",
@@ -491,18 +486,5 @@ void SCOTCH::compute_reordering(const Graph& graph,
                "DOLFIN has been configured without support for SCOTCH");
 }
 //-----------------------------------------------------------------------------
-void SCOTCH::partition(const MPI_Comm mpi_comm,
-                       const std::vector<std::set<std::size_t> >& local_graph,
-                       const std::set<std::size_t>& ghost_vertices,
-                       const std::vector<std::size_t>& global_cell_indices,
-                       const std::size_t num_global_vertices,
-                       std::vector<std::size_t>& cell_partition,
-                       std::map<std::size_t, dolfin::Set<unsigned int> >& ghost_procs)
-{
-  dolfin_error("SCOTCH.cpp",
-               "partition mesh using SCOTCH",
-               "DOLFIN has been configured without support for SCOTCH");
-}
-//-----------------------------------------------------------------------------
 
 #endif
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-02-10
-// Last changed: 2014-01-09
+// Last changed: 2026-10-19
 
 #ifndef __SCOTCH_PARTITIONER_H
 #define __SCOTCH_PARTITIONER_H
@@ -29,6 +29,7 @@
 
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Set.h>
+#include "CSRGraph.h"
 #include "Graph.h"
 
 namespace dolfin
@@ -73,10 +74,11 @@ namespace dolfin
   private:
 
     // Compute cell partitions from distributed dual graph
+    template<typename T>
     static void partition(
       const MPI_Comm mpi_comm,
-      const std::vector<std::set<std::size_t> >& local_graph,
-      const std::set<std::size_t>& ghost_vertices,
+      const CSRGraph<T>& local_graph,
+      const std::size_t num_ghost_vertices,
       const std::vector<std::size_t>& global_cell_indices,
       const std::size_t num_global_vertices,
       std::vector<std::size_t>& cell_partition,
@@ -4,6 +4,7 @@
 // DOLFIN graph interface
 
 #include <dolfin/graph/Graph.h>
+#include <dolfin/graph/CSRGraph.h>
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/BoostGraphOrdering.h>
 #include <dolfin/graph/SCOTCH.h>
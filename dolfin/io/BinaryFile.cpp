@@ -16,8 +16,9 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2009-11-11
-// Last changed: 2011-11-23
+// Last changed: 2026-10-19
 
+#include <cstring>
 #include <fstream>
 #include <ios>
 #include <iosfwd>
@@ -26,6 +27,13 @@
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/operations.hpp>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <dolfin/common/Array.h>
 #include <dolfin/la/GenericVector.h>
 #include <dolfin/log/log.h>
@@ -37,14 +45,16 @@ using namespace dolfin;
 
 //-----------------------------------------------------------------------------
 BinaryFile::BinaryFile(const std::string filename, bool store_connectivity)
-  : GenericFile(filename, "Binary"), _store_connectivity(store_connectivity)
+  : GenericFile(filename, "Binary"), _store_connectivity(store_connectivity),
+    _version(0), _position(0), _mapped_data(NULL), _mapped_size(0)
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
 BinaryFile::~BinaryFile()
 {
-  // Do nothing
+  // Release mapping and stream if a read was interrupted by an error
+  close_read();
 }
 //-----------------------------------------------------------------------------
 void BinaryFile::operator>> (std::vector<double>& values)
@@ -227,10 +237,6 @@ void BinaryFile::operator<< (const Mesh& mesh)
 //-----------------------------------------------------------------------------
 void BinaryFile::open_read()
 {
-  // Get file path and extension
-  const boost::filesystem::path path(_filename);
-  const std::string extension = boost::filesystem::extension(path);
-
   // FIXME: Check that file exists
   if (!boost::filesystem::is_regular_file(_filename))
   {
@@ -240,9 +246,70 @@ void BinaryFile::open_read()
                  _filename.c_str());
   }
 
-  // Load xml file (unzip if necessary) into parser
+  // Map uncompressed files into memory
+  const boost::filesystem::path path(_filename);
+  const std::string extension = boost::filesystem::extension(path);
+  #ifndef _WIN32
+  if (extension != ".gz")
+  {
+    const int fd = open(_filename.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd >= 0 && fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+    {
+      void* data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd,
+                        0);
+      if (data != MAP_FAILED)
+      {
+        madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+        _mapped_data = static_cast<char*>(data);
+        _mapped_size = file_stat.st_size;
+      }
+    }
+    if (fd >= 0)
+      close(fd);
+  }
+  #endif
+
+  if (!_mapped_data)
+    open_stream();
+
+  // Check for header. Files without header are in the unversioned
+  // format and are read from the start.
+  _position = 0;
+  std::size_t header = 0;
+  if (_mapped_data && _mapped_size >= 2*sizeof(std::size_t))
+    std::memcpy(&header, _mapped_data, sizeof(std::size_t));
+  else if (!_mapped_data)
+  {
+    boost::iostreams::read(ifilter, (char*) &header,
+                           (std::streamsize) sizeof(std::size_t));
+    close_read();
+    open_stream();
+  }
+
+  _version = 0;
+  if (header == magic)
+  {
+    read_uint();
+    _version = read_uint();
+    if (_version > version)
+    {
+      dolfin_error("BinaryFile.cpp",
+                   "open binary file",
+                   "File \"%s\" has format version %d, but only versions up to %d are supported",
+                   _filename.c_str(), _version, version);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void BinaryFile::open_stream()
+{
+  // Get file path and extension
+  const boost::filesystem::path path(_filename);
+  const std::string extension = boost::filesystem::extension(path);
+
+  // Decompress file if necessary
   if (extension == ".gz")
-    // Decompress file
     ifilter.push(boost::iostreams::gzip_decompressor());
 
   ifile.open(_filename.c_str(), std::ios::in | std::ios::binary);
@@ -260,7 +327,6 @@ void BinaryFile::open_write()
   // Compress if filename has extension '.gz'
   const boost::filesystem::path path(_filename);
   const std::string extension = boost::filesystem::extension(path);
-
   if (extension == ".gz")
     ofilter.push(boost::iostreams::gzip_compressor());
 
@@ -272,49 +338,102 @@ void BinaryFile::open_write()
                  "Cannot open file \"%s\" for writing", _filename.c_str());
   }
   ofilter.push(ofile);
+
+  // Write header
+  _position = 0;
+  write_uint(magic);
+  write_uint(version);
 }
 //-----------------------------------------------------------------------------
 void BinaryFile::close_read()
 {
+  #ifndef _WIN32
+  if (_mapped_data)
+    munmap(_mapped_data, _mapped_size);
+  #endif
+  _mapped_data = NULL;
+  _mapped_size = 0;
+
   ifilter.reset();
+  if (ifile.is_open())
+    ifile.close();
 }
 //-----------------------------------------------------------------------------
 void BinaryFile::close_write()
 {
   ofilter.reset();
+  if (ofile.is_open())
+    ofile.close();
+}
+//-----------------------------------------------------------------------------
+void BinaryFile::read_bytes(char* data, std::size_t n)
+{
+  if (_mapped_data)
+  {
+    if (_position + n > _mapped_size)
+    {
+      dolfin_error("BinaryFile.cpp",
+                   "read binary file",
+                   "Unexpected end of file \"%s\"", _filename.c_str());
+    }
+    std::memcpy(data, _mapped_data + _position, n);
+  }
+  else
+    boost::iostreams::read(ifilter, data, (std::streamsize) n);
+  _position += n;
+}
+//-----------------------------------------------------------------------------
+void BinaryFile::align_read()
+{
+  // Unversioned files are not padded
+  if (_version == 0)
+    return;
+
+  const std::size_t padding = (alignment - _position % alignment) % alignment;
+  if (_mapped_data)
+    _position += padding;
+  else
+  {
+    char buffer[alignment];
+    read_bytes(buffer, padding);
+  }
+}
+//-----------------------------------------------------------------------------
+void BinaryFile::align_write()
+{
+  const std::size_t padding = (alignment - _position % alignment) % alignment;
+  const char buffer[alignment] = {0};
+  boost::iostreams::write(ofilter, buffer, (std::streamsize) padding);
+  _position += padding;
 }
 //-----------------------------------------------------------------------------
 std::size_t BinaryFile::read_uint()
 {
   std::size_t value = 0;
-  boost::iostreams::read(ifilter, (char*) &value,
-                         (std::streamsize) sizeof(std::size_t));
+  read_bytes((char*) &value, sizeof(std::size_t));
   return value;
 }
 //-----------------------------------------------------------------------------
 template <typename T>
 void BinaryFile::read_array(std::size_t n, T* values)
 {
-  for (std::size_t i = 0; i < n; ++i)
-  {
-    boost::iostreams::read(ifilter, (char*) (values + i),
-                           (std::streamsize) sizeof(T));
-  }
+  align_read();
+  read_bytes((char*) values, n*sizeof(T));
 }
 //-----------------------------------------------------------------------------
 void BinaryFile::write_uint(std::size_t value)
 {
   boost::iostreams::write(ofilter, (char*) &value,
                           (std::streamsize) sizeof(std::size_t));
+  _position += sizeof(std::size_t);
 }
 //-----------------------------------------------------------------------------
 template <typename T>
 void BinaryFile::write_array(std::size_t n, const T* values)
 {
-  for (std::size_t i = 0; i < n; ++i)
-  {
-    boost::iostreams::write(ofilter, (char*) &values[i],
-                            (std::streamsize) sizeof(T));
-  }
+  align_write();
+  boost::iostreams::write(ofilter, (const char*) values,
+                          (std::streamsize) (n*sizeof(T)));
+  _position += n*sizeof(T);
 }
 //-----------------------------------------------------------------------------
@@ -16,11 +16,12 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2009-11-11
-// Last changed: 2011-10-23
+// Last changed: 2026-10-19
 
 #ifndef __BINARY_FILE_H
 #define __BINARY_FILE_H
 
+#include <cstddef>
 #include <fstream>
 #include <boost/iostreams/filtering_streambuf.hpp>
 #include "GenericFile.h"
@@ -36,6 +37,12 @@ namespace dolfin
   /// is more efficient than DOLFIN XML format but does not support
   /// all data types. Use this format with caution. Often, a plain
   /// text self-documenting format is more suitable for storing data.
+  ///
+  /// Files start with a magic number and a format version, and each
+  /// array is aligned to a 64-byte boundary of the file. Uncompressed
+  /// files are memory mapped for reading, so that arrays are copied
+  /// into place with a single memcpy each. Files written in the older
+  /// unversioned format can still be read.
 
   class BinaryFile : public GenericFile
   {
@@ -83,6 +90,18 @@ namespace dolfin
     // Close file for writing
     void close_write();
 
+    // Open file stream for reading
+    void open_stream();
+
+    // Read n bytes
+    void read_bytes(char* data, std::size_t n);
+
+    // Skip padding up to next aligned position
+    void align_read();
+
+    // Write padding up to next aligned position
+    void align_write();
+
     // Read std::size_t
     std::size_t read_uint();
 
@@ -106,6 +125,24 @@ namespace dolfin
     // Store all connectivity in a mesh
     bool _store_connectivity;
 
+    // Magic number ("DOLFINBN") and version written at start of file
+    static const std::size_t magic = 0x4e424e49464c4f44;
+    static const std::size_t version = 1;
+
+    // Alignment of arrays in file (bytes)
+    static const std::size_t alignment = 64;
+
+    // Format version of file being read (0 for unversioned files)
+    std::size_t _version;
+
+    // Current position in file being read or written (bytes)
+    std::size_t _position;
+
+    // Memory mapped file for reading (null if file is read as a
+    // stream) and its size
+    char* _mapped_data;
+    std::size_t _mapped_size;
+
     // File for reading
     boost::iostreams::filtering_streambuf<boost::iostreams::input> ifilter;
     std::ifstream ifile;
@@ -18,7 +18,7 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2009-08-11
-// Last changed: 2011-11-14
+// Last changed: 2026-10-19
 
 #ifndef __ENCODER_H
 #define __ENCODER_H
@@ -31,10 +31,14 @@ extern "C"
 }
 #endif
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <string>
 #include <vector>
 #include <utility>
 #include <boost/shared_array.hpp>
+#include <dolfin/log/log.h>
 #include "base64.h"
 
 namespace dolfin
@@ -65,6 +69,119 @@ namespace dolfin
                                     data.size()*sizeof(T));
     }
 
+    // Table mapping characters to 6-bit base64 values (-1 for
+    // characters outside the base64 alphabet)
+    struct Base64Table
+    {
+      Base64Table()
+      {
+        const char* alphabet
+          = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::memset(value, -1, sizeof(value));
+        for (int i = 0; i < 64; ++i)
+          value[(unsigned char) alphabet[i]] = i;
+      }
+
+      signed char value[256];
+    };
+
+    /// Decode base64 encoded characters into bytes using a lookup
+    /// table. The number of characters must be a multiple of 4 unless
+    /// the end of the data is reached. Returns the number of decoded
+    /// bytes (at most 3*length/4).
+    static std::size_t decode_base64(const char* encoded, std::size_t length,
+                                     unsigned char* decoded)
+    {
+      // Initialised once (thread-safe)
+      static const Base64Table table;
+
+      std::size_t num_bytes = 0;
+      unsigned int group = 0;
+      int num_chars = 0;
+      for (std::size_t i = 0; i < length; ++i)
+      {
+        const signed char value = table.value[(unsigned char) encoded[i]];
+        if (value < 0)
+        {
+          // Padding ends the data, whitespace is skipped
+          if (encoded[i] == '=')
+            break;
+          continue;
+        }
+
+        group = (group << 6) | value;
+        if (++num_chars == 4)
+        {
+          decoded[num_bytes++] = (group >> 16) & 0xff;
+          decoded[num_bytes++] = (group >> 8) & 0xff;
+          decoded[num_bytes++] = group & 0xff;
+          group = 0;
+          num_chars = 0;
+        }
+      }
+
+      // Remaining (padded) characters
+      if (num_chars == 2)
+        decoded[num_bytes++] = (group >> 4) & 0xff;
+      else if (num_chars == 3)
+      {
+        decoded[num_bytes++] = (group >> 10) & 0xff;
+        decoded[num_bytes++] = (group >> 2) & 0xff;
+      }
+
+      return num_bytes;
+    }
+
+    /// Return the range [begin, end) of base64 characters, in whole
+    /// groups of 4 characters (3 bytes), that covers values offset,
+    /// ..., offset + n - 1 of an encoded array of type T
+    template<typename T>
+    static std::pair<std::size_t, std::size_t>
+    base64_range(std::size_t offset, std::size_t n)
+    {
+      return std::make_pair(4*((offset*sizeof(T))/3),
+                            4*(((offset + n)*sizeof(T) + 2)/3));
+    }
+
+    /// Decode values offset, ..., offset + n - 1 of an array of type T
+    /// stored as base64 encoded bytes (without whitespace). Only the
+    /// characters covering the requested values are decoded. If
+    /// encoded holds only part of the encoded array, first_char is
+    /// the position of its first character in the array (a multiple
+    /// of 4).
+    template<typename T>
+    static void decode_base64(const char* encoded, std::size_t length,
+                              std::size_t offset, std::size_t n, T* data,
+                              std::size_t first_char=0)
+    {
+      if (n == 0)
+        return;
+
+      const std::size_t byte_begin = offset*sizeof(T);
+      std::pair<std::size_t, std::size_t> range = base64_range<T>(offset, n);
+      range.second = std::min(first_char + length, range.second);
+      if (range.first < first_char || range.first > range.second)
+      {
+        dolfin_error("Encoder.h",
+                     "decode base64 data",
+                     "Encoded data is too short");
+      }
+
+      const std::size_t num_chars = range.second - range.first;
+      std::vector<unsigned char> bytes(3*num_chars/4 + 3);
+      const std::size_t num_bytes
+        = decode_base64(encoded + range.first - first_char, num_chars,
+                        bytes.data());
+      const std::size_t skip = byte_begin - 3*(byte_begin/3);
+      if (num_bytes < skip + n*sizeof(T))
+      {
+        dolfin_error("Encoder.h",
+                     "decode base64 data",
+                     "Encoded data is too short");
+      }
+      std::memcpy(data, bytes.data() + skip, n*sizeof(T));
+    }
+
     #ifdef HAS_ZLIB
     template<typename T>
     static std::pair<boost::shared_array<unsigned char>, std::size_t> compress_data(const std::vector<T>& data)
@@ -20,7 +20,7 @@
 // Modified by Ola Skavhaug 2009
 //
 // First added:  2002-11-12
-// Last changed: 2013-03-11
+// Last changed: 2026-10-19
 
 #ifndef __FILE_H
 #define __FILE_H
@@ -64,6 +64,8 @@ namespace dolfin
     ///         Name of file.
     ///     encoding (std::string)
     ///         Optional argument specifying encoding, ASCII is default.
+    ///         VTK output supports "ascii", "base64", "compressed",
+    ///         "raw" and "raw_compressed".
     ///
     /// *Example*
     ///    .. code-block:: c++
@@ -18,7 +18,7 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2009-03-03
-// Last changed: 2011-11-14
+// Last changed: 2026-10-19
 
 #ifndef __SAXHANDLER_H
 #define __SAXHANDLER_H
@@ -76,6 +76,21 @@ namespace dolfin
       return boost::lexical_cast<T, std::string>("0");
     }
 
+    template<typename T>
+    static T parse_optional(const xmlChar* name, const xmlChar** attrs,
+                            const char* attribute, std::size_t num_attributes,
+                            const T& default_value)
+    {
+      // Check for attribute
+      for (std::size_t i = 0; attrs && i < num_attributes; i++)
+      {
+        if (xmlStrcasecmp(attrs[5*i], (xmlChar *) attribute) == 0)
+          return parse<T>(name, attrs, attribute, num_attributes);
+      }
+
+      return default_value;
+    }
+
   };
 
 }
@@ -0,0 +1,125 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <algorithm>
+#include <cstring>
+#include <boost/cstdint.hpp>
+#include <dolfin/log/log.h>
+#include "VTKWriter.h"
+#include "VTKAppendedData.h"
+
+using namespace dolfin;
+
+//----------------------------------------------------------------------------
+VTKAppendedData::VTKAppendedData(bool compress) : _compress(compress),
+                                                  _size(0), _mesh_signature(0)
+{
+  #ifndef HAS_ZLIB
+  if (_compress)
+  {
+    warning("zlib must be configured to enable compressed VTK output. Using uncompressed raw encoding instead.");
+    _compress = false;
+  }
+  #endif
+}
+//----------------------------------------------------------------------------
+VTKAppendedData::~VTKAppendedData()
+{
+  // Do nothing
+}
+//----------------------------------------------------------------------------
+std::size_t VTKAppendedData::append(const char* data, std::size_t size)
+{
+  std::shared_ptr<std::vector<char> > array(new std::vector<char>);
+  if (_compress)
+  {
+    std::vector<char> compressed;
+    std::vector<std::size_t> block_sizes;
+    VTKWriter::compress_blocks(data, size, compressed, block_sizes);
+
+    // Header: number of blocks, block size, size of last (partial)
+    // block and compressed size of each block
+    const std::size_t block_size = VTKWriter::compression_block_size;
+    std::vector<boost::uint64_t> header(3 + block_sizes.size());
+    header[0] = block_sizes.size();
+    header[1] = block_size;
+    header[2] = size % block_size;
+    std::copy(block_sizes.begin(), block_sizes.end(), header.begin() + 3);
+
+    const std::size_t header_size = header.size()*sizeof(boost::uint64_t);
+    array->resize(header_size + compressed.size());
+    std::memcpy(array->data(), header.data(), header_size);
+    std::memcpy(array->data() + header_size, compressed.data(),
+                compressed.size());
+  }
+  else
+  {
+    // Header: number of bytes
+    const boost::uint64_t header = size;
+    array->resize(sizeof(header) + size);
+    std::memcpy(array->data(), &header, sizeof(header));
+    std::memcpy(array->data() + sizeof(header), data, size);
+  }
+
+  return append(array);
+}
+//----------------------------------------------------------------------------
+bool VTKAppendedData::append_mesh(std::size_t signature,
+                                  std::vector<std::size_t>& offsets)
+{
+  if (_mesh_arrays.empty() || signature != _mesh_signature)
+    return false;
+
+  offsets.clear();
+  for (std::size_t i = 0; i < _mesh_arrays.size(); ++i)
+    offsets.push_back(append(_mesh_arrays[i]));
+  return true;
+}
+//----------------------------------------------------------------------------
+void VTKAppendedData::cache_mesh(std::size_t signature, std::size_t num_arrays)
+{
+  dolfin_assert(num_arrays <= _arrays.size());
+  _mesh_signature = signature;
+  _mesh_arrays.assign(_arrays.end() - num_arrays, _arrays.end());
+}
+//----------------------------------------------------------------------------
+void VTKAppendedData::write(std::ostream& file) const
+{
+  file << "_";
+  for (std::size_t i = 0; i < _arrays.size(); ++i)
+    file.write(_arrays[i]->data(), _arrays[i]->size());
+}
+//----------------------------------------------------------------------------
+void VTKAppendedData::clear()
+{
+  _arrays.clear();
+  _size = 0;
+}
+//----------------------------------------------------------------------------
+std::size_t
+VTKAppendedData::append(std::shared_ptr<const std::vector<char> > array)
+{
+  dolfin_assert(array);
+  const std::size_t offset = _size;
+  _arrays.push_back(array);
+  _size += array->size();
+  return offset;
+}
+//----------------------------------------------------------------------------
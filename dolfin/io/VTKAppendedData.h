@@ -0,0 +1,100 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __VTK_APPENDED_DATA_H
+#define __VTK_APPENDED_DATA_H
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace dolfin
+{
+
+  /// This class collects the arrays of a VTK XML file written in
+  /// appended raw format. Each array is stored as a UInt64 header
+  /// followed by its bytes, either as they are or compressed with
+  /// zlib in independent blocks (compressed by several threads). A
+  /// DataArray element refers to its array by offset, and all arrays
+  /// are written after the XML part of the file by write().
+  ///
+  /// The arrays of the last mesh appended can be kept between the
+  /// files of a time series, so that an unchanged mesh is only
+  /// encoded once.
+
+  class VTKAppendedData
+  {
+  public:
+
+    /// Create appended data (compressed if compress is true)
+    explicit VTKAppendedData(bool compress);
+
+    /// Destructor
+    ~VTKAppendedData();
+
+    /// Return true if arrays are compressed
+    bool compressed() const
+    { return _compress; }
+
+    /// Encode and append array. Returns the offset of the array
+    template<typename T>
+    std::size_t append(const std::vector<T>& data)
+    { return append((const char*) data.data(), data.size()*sizeof(T)); }
+
+    /// Encode and append array of bytes. Returns the offset of the
+    /// array
+    std::size_t append(const char* data, std::size_t size);
+
+    /// Append the cached mesh arrays if they were computed for a mesh
+    /// with the given signature, and return their offsets. Returns
+    /// false if there are no cached arrays for the signature.
+    bool append_mesh(std::size_t signature, std::vector<std::size_t>& offsets);
+
+    /// Cache the last num_arrays arrays as the arrays of the mesh
+    /// with the given signature
+    void cache_mesh(std::size_t signature, std::size_t num_arrays);
+
+    /// Write appended data, starting with the '_' marker, to stream
+    void write(std::ostream& file) const;
+
+    /// Remove all arrays (cached mesh arrays are kept)
+    void clear();
+
+  private:
+
+    // Append encoded array and return its offset
+    std::size_t append(std::shared_ptr<const std::vector<char> > array);
+
+    // True if arrays are compressed
+    bool _compress;
+
+    // Encoded arrays and their total size
+    std::vector<std::shared_ptr<const std::vector<char> > > _arrays;
+    std::size_t _size;
+
+    // Cached mesh arrays and signature of the mesh
+    std::vector<std::shared_ptr<const std::vector<char> > > _mesh_arrays;
+    std::size_t _mesh_signature;
+
+  };
+
+}
+
+#endif
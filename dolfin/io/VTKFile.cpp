@@ -22,8 +22,9 @@
 // Modified by Johannes Ring 2012
 //
 // First added:  2005-07-05
-// Last changed: 2013-03-11
+// Last changed: 2026-10-19
 
+#include <algorithm>
 #include <ostream>
 #include <sstream>
 #include <vector>
@@ -44,7 +45,9 @@
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Encoder.h"
+#include "VTKAppendedData.h"
 #include "VTKWriter.h"
 #include "VTKFile.h"
 
@@ -55,12 +58,14 @@ VTKFile::VTKFile(const std::string filename, std::string encoding)
   : GenericFile(filename, "VTK"),
     _encoding(encoding), binary(false), compress(false)
 {
-  if (encoding != "ascii" && encoding != "base64" && encoding != "compressed")
+  if (encoding != "ascii" && encoding != "base64" && encoding != "compressed"
+      && encoding != "raw" && encoding != "raw_compressed")
   {
     dolfin_error("VTKFile.cpp",
                  "create VTK file",
                  "Unknown encoding (\"%s\"). "
-                 "Known encodings are \"ascii\", \"base64\" and \"compressed\"",
+                 "Known encodings are \"ascii\", \"base64\", \"compressed\", "
+                 "\"raw\" and \"raw_compressed\"",
                  encoding.c_str());
   }
 
@@ -76,12 +81,21 @@ VTKFile::VTKFile(const std::string filename, std::string encoding)
     if (encoding == "compressed")
       compress = true;
   }
+  else if (encoding == "raw" || encoding == "raw_compressed")
+  {
+    encode_string = "appended";
+    binary = true;
+    if (encoding == "raw_compressed")
+      compress = true;
+    _appended.reset(new VTKAppendedData(compress));
+  }
   else
   {
     dolfin_error("VTKFile.cpp",
                  "create VTK file",
                  "Unknown encoding (\"%s\"). "
-                 "Known encodings are \"ascii\", \"base64\" and \"compressed\"",
+                 "Known encodings are \"ascii\", \"base64\", \"compressed\", "
+                 "\"raw\" and \"raw_compressed\"",
                  encoding.c_str());
   }
 }
@@ -171,7 +185,7 @@ void VTKFile::write_function(const Function& u, double time)
 
   // Write mesh
   VTKWriter::write_mesh(mesh, mesh.topology().dim(), vtu_filename, binary,
-                        compress);
+                        compress, _appended.get());
 
   // Write results
   results_write(u, vtu_filename);
@@ -206,7 +220,7 @@ void VTKFile::write_mesh(const Mesh& mesh, double time)
 
   // Write local mesh to vtu file
   VTKWriter::write_mesh(mesh, mesh.topology().dim(), vtu_filename, binary,
-                        compress);
+                        compress, _appended.get());
 
   // Parallel-specific files
   const std::size_t num_processes = MPI::size(mpi_comm);
@@ -255,7 +269,7 @@ void VTKFile::finalize(std::string vtu_filename, double time)
   counter++;
 }
 //----------------------------------------------------------------------------
-void VTKFile::results_write(const Function& u, std::string vtu_filename) const
+void VTKFile::results_write(const Function& u, std::string vtu_filename)
 {
   // Get rank of Function
   const std::size_t rank = u.value_rank();
@@ -299,13 +313,14 @@ void VTKFile::results_write(const Function& u, std::string vtu_filename) const
   dolfin_assert(u.function_space()->dofmap());
   const GenericDofMap& dofmap= *u.function_space()->dofmap();
   if (dofmap.max_cell_dimension() == cell_based_dim)
-    VTKWriter::write_cell_data(u, vtu_filename, binary, compress);
+    VTKWriter::write_cell_data(u, vtu_filename, binary, compress,
+                               _appended.get());
   else
     write_point_data(u, mesh, vtu_filename);
 }
 //----------------------------------------------------------------------------
 void VTKFile::write_point_data(const GenericFunction& u, const Mesh& mesh,
-                               std::string vtu_filename) const
+                               std::string vtu_filename)
 {
   const std::size_t rank = u.value_rank();
   const std::size_t num_vertices = mesh.num_vertices();
@@ -334,17 +349,17 @@ void VTKFile::write_point_data(const GenericFunction& u, const Mesh& mesh,
   if (rank == 0)
   {
     fp << "<PointData  Scalars=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  format=\""<< encode_string <<"\">";
+    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  format=\""<< encode_string <<"\"";
   }
   else if (rank == 1)
   {
     fp << "<PointData  Vectors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  NumberOfComponents=\"3\" format=\""<< encode_string <<"\">";
+    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  NumberOfComponents=\"3\" format=\""<< encode_string <<"\"";
   }
   else if (rank == 2)
   {
     fp << "<PointData  Tensors=\"" << u.name() << "\"> " << std::endl;
-    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  NumberOfComponents=\"9\" format=\""<< encode_string <<"\">";
+    fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  NumberOfComponents=\"9\" format=\""<< encode_string <<"\"";
   }
 
   if (_encoding == "ascii")
@@ -384,9 +399,9 @@ void VTKFile::write_point_data(const GenericFunction& u, const Mesh& mesh,
     }
 
     // Send to file
-    fp << ss.str();
+    fp << ">" << ss.str();
   }
-  else if (_encoding == "base64" || _encoding == "compressed")
+  else
   {
     // Number of zero paddings per point
     std::size_t padding_per_point = 0;
@@ -400,15 +415,21 @@ void VTKFile::write_point_data(const GenericFunction& u, const Mesh& mesh,
     const std::size_t num_total_data_points = num_vertices*num_data_per_point;
 
     std::vector<double> data(num_total_data_points, 0);
-    for (VertexIterator vertex(mesh); !vertex.end(); ++vertex)
+    #ifdef HAS_OPENMP
+    const int num_threads = std::max(1, (int) parameters["num_threads"]);
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    #endif
+    for (int index = 0; index < (int) num_vertices; ++index)
     {
-      const std::size_t index = vertex->index();
       for(std::size_t i = 0; i < dim; i++)
         data[index*num_data_per_point + i] = values[index + i*num_vertices];
     }
 
-    // Create encoded stream
-    fp << VTKWriter::encode_stream(data, compress) << std::endl;
+    // Create encoded stream, or append data
+    if (_appended)
+      fp << " offset=\"" << _appended->append(data) << "\">";
+    else
+      fp << ">" << VTKWriter::encode_stream(data, compress) << std::endl;
   }
 
   fp << "</DataArray> " << std::endl;
@@ -630,7 +651,7 @@ void VTKFile::vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
 
   // Figure out endianness of machine
   std::string endianness = "";
-  if (encode_string == "binary")
+  if (binary)
   {
     #if defined BOOST_LITTLE_ENDIAN
     endianness = "byte_order=\"LittleEndian\"";
@@ -645,13 +666,18 @@ void VTKFile::vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
 
   // Compression string
   std::string compressor = "";
-  if (_encoding == "compressed")
+  if (_encoding == "compressed" || (_appended && _appended->compressed()))
     compressor = "compressor=\"vtkZLibDataCompressor\"";
 
+  // Appended data uses 64-bit headers to allow for large arrays
+  std::string version = "version=\"0.1\"";
+  if (_appended)
+    version = "version=\"1.0\" header_type=\"UInt64\"";
+
   // Write headers
   file << "<?xml version=\"1.0\"?>" << std::endl;
-  file << "<VTKFile type=\"UnstructuredGrid\"  version=\"0.1\" " << endianness
-       <<  " " << compressor << ">" << std::endl;
+  file << "<VTKFile type=\"UnstructuredGrid\"  " << version << " "
+       << endianness <<  " " << compressor << ">" << std::endl;
   file << "<UnstructuredGrid>" << std::endl;
   file << "<Piece  NumberOfPoints=\"" << num_vertices << "\" NumberOfCells=\""
        << num_cells << "\">" << std::endl;
@@ -660,10 +686,10 @@ void VTKFile::vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
   file.close();
 }
 //----------------------------------------------------------------------------
-void VTKFile::vtk_header_close(std::string vtu_filename) const
+void VTKFile::vtk_header_close(std::string vtu_filename)
 {
   // Open file
-  std::ofstream file(vtu_filename.c_str(), std::ios::app);
+  std::ofstream file(vtu_filename.c_str(), std::ios::app | std::ios::binary);
   file.precision(16);
   if (!file.is_open())
   {
@@ -673,8 +699,18 @@ void VTKFile::vtk_header_close(std::string vtu_filename) const
   }
 
   // Close headers
-  file << "</Piece>" << std::endl << "</UnstructuredGrid>" << std::endl
-       << "</VTKFile>";
+  file << "</Piece>" << std::endl << "</UnstructuredGrid>" << std::endl;
+
+  // Write appended data
+  if (_appended)
+  {
+    file << "<AppendedData encoding=\"raw\">" << std::endl;
+    _appended->write(file);
+    _appended->clear();
+    file << std::endl << "</AppendedData>" << std::endl;
+  }
+
+  file << "</VTKFile>";
 
   // Close file
   file.close();
@@ -717,7 +753,8 @@ void VTKFile::mesh_function_write(T& meshfunction, double time)
   std::string vtu_filename = init(mesh, cell_dim);
 
   // Write mesh
-  VTKWriter::write_mesh(mesh, cell_dim, vtu_filename, binary, compress);
+  VTKWriter::write_mesh(mesh, cell_dim, vtu_filename, binary, compress,
+                        _appended.get());
 
   // Open file to write data
   std::ofstream fp(vtu_filename.c_str(), std::ios_base::app);
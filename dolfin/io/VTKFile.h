@@ -19,12 +19,13 @@
 // Modified by Niclas Jansson 2009.
 //
 // First added:  2005-07-05
-// Last changed: 2013-03-11
+// Last changed: 2026-10-19
 
 #ifndef __VTK_FILE_H
 #define __VTK_FILE_H
 
 #include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,9 +39,18 @@ namespace pugi
 namespace dolfin
 {
 
+  class VTKAppendedData;
+
   /// This class supports the output of meshes and functions in VTK
   /// XML format for visualisation purposes. It is not suitable to
   /// checkpointing as it may decimate some data.
+  ///
+  /// The encodings "ascii", "base64" and "compressed" write data
+  /// inline. The encodings "raw" and "raw_compressed" write data as
+  /// raw binary (optionally compressed with zlib) appended to the
+  /// file. Appended output has no base64 overhead, and the encoded
+  /// arrays of an unchanged mesh are reused for all files of a
+  /// series.
 
   class VTKFile : public GenericFile
   {
@@ -73,10 +83,10 @@ namespace dolfin
 
     void finalize(std::string vtu_filename, double time);
 
-    void results_write(const Function& u, std::string file) const;
+    void results_write(const Function& u, std::string file);
 
     void write_point_data(const GenericFunction& u, const Mesh& mesh,
-                          std::string file) const;
+                          std::string file);
 
     void pvd_file_write(std::size_t step, double time, std::string file);
 
@@ -95,7 +105,7 @@ namespace dolfin
     void vtk_header_open(std::size_t num_vertices, std::size_t num_cells,
                          std::string file) const;
 
-    void vtk_header_close(std::string file) const;
+    void vtk_header_close(std::string file);
 
     std::string vtu_name(const int process, const int num_processes,
                          const int counter, std::string ext) const;
@@ -119,6 +129,10 @@ namespace dolfin
     bool binary;
     bool compress;
 
+    // Arrays of the file being written in appended format (null for
+    // inline encodings)
+    std::shared_ptr<VTKAppendedData> _appended;
+
   };
 
 }
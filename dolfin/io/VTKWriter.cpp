@@ -19,14 +19,17 @@
 // Modified by Johannes Ring 2012
 //
 // First added:  2010-07-19
-// Last changed: 2012-09-14
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <ostream>
 #include <sstream>
 #include <vector>
 #include <iomanip>
 #include <boost/detail/endian.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <dolfin/fem/GenericDofMap.h>
 #include <dolfin/fem/FiniteElement.h>
@@ -38,23 +41,32 @@
 #include <dolfin/mesh/MeshEntityIterator.h>
 #include <dolfin/mesh/MeshFunction.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include "base64.h"
 #include "Encoder.h"
+#include "VTKAppendedData.h"
 #include "VTKWriter.h"
 
 using namespace dolfin;
 
+const std::size_t VTKWriter::compression_block_size;
+
 //----------------------------------------------------------------------------
 void VTKWriter::write_mesh(const Mesh& mesh, std::size_t cell_dim,
-                           std::string filename, bool binary, bool compress)
+                           std::string filename, bool binary, bool compress,
+                           VTKAppendedData* appended)
 {
-  if (binary)
+  if (appended)
+    write_appended_mesh(mesh, cell_dim, filename, *appended);
+  else if (binary)
     write_base64_mesh(mesh, cell_dim, filename, compress);
   else
     write_ascii_mesh(mesh, cell_dim, filename);
 }
 //----------------------------------------------------------------------------
 void VTKWriter::write_cell_data(const Function& u, std::string filename,
-                                bool binary, bool compress)
+                                bool binary, bool compress,
+                                VTKAppendedData* appended)
 {
   // For brevity
   dolfin_assert(u.function_space()->mesh());
@@ -64,7 +76,9 @@ void VTKWriter::write_cell_data(const Function& u, std::string filename,
   const std::size_t num_cells = mesh.num_cells();
 
   std::string encode_string;
-  if (!binary)
+  if (appended)
+    encode_string = "appended";
+  else if (!binary)
     encode_string = "ascii";
   else
     encode_string = "binary";
@@ -90,7 +104,7 @@ void VTKWriter::write_cell_data(const Function& u, std::string filename,
   {
     fp << "<CellData  Scalars=\"" << u.name() << "\"> " << std::endl;
     fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name() << "\"  format=\""
-       << encode_string <<"\">";
+       << encode_string <<"\"";
   }
   else if (rank == 1)
   {
@@ -102,7 +116,7 @@ void VTKWriter::write_cell_data(const Function& u, std::string filename,
     }
     fp << "<CellData  Vectors=\"" << u.name() << "\"> " << std::endl;
     fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"3\" format=\""<< encode_string <<"\">";
+       << "\"  NumberOfComponents=\"3\" format=\""<< encode_string <<"\"";
   }
   else if (rank == 2)
   {
@@ -114,7 +128,7 @@ void VTKWriter::write_cell_data(const Function& u, std::string filename,
     }
     fp << "<CellData  Tensors=\"" << u.name() << "\"> " << std::endl;
     fp << "<DataArray  type=\"Float64\"  Name=\"" << u.name()
-       << "\"  NumberOfComponents=\"9\" format=\""<< encode_string <<"\">";
+       << "\"  NumberOfComponents=\"9\" format=\""<< encode_string <<"\"";
   }
 
   // Allocate memory for function values at cell centres
@@ -142,11 +156,20 @@ void VTKWriter::write_cell_data(const Function& u, std::string filename,
   u.vector()->get_local(values.data(), dof_set.size(), dof_set.data());
 
   // Get cell data
-  if (!binary)
-    fp << ascii_cell_data(mesh, offset, values, data_dim, rank);
+  if (appended)
+  {
+    fp << " offset=\""
+       << appended->append(binary_cell_data(mesh, offset, values, data_dim,
+                                            rank))
+       << "\">";
+  }
+  else if (!binary)
+    fp << ">" << ascii_cell_data(mesh, offset, values, data_dim, rank);
   else
   {
-    fp << base64_cell_data(mesh, offset, values, data_dim, rank, compress)
+    fp << ">"
+       << encode_stream(binary_cell_data(mesh, offset, values, data_dim, rank),
+                        compress)
        << std::endl;
   }
   fp << "</DataArray> " << std::endl;
@@ -196,11 +219,11 @@ std::string VTKWriter::ascii_cell_data(const Mesh& mesh,
   return ss.str();
 }
 //----------------------------------------------------------------------------
-std::string VTKWriter::base64_cell_data(const Mesh& mesh,
-                                        const std::vector<std::size_t>& offset,
-                                        const std::vector<double>& values,
-                                        std::size_t data_dim, std::size_t rank,
-                                        bool compress)
+std::vector<double>
+VTKWriter::binary_cell_data(const Mesh& mesh,
+                            const std::vector<std::size_t>& offset,
+                            const std::vector<double>& values,
+                            std::size_t data_dim, std::size_t rank)
 {
   const std::size_t num_cells = mesh.num_cells();
 
@@ -225,7 +248,7 @@ std::string VTKWriter::base64_cell_data(const Mesh& mesh,
     ++cell_offset;
   }
 
-  return encode_stream(data, compress);
+  return data;
 }
 //----------------------------------------------------------------------------
 void VTKWriter::write_ascii_mesh(const Mesh& mesh, std::size_t cell_dim,
@@ -292,11 +315,12 @@ void VTKWriter::write_ascii_mesh(const Mesh& mesh, std::size_t cell_dim,
 void VTKWriter::write_base64_mesh(const Mesh& mesh, std::size_t cell_dim,
                                   std::string filename, bool compress)
 {
-  const std::size_t num_cells = mesh.topology().size(cell_dim);
-  const std::size_t num_cell_vertices = mesh.type().num_vertices(cell_dim);
-
-  // Get VTK cell type
-  const boost::uint8_t _vtk_cell_type = vtk_cell_type(mesh, cell_dim);
+  // Compute mesh arrays
+  std::vector<double> vertex_data;
+  std::vector<boost::uint32_t> cell_data, offset_data;
+  std::vector<boost::uint8_t> type_data;
+  compute_mesh_data(mesh, cell_dim, vertex_data, cell_data, offset_data,
+                    type_data);
 
   // Open file
   std::ofstream file(filename.c_str(), std::ios::app);
@@ -312,16 +336,6 @@ void VTKWriter::write_base64_mesh(const Mesh& mesh, std::size_t cell_dim,
   file << "<Points>" << std::endl;
   file << "<DataArray  type=\"Float64\"  NumberOfComponents=\"3\"  format=\""
        << "binary" << "\">" << std::endl;
-  std::vector<double> vertex_data(3*mesh.num_vertices());
-  std::vector<double>::iterator vertex_entry = vertex_data.begin();
-  for (VertexIterator v(mesh); !v.end(); ++v)
-  {
-    const Point p = v->point();
-    *vertex_entry++ = p.x();
-    *vertex_entry++ = p.y();
-    *vertex_entry++ = p.z();
-  }
-  // Create encoded stream
   file <<  encode_stream(vertex_data, compress) << std::endl;
   file << "</DataArray>" << std::endl <<  "</Points>" << std::endl;
 
@@ -329,48 +343,225 @@ void VTKWriter::write_base64_mesh(const Mesh& mesh, std::size_t cell_dim,
   file << "<Cells>" << std::endl;
   file << "<DataArray  type=\"UInt32\"  Name=\"connectivity\"  format=\""
        << "binary" << "\">" << std::endl;
-  const int size = num_cells*num_cell_vertices;
-  std::vector<boost::uint32_t> cell_data(size);
-  std::vector<boost::uint32_t>::iterator cell_entry = cell_data.begin();
-  for (MeshEntityIterator c(mesh, cell_dim); !c.end(); ++c)
-  {
-    for (VertexIterator v(*c); !v.end(); ++v)
-      *cell_entry++ = v->index();
-  }
-
-  // Create encoded stream
   file << encode_stream(cell_data, compress) << std::endl;
   file << "</DataArray>" << std::endl;
 
   // Write offset into connectivity array for the end of each cell
   file << "<DataArray  type=\"UInt32\"  Name=\"offsets\"  format=\""
        << "binary" << "\">" << std::endl;
-  std::vector<boost::uint32_t> offset_data(num_cells*num_cell_vertices);
-  std::vector<boost::uint32_t>::iterator offset_entry = offset_data.begin();
-  for (std::size_t offsets = 1; offsets <= num_cells; offsets++)
-    *offset_entry++ = offsets*num_cell_vertices;
-
-  // Create encoded stream
   file << encode_stream(offset_data, compress) << std::endl;
   file << "</DataArray>" << std::endl;
 
   // Write cell type
   file << "<DataArray  type=\"UInt8\"  Name=\"types\"  format=\"" << "binary"
        << "\">" << std::endl;
-  std::vector<boost::uint8_t> type_data(num_cells);
-  std::vector<boost::uint8_t>::iterator type_entry = type_data.begin();
-  for (std::size_t types = 0; types < num_cells; types++)
-    *type_entry++ = _vtk_cell_type;
-
-  // Create encoded stream
   file << encode_stream(type_data, compress) << std::endl;
-
   file  << "</DataArray>" << std::endl;
   file  << "</Cells>" << std::endl;
 
   // Close file
   file.close();
 }
+//-----------------------------------------------------------------------------
+void VTKWriter::write_appended_mesh(const Mesh& mesh, std::size_t cell_dim,
+                                    std::string filename,
+                                    VTKAppendedData& appended)
+{
+  // Append mesh arrays, reusing the encoded arrays if the same mesh
+  // was written to a previous file of the series
+  std::vector<std::size_t> offsets;
+  const std::size_t signature = mesh_signature(mesh, cell_dim);
+  if (!appended.append_mesh(signature, offsets))
+  {
+    std::vector<double> vertex_data;
+    std::vector<boost::uint32_t> cell_data, offset_data;
+    std::vector<boost::uint8_t> type_data;
+    compute_mesh_data(mesh, cell_dim, vertex_data, cell_data, offset_data,
+                      type_data);
+    offsets.push_back(appended.append(vertex_data));
+    offsets.push_back(appended.append(cell_data));
+    offsets.push_back(appended.append(offset_data));
+    offsets.push_back(appended.append(type_data));
+    appended.cache_mesh(signature, offsets.size());
+  }
+  dolfin_assert(offsets.size() == 4);
+
+  // Open file
+  std::ofstream file(filename.c_str(), std::ios::app);
+  if (!file.is_open())
+  {
+    dolfin_error("VTKWriter.cpp",
+                 "write mesh to VTK file",
+                 "Unable to open file \"%s\"", filename.c_str());
+  }
+
+  // Write vertex positions
+  file << "<Points>" << std::endl;
+  file << "<DataArray  type=\"Float64\"  NumberOfComponents=\"3\"  format=\""
+       << "appended" << "\"  offset=\"" << offsets[0] << "\"/>" << std::endl;
+  file << "</Points>" << std::endl;
+
+  // Write cell connectivity, offsets and types
+  file << "<Cells>" << std::endl;
+  file << "<DataArray  type=\"UInt32\"  Name=\"connectivity\"  format=\""
+       << "appended" << "\"  offset=\"" << offsets[1] << "\"/>" << std::endl;
+  file << "<DataArray  type=\"UInt32\"  Name=\"offsets\"  format=\""
+       << "appended" << "\"  offset=\"" << offsets[2] << "\"/>" << std::endl;
+  file << "<DataArray  type=\"UInt8\"  Name=\"types\"  format=\""
+       << "appended" << "\"  offset=\"" << offsets[3] << "\"/>" << std::endl;
+  file  << "</Cells>" << std::endl;
+
+  // Close file
+  file.close();
+}
+//-----------------------------------------------------------------------------
+void VTKWriter::compute_mesh_data(const Mesh& mesh, std::size_t cell_dim,
+                                  std::vector<double>& vertex_data,
+                                  std::vector<boost::uint32_t>& cell_data,
+                                  std::vector<boost::uint32_t>& offset_data,
+                                  std::vector<boost::uint8_t>& type_data)
+{
+  mesh.init(cell_dim);
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t num_vertices = mesh.num_vertices();
+  const std::size_t num_cells = mesh.topology().size(cell_dim);
+  const std::size_t num_cell_vertices = mesh.type().num_vertices(cell_dim);
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+
+  // Vertex positions (padded to 3D)
+  vertex_data.assign(3*num_vertices, 0.0);
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int i = 0; i < (int) num_vertices; ++i)
+  {
+    const double* x = mesh.geometry().x(i);
+    for (std::size_t j = 0; j < gdim; ++j)
+      vertex_data[3*i + j] = x[j];
+  }
+
+  // Cell connectivity and offset into connectivity array for the
+  // end of each cell
+  cell_data.resize(num_cells*num_cell_vertices);
+  offset_data.resize(num_cells);
+  if (cell_dim == 0)
+  {
+    for (std::size_t i = 0; i < num_cells; ++i)
+      cell_data[i] = i;
+  }
+  else
+  {
+    const MeshConnectivity& connectivity = mesh.topology()(cell_dim, 0);
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    #endif
+    for (int i = 0; i < (int) num_cells; ++i)
+    {
+      const unsigned int* vertices = connectivity(i);
+      for (std::size_t j = 0; j < num_cell_vertices; ++j)
+        cell_data[i*num_cell_vertices + j] = vertices[j];
+    }
+  }
+  for (std::size_t i = 0; i < num_cells; ++i)
+    offset_data[i] = (i + 1)*num_cell_vertices;
+
+  // Cell types
+  type_data.assign(num_cells, vtk_cell_type(mesh, cell_dim));
+}
+//-----------------------------------------------------------------------------
+std::size_t VTKWriter::mesh_signature(const Mesh& mesh, std::size_t cell_dim)
+{
+  std::size_t signature = 0;
+  boost::hash_combine(signature, mesh.id());
+  boost::hash_combine(signature, cell_dim);
+  boost::hash_combine(signature, mesh.num_vertices());
+  boost::hash_combine(signature, mesh.topology().size(cell_dim));
+  boost::hash_combine(signature, mesh.version());
+
+  return signature;
+}
+//-----------------------------------------------------------------------------
+std::string VTKWriter::encode_base64(const char* data, std::size_t size)
+{
+  // Encode chunks of a whole number of 3-byte groups, so that the
+  // encoded chunks can be concatenated without padding
+  const std::size_t chunk_size = 3*(1 << 18);
+  const std::size_t num_chunks = (size + chunk_size - 1)/chunk_size;
+  std::vector<std::string> chunks(num_chunks);
+
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int i = 0; i < (int) num_chunks; ++i)
+  {
+    const std::size_t begin = i*chunk_size;
+    const std::size_t n = std::min(chunk_size, size - begin);
+    chunks[i] = base64_encode((const unsigned char*) data + begin, n);
+  }
+
+  std::string encoded;
+  encoded.reserve(4*((size + 2)/3));
+  for (std::size_t i = 0; i < num_chunks; ++i)
+    encoded += chunks[i];
+  return encoded;
+}
+//-----------------------------------------------------------------------------
+void VTKWriter::compress_blocks(const char* data, std::size_t size,
+                                std::vector<char>& compressed,
+                                std::vector<std::size_t>& block_sizes)
+{
+  #ifdef HAS_ZLIB
+  const std::size_t num_blocks
+    = (size + compression_block_size - 1)/compression_block_size;
+  block_sizes.resize(num_blocks);
+
+  // Compress each block into its own slot of the output array
+  const std::size_t max_block_size = compressBound(compression_block_size);
+  compressed.resize(num_blocks*max_block_size);
+
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  #endif
+  for (int i = 0; i < (int) num_blocks; ++i)
+  {
+    const std::size_t begin = i*compression_block_size;
+    const std::size_t n = std::min(compression_block_size, size - begin);
+    uLongf compressed_size = max_block_size;
+    if (compress2((Bytef*) compressed.data() + i*max_block_size,
+                  &compressed_size, (const Bytef*) data + begin, n,
+                  Z_DEFAULT_COMPRESSION) != Z_OK)
+    {
+      compressed_size = 0;
+    }
+    block_sizes[i] = compressed_size;
+  }
+
+  // Move compressed blocks together (a compressed block is never
+  // empty, so zero size marks an error)
+  std::size_t position = 0;
+  for (std::size_t i = 0; i < num_blocks; ++i)
+  {
+    if (block_sizes[i] == 0)
+    {
+      dolfin_error("VTKWriter.cpp",
+                   "compress data when writing file",
+                   "Zlib error while compressing data");
+    }
+    std::memmove(compressed.data() + position,
+                 compressed.data() + i*max_block_size, block_sizes[i]);
+    position += block_sizes[i];
+  }
+  compressed.resize(position);
+  #else
+  dolfin_error("VTKWriter.cpp",
+               "compress data when writing file",
+               "zlib must be configured to enable compressed output");
+  #endif
+}
 //----------------------------------------------------------------------------
 boost::uint8_t VTKWriter::vtk_cell_type(const Mesh& mesh,
                                         std::size_t cell_dim)
@@ -16,11 +16,12 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2010-07-19
-// Last changed:
+// Last changed: 2026-10-19
 
 #ifndef __VTK_WRITER_H
 #define __VTK_WRITER_H
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <boost/cstdint.hpp>
@@ -31,40 +32,62 @@ namespace dolfin
 
   class Function;
   class Mesh;
+  class VTKAppendedData;
 
   class VTKWriter
   {
   public:
 
-    // Mesh writer
+    // Mesh writer. Arrays are added to appended data if appended
+    // is not null.
     static void write_mesh(const Mesh& mesh, std::size_t cell_dim,
                            std::string file,
-                           bool binary, bool compress);
+                           bool binary, bool compress,
+                           VTKAppendedData* appended=NULL);
 
-    // Cell data writer
+    // Cell data writer. Arrays are added to appended data if
+    // appended is not null.
     static void write_cell_data(const Function& u, std::string file,
-                                bool binary, bool compress);
+                                bool binary, bool compress,
+                                VTKAppendedData* appended=NULL);
 
     // Form (compressed) base64 encoded string for VTK
     template<typename T>
     static std::string encode_stream(const std::vector<T>& data,
                                      bool compress);
+
   //friend class VTKFile;
 
   private:
 
+    // VTKAppendedData uses the base64 and block compression helpers
+    friend class VTKAppendedData;
+
+    // Size of blocks of uncompressed data for compressed output
+    static const std::size_t compression_block_size = 1 << 20;
+
+    // Base64 encode bytes (chunks are encoded by several threads)
+    static std::string encode_base64(const char* data, std::size_t size);
+
+    // Compress bytes with zlib in blocks of compression_block_size
+    // bytes (blocks are compressed by several threads). The
+    // compressed blocks are stored one after another.
+    static void compress_blocks(const char* data, std::size_t size,
+                                std::vector<char>& compressed,
+                                std::vector<std::size_t>& block_sizes);
+
     // Write cell data (ascii)
     static std::string ascii_cell_data(const Mesh& mesh,
                                        const std::vector<std::size_t>& offset,
                                        const std::vector<double>& values,
                                        std::size_t dim, std::size_t rank);
 
-    // Write cell data (base64)
-    static std::string base64_cell_data(const Mesh& mesh,
-                                        const std::vector<std::size_t>& offset,
-                                        const std::vector<double>& values,
-                                        std::size_t dim, std::size_t rank,
-                                        bool compress);
+    // Compute cell data padded to 3D for binary output
+    static std::vector<double>
+      binary_cell_data(const Mesh& mesh,
+                       const std::vector<std::size_t>& offset,
+                       const std::vector<double>& values,
+                       std::size_t dim, std::size_t rank);
 
     // Mesh writer (ascii)
     static void write_ascii_mesh(const Mesh& mesh, std::size_t cell_dim,
@@ -74,6 +97,23 @@ namespace dolfin
     static void write_base64_mesh(const Mesh& mesh, std::size_t cell_dim,
                                   std::string file, bool compress);
 
+    // Mesh writer (appended)
+    static void write_appended_mesh(const Mesh& mesh, std::size_t cell_dim,
+                                    std::string file,
+                                    VTKAppendedData& appended);
+
+    // Compute vertex coordinates (padded to 3D), connectivity,
+    // offsets and cell types for binary output
+    static void compute_mesh_data(const Mesh& mesh, std::size_t cell_dim,
+                                  std::vector<double>& vertex_data,
+                                  std::vector<boost::uint32_t>& cell_data,
+                                  std::vector<boost::uint32_t>& offset_data,
+                                  std::vector<boost::uint8_t>& type_data);
+
+    // Compute signature identifying a mesh and its version, used to
+    // reuse encoded mesh arrays
+    static std::size_t mesh_signature(const Mesh& mesh, std::size_t cell_dim);
+
     // Get VTK cell type
     static boost::uint8_t vtk_cell_type(const Mesh& mesh, std::size_t cell_dim);
 
@@ -111,13 +151,9 @@ namespace dolfin
   template<typename T>
   std::string VTKWriter::encode_inline_base64(const std::vector<T>& data)
   {
-    std::stringstream stream;
-
     const boost::uint32_t size = data.size()*sizeof(T);
-    Encoder::encode_base64(&size, 1, stream);
-    Encoder::encode_base64(data, stream);
-
-    return stream.str();
+    return encode_base64((const char*) &size, sizeof(size))
+      + encode_base64((const char*) data.data(), size);
   }
   //--------------------------------------------------------------------------
   #ifdef HAS_ZLIB
@@ -125,28 +161,25 @@ namespace dolfin
   std::string VTKWriter::encode_inline_compressed_base64(const std::vector<T>&
                                                          data)
   {
-    std::stringstream stream;
-
-    boost::uint32_t header[4];
-    header[0] = 1;
-    header[1] = data.size()*sizeof(T);
-    header[2] = 0;
-
     // Compress data
-    std::pair<boost::shared_array<unsigned char>, std::size_t>
-      compressed_data = Encoder::compress_data(data);
-
-    // Length of compressed data
-    header[3] = compressed_data.second;
-
-    // Encode header
-    Encoder::encode_base64(&header[0], 4, stream);
-
-    // Encode data
-    Encoder::encode_base64(compressed_data.first.get(),
-                           compressed_data.second, stream);
-
-    return stream.str();
+    const std::size_t size = data.size()*sizeof(T);
+    std::vector<char> compressed_data;
+    std::vector<std::size_t> block_sizes;
+    compress_blocks((const char*) data.data(), size, compressed_data,
+                    block_sizes);
+
+    // Header: number of blocks, block size, size of last (partial)
+    // block and compressed size of each block
+    std::vector<boost::uint32_t> header(3 + block_sizes.size());
+    header[0] = block_sizes.size();
+    header[1] = compression_block_size;
+    header[2] = size % compression_block_size;
+    std::copy(block_sizes.begin(), block_sizes.end(), header.begin() + 3);
+
+    // Encode header and data
+    return encode_base64((const char*) header.data(),
+                         header.size()*sizeof(boost::uint32_t))
+      + encode_base64(compressed_data.data(), compressed_data.size());
   }
   #endif
   //--------------------------------------------------------------------------
@@ -18,11 +18,13 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2006-07-02
-// Last changed: 2011-11-14
+// Last changed: 2026-10-19
 
 #ifndef __XMLARRAY_H
 #define __XMLARRAY_H
 
+#include <cctype>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -30,7 +32,9 @@
 #include <boost/lexical_cast.hpp>
 #include "dolfin/common/Array.h"
 #include "dolfin/log/log.h"
+#include "dolfin/parameter/GlobalParameters.h"
 #include "pugixml.hpp"
+#include "Encoder.h"
 
 namespace pugi
 {
@@ -53,6 +57,26 @@ namespace dolfin
     static void write(const std::vector<T>& x, const std::string type,
                       pugi::xml_node xml_node);
 
+    /// Return true if the data of XML node is base64 encoded
+    static bool base64_encoded(const pugi::xml_node xml_node)
+    { return std::string(xml_node.attribute("encoding").value()) == "base64"; }
+
+    /// Return true if arrays should be written base64 encoded
+    /// (parameter "xml_array_encoding")
+    static bool write_base64()
+    { return std::string(parameters["xml_array_encoding"]) == "base64"; }
+
+    /// Read values offset, ..., offset + n - 1 of a base64 encoded
+    /// array stored as the text of XML node
+    template<typename T>
+    static void read_base64(T* x, std::size_t offset, std::size_t n,
+                            const pugi::xml_node xml_node);
+
+    /// Store array as base64 encoded text of XML node
+    template<typename T>
+    static void write_base64(const T* x, std::size_t n,
+                             pugi::xml_node xml_node);
+
   };
 
   //---------------------------------------------------------------------------
@@ -78,8 +102,15 @@ namespace dolfin
                    "XML I/O of Array objects only supported when the value type is 'double'");
     }
 
-    // Iterate over array entries
+    // Decode binary data
     x.resize(size);
+    if (base64_encoded(array))
+    {
+      read_base64(x.data(), 0, size, array);
+      return;
+    }
+
+    // Iterate over array entries
     Array<std::size_t> indices(size);
     for (pugi::xml_node_iterator it = array.begin(); it != array.end(); ++it)
     {
@@ -103,6 +134,13 @@ namespace dolfin
     array_node.append_attribute("type") = type.c_str();
     array_node.append_attribute("size") = (unsigned int) size;
 
+    // Add binary data
+    if (write_base64())
+    {
+      write_base64(x.data(), size, array_node);
+      return;
+    }
+
     // Add data
     for (std::size_t i = 0; i < size; ++i)
     {
@@ -115,6 +153,34 @@ namespace dolfin
     }
   }
   //---------------------------------------------------------------------------
+  template<typename T>
+  void XMLArray::read_base64(T* x, std::size_t offset, std::size_t n,
+                             const pugi::xml_node xml_node)
+  {
+    // Get text without whitespace
+    const char* text = xml_node.child_value();
+    const std::size_t length = std::strlen(text);
+    std::string encoded;
+    encoded.reserve(length);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      if (!std::isspace((unsigned char) text[i]))
+        encoded += text[i];
+    }
+
+    Encoder::decode_base64(encoded.data(), encoded.size(), offset, n, x);
+  }
+  //---------------------------------------------------------------------------
+  template<typename T>
+  void XMLArray::write_base64(const T* x, std::size_t n,
+                              pugi::xml_node xml_node)
+  {
+    xml_node.append_attribute("encoding") = "base64";
+    std::stringstream encoded;
+    Encoder::encode_base64(x, n, encoded);
+    xml_node.append_child(pugi::node_pcdata).set_value(encoded.str().c_str());
+  }
+  //---------------------------------------------------------------------------
 }
 
 #endif
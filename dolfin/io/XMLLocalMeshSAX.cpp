@@ -18,8 +18,11 @@
 // Modified by Anders Logg 2008-2011
 //
 // First added:  2008-11-28
-// Last changed: 2012-11-26
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
 #include <iostream>
 
 #include <map>
@@ -32,6 +35,7 @@
 #include <dolfin/log/log.h>
 #include <dolfin/mesh/CellType.h>
 #include <dolfin/mesh/LocalMeshData.h>
+#include "Encoder.h"
 #include "SAX2AttributeParser.h"
 #include "XMLLocalMeshSAX.h"
 
@@ -40,7 +44,8 @@ using namespace dolfin;
 //-----------------------------------------------------------------------------
 XMLLocalMeshSAX::XMLLocalMeshSAX(MPI_Comm mpi_comm, LocalMeshData& mesh_data,
                                  const std::string filename)
-  : gdim(0), tdim(0), domain_value_counter(0),
+  : gdim(0), tdim(0), _base64(false), _encoded_offset(0),
+    domain_value_counter(0),
     domain_dim(0),
     _mpi_comm(mpi_comm),
     _mesh_data(mesh_data),
@@ -66,6 +71,7 @@ void XMLLocalMeshSAX::read()
 
   sax_handler.startElementNs = XMLLocalMeshSAX::sax_start_element;
   sax_handler.endElementNs   = XMLLocalMeshSAX::sax_end_element;
+  sax_handler.characters     = XMLLocalMeshSAX::sax_characters;
 
   sax_handler.warning = XMLLocalMeshSAX::sax_warning;
   sax_handler.error = XMLLocalMeshSAX::sax_error;
@@ -199,12 +205,20 @@ void XMLLocalMeshSAX::end_element(const xmlChar *name)
 
   case INSIDE_VERTICES:
     if (xmlStrcasecmp(name, (xmlChar* ) "vertices") == 0)
+    {
+      if (_base64)
+        read_encoded_vertices();
       state = INSIDE_MESH;
+    }
     break;
 
   case INSIDE_CELLS:
     if (xmlStrcasecmp(name, (xmlChar* ) "cells") == 0)
+    {
+      if (_base64)
+        read_encoded_cells();
       state = INSIDE_MESH;
+    }
     break;
 
   case INSIDE_DATA:
@@ -276,6 +290,29 @@ void XMLLocalMeshSAX::sax_end_element(void* ctx,
   ((XMLLocalMeshSAX*) ctx)->end_element(name);
 }
 //-----------------------------------------------------------------------------
+void XMLLocalMeshSAX::sax_characters(void* ctx, const xmlChar* ch, int len)
+{
+  XMLLocalMeshSAX& reader = *((XMLLocalMeshSAX*) ctx);
+  if (!reader._base64)
+    return;
+  if (reader.state != INSIDE_VERTICES && reader.state != INSIDE_CELLS)
+    return;
+
+  // Store encoded data in the local range, skipping whitespace
+  const std::pair<std::size_t, std::size_t>& range = reader._encoded_range;
+  for (int i = 0; i < len; ++i)
+  {
+    if (std::isspace(ch[i]))
+      continue;
+    if (reader._encoded_offset >= range.first
+        && reader._encoded_offset < range.second)
+    {
+      reader._encoded_data += (char) ch[i];
+    }
+    ++reader._encoded_offset;
+  }
+}
+//-----------------------------------------------------------------------------
 void XMLLocalMeshSAX::sax_warning(void *ctx, const char *msg, ...)
 {
   va_list args;
@@ -346,6 +383,14 @@ void XMLLocalMeshSAX::read_vertices(const xmlChar* name, const xmlChar** attrs,
   // Reserve space for local-to-global vertex map and vertex coordinates
   _mesh_data.vertex_indices.reserve(num_local_vertices());
   _mesh_data.vertex_coordinates.resize(boost::extents[num_local_vertices()][_mesh_data.gdim]);
+
+  // Check for base64 encoded data
+  _base64 = SAX2AttributeParser::parse_optional<std::string>(name, attrs,
+              "encoding", num_attributes, "ascii") == "base64";
+  _encoded_range = Encoder::base64_range<double>(vertex_range.first*gdim,
+                                                 num_local_vertices()*gdim);
+  _encoded_offset = 0;
+  _encoded_data.clear();
 }
 //-----------------------------------------------------------------------------
 void XMLLocalMeshSAX::read_vertex(const xmlChar* name, const xmlChar** attrs,
@@ -391,6 +436,16 @@ void XMLLocalMeshSAX::read_cells(const xmlChar* name, const xmlChar** attrs,
 
   // Reserve space for global cell indices
   _mesh_data.global_cell_indices.reserve(num_local_cells());
+
+  // Check for base64 encoded data
+  _base64 = SAX2AttributeParser::parse_optional<std::string>(name, attrs,
+              "encoding", num_attributes, "ascii") == "base64";
+  const std::size_t num_vertices_per_cell = tdim + 1;
+  _encoded_range = Encoder::base64_range<std::uint64_t>(
+    cell_range.first*num_vertices_per_cell,
+    num_local_cells()*num_vertices_per_cell);
+  _encoded_offset = 0;
+  _encoded_data.clear();
 }
 //-----------------------------------------------------------------------------
 void XMLLocalMeshSAX::read_interval(const xmlChar* name, const xmlChar** attrs,
@@ -505,6 +560,46 @@ void XMLLocalMeshSAX::read_tetrahedron(const xmlChar *name,
   _mesh_data.num_vertices_per_cell = 4;
 }
 //-----------------------------------------------------------------------------
+void XMLLocalMeshSAX::read_encoded_vertices()
+{
+  // Decode coordinates of vertices in range for this process only
+  const std::size_t n = num_local_vertices();
+  Encoder::decode_base64(_encoded_data.data(), _encoded_data.size(),
+                         vertex_range.first*gdim, n*gdim,
+                         _mesh_data.vertex_coordinates.data(),
+                         _encoded_range.first);
+  _encoded_data.clear();
+
+  // Store global vertex numbering
+  _mesh_data.vertex_indices.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+    _mesh_data.vertex_indices[i] = vertex_range.first + i;
+}
+//-----------------------------------------------------------------------------
+void XMLLocalMeshSAX::read_encoded_cells()
+{
+  // Decode vertices (64-bit integers) of cells in range for this
+  // process only
+  const std::size_t n = num_local_cells();
+  const std::size_t num_vertices_per_cell = tdim + 1;
+  std::vector<std::uint64_t> cell_vertices(n*num_vertices_per_cell);
+  Encoder::decode_base64(_encoded_data.data(), _encoded_data.size(),
+                         cell_range.first*num_vertices_per_cell,
+                         cell_vertices.size(), cell_vertices.data(),
+                         _encoded_range.first);
+  _encoded_data.clear();
+  std::copy(cell_vertices.begin(), cell_vertices.end(),
+            _mesh_data.cell_vertices.data());
+
+  // Add global cell indices
+  _mesh_data.global_cell_indices.resize(n);
+  for (std::size_t i = 0; i < n; ++i)
+    _mesh_data.global_cell_indices[i] = cell_range.first + i;
+
+  // Vertices per cell
+  _mesh_data.num_vertices_per_cell = num_vertices_per_cell;
+}
+//-----------------------------------------------------------------------------
 void XMLLocalMeshSAX::read_mesh_value_collection(const xmlChar* name,
                                                  const xmlChar** attrs,
                                                  std::size_t num_attributes)
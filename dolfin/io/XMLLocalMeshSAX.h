@@ -18,7 +18,7 @@
 // Modified by Kent-Andre Mardal, 2011.
 //
 // First added:  2009-03-10
-// Last changed: 2011-09-17
+// Last changed: 2026-10-19
 
 #ifndef __XMLLOCALMESHDATASAX_H
 #define __XMLLOCALMESHDATASAX_H
@@ -76,6 +76,8 @@ namespace dolfin
                                 const xmlChar* URI);
 
 
+    static void sax_characters(void* ctx, const xmlChar* ch, int len);
+
     static void sax_warning     (void *ctx, const char *msg, ...);
     static void sax_error       (void *ctx, const char *msg, ...);
     static void sax_fatal_error (void *ctx, const char *msg, ...);
@@ -96,6 +98,10 @@ namespace dolfin
     void read_tetrahedron(const xmlChar* name, const xmlChar** attrs,
                           std::size_t num_attributes);
 
+    // Read local vertices and cells from base64 encoded data
+    void read_encoded_vertices();
+    void read_encoded_cells();
+
     void read_mesh_value_collection(const xmlChar* name, const xmlChar** attrs,
                                     std::size_t num_attributes);
     void read_mesh_value_collection_entry(const xmlChar* name,
@@ -120,6 +126,15 @@ namespace dolfin
     // Range for cells
     std::pair<std::size_t, std::size_t> cell_range;
 
+    // True if vertices or cells being read are base64 encoded
+    bool _base64;
+
+    // Encoded characters (without whitespace) in the range covering
+    // the local vertices or cells, and number of characters read
+    std::string _encoded_data;
+    std::pair<std::size_t, std::size_t> _encoded_range;
+    std::size_t _encoded_offset;
+
     // Range for domain data and counter
     std::pair<std::size_t, std::size_t> domain_value_range;
     std::size_t domain_value_counter;
@@ -18,8 +18,10 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2002-12-06
-// Last changed: 2014-02-06
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <iomanip>
@@ -42,6 +44,8 @@
 #include "dolfin/mesh/MeshEditor.h"
 #include "dolfin/mesh/Vertex.h"
 #include "dolfin/mesh/MeshFunction.h"
+#include "dolfin/parameter/GlobalParameters.h"
+#include "XMLArray.h"
 #include "XMLMeshFunction.h"
 #include "XMLMeshValueCollection.h"
 #include "XMLMesh.h"
@@ -107,16 +111,18 @@ void XMLMesh::read_mesh(Mesh& mesh, const pugi::xml_node mesh_node)
   const std::size_t num_vertices = xml_vertices.attribute("size").as_uint();
   editor.init_vertices_global(num_vertices, num_vertices);
 
-  // Iterate over vertices and add to mesh
+  // Read vertex indices and coordinates
+  std::vector<std::size_t> vertex_indices;
+  std::vector<double> coordinates;
+  read_vertices(vertex_indices, coordinates, xml_vertices, gdim);
+
+  // Add vertices to mesh
   Point p;
-  for (pugi::xml_node_iterator it = xml_vertices.begin();
-       it != xml_vertices.end(); ++it)
+  for (std::size_t i = 0; i < vertex_indices.size(); ++i)
   {
-    const std::size_t index = it->attribute("index").as_uint();
-    p[0] = it->attribute("x").as_double();
-    p[1] = it->attribute("y").as_double();
-    p[2] = it->attribute("z").as_double();
-    editor.add_vertex(index, p);
+    for (std::size_t j = 0; j < gdim; ++j)
+      p[j] = coordinates[i*gdim + j];
+    editor.add_vertex(vertex_indices[i], p);
   }
 
   // Get cells node
@@ -127,27 +133,120 @@ void XMLMesh::read_mesh(Mesh& mesh, const pugi::xml_node mesh_node)
   const std::size_t num_cells = xml_cells.attribute("size").as_uint();
   editor.init_cells_global(num_cells, num_cells);
 
-  // Create list of vertex index attribute names
+  // Read cell indices and vertices
   const unsigned int num_vertices_per_cell = cell_type->num_vertices(tdim);
-  std::vector<std::string> v_str(num_vertices_per_cell);
-  for (std::size_t i = 0; i < num_vertices_per_cell; ++i)
-    v_str[i] = "v" + boost::lexical_cast<std::string, unsigned int>(i);
+  std::vector<std::size_t> cell_indices, cell_vertices;
+  read_cells(cell_indices, cell_vertices, xml_cells, num_vertices_per_cell);
 
-  // Iterate over cells and add to mesh
+  // Add cells to mesh
   std::vector<std::size_t> v(num_vertices_per_cell);
-  for (pugi::xml_node_iterator it = xml_cells.begin(); it != xml_cells.end();
-       ++it)
+  for (std::size_t i = 0; i < cell_indices.size(); ++i)
   {
-    const std::size_t index = it->attribute("index").as_uint();
-    for (unsigned int i = 0; i < num_vertices_per_cell; ++i)
-      v[i] = it->attribute(v_str[i].c_str()).as_uint();
-    editor.add_cell(index, v);
+    std::copy(cell_vertices.begin() + i*num_vertices_per_cell,
+              cell_vertices.begin() + (i + 1)*num_vertices_per_cell,
+              v.begin());
+    editor.add_cell(cell_indices[i], v);
   }
 
   // Close mesh editor
   editor.close();
 }
 //-----------------------------------------------------------------------------
+void XMLMesh::read_vertices(std::vector<std::size_t>& indices,
+                            std::vector<double>& coordinates,
+                            const pugi::xml_node xml_vertices,
+                            std::size_t gdim)
+{
+  const std::size_t num_vertices = xml_vertices.attribute("size").as_uint();
+
+  // Binary data: coordinates of all vertices in order
+  if (XMLArray::base64_encoded(xml_vertices))
+  {
+    indices.resize(num_vertices);
+    for (std::size_t i = 0; i < num_vertices; ++i)
+      indices[i] = i;
+    coordinates.resize(num_vertices*gdim);
+    XMLArray::read_base64(coordinates.data(), 0, coordinates.size(),
+                          xml_vertices);
+    return;
+  }
+
+  // Collect vertex nodes, then parse attributes in parallel
+  std::vector<pugi::xml_node> nodes;
+  nodes.reserve(num_vertices);
+  for (pugi::xml_node_iterator it = xml_vertices.begin();
+       it != xml_vertices.end(); ++it)
+  {
+    nodes.push_back(*it);
+  }
+
+  indices.resize(nodes.size());
+  coordinates.resize(nodes.size()*gdim);
+  const char* xyz[] = {"x", "y", "z"};
+  const int num_nodes = nodes.size();
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int i = 0; i < num_nodes; ++i)
+  {
+    indices[i] = nodes[i].attribute("index").as_uint();
+    for (std::size_t j = 0; j < gdim; ++j)
+      coordinates[i*gdim + j] = nodes[i].attribute(xyz[j]).as_double();
+  }
+}
+//-----------------------------------------------------------------------------
+void XMLMesh::read_cells(std::vector<std::size_t>& indices,
+                         std::vector<std::size_t>& vertices,
+                         const pugi::xml_node xml_cells,
+                         std::size_t num_vertices_per_cell)
+{
+  const std::size_t num_cells = xml_cells.attribute("size").as_uint();
+
+  // Binary data: vertices of all cells in order, as 64-bit integers
+  if (XMLArray::base64_encoded(xml_cells))
+  {
+    indices.resize(num_cells);
+    for (std::size_t i = 0; i < num_cells; ++i)
+      indices[i] = i;
+    std::vector<std::uint64_t> data(num_cells*num_vertices_per_cell);
+    XMLArray::read_base64(data.data(), 0, data.size(), xml_cells);
+    vertices.assign(data.begin(), data.end());
+    return;
+  }
+
+  // Collect cell nodes, then parse attributes in parallel
+  std::vector<pugi::xml_node> nodes;
+  nodes.reserve(num_cells);
+  for (pugi::xml_node_iterator it = xml_cells.begin(); it != xml_cells.end();
+       ++it)
+  {
+    nodes.push_back(*it);
+  }
+
+  // Create list of vertex index attribute names
+  std::vector<std::string> v_str(num_vertices_per_cell);
+  for (std::size_t i = 0; i < num_vertices_per_cell; ++i)
+    v_str[i] = "v" + boost::lexical_cast<std::string, unsigned int>(i);
+
+  indices.resize(nodes.size());
+  vertices.resize(nodes.size()*num_vertices_per_cell);
+  const int num_nodes = nodes.size();
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int i = 0; i < num_nodes; ++i)
+  {
+    indices[i] = nodes[i].attribute("index").as_uint();
+    for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+    {
+      vertices[i*num_vertices_per_cell + j]
+        = nodes[i].attribute(v_str[j].c_str()).as_uint();
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void XMLMesh::read_data(MeshData& data, const Mesh& mesh,
                         const pugi::xml_node mesh_node)
 {
@@ -365,6 +464,30 @@ void XMLMesh::write_mesh(const Mesh& mesh, pugi::xml_node mesh_node)
   pugi::xml_node vertices_node = mesh_node.append_child("vertices");
   vertices_node.append_attribute("size") = (unsigned int) mesh.num_vertices();
 
+  // Write vertex coordinates and cell vertices as binary data
+  if (XMLArray::write_base64())
+  {
+    const std::size_t gdim = mesh.geometry().dim();
+    std::vector<double> coordinates(mesh.num_vertices()*gdim);
+    for (VertexIterator v(mesh); !v.end(); ++v)
+      for (std::size_t j = 0; j < gdim; ++j)
+        coordinates[v->index()*gdim + j] = v->x(j);
+    XMLArray::write_base64(coordinates.data(), coordinates.size(),
+                           vertices_node);
+
+    pugi::xml_node cells_node = mesh_node.append_child("cells");
+    cells_node.append_attribute("size") = (unsigned int) mesh.num_cells();
+    const std::size_t num_vertices_per_cell = mesh.type().num_vertices();
+    std::vector<std::uint64_t> cell_vertices(mesh.num_cells()
+                                             *num_vertices_per_cell);
+    for (CellIterator c(mesh); !c.end(); ++c)
+      for (std::size_t j = 0; j < num_vertices_per_cell; ++j)
+        cell_vertices[c->index()*num_vertices_per_cell + j] = c->entities(0)[j];
+    XMLArray::write_base64(cell_vertices.data(), cell_vertices.size(),
+                           cells_node);
+    return;
+  }
+
   // Write each vertex
   for (VertexIterator v(mesh); !v.end(); ++v)
   {
@@ -18,7 +18,7 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2003-07-15
-// Last changed: 2011-09-02
+// Last changed: 2026-10-19
 
 #ifndef __XML_MESH_H
 #define __XML_MESH_H
@@ -55,6 +55,20 @@ namespace dolfin
     static void read_mesh(Mesh& mesh,
                           const pugi::xml_node mesh_node);
 
+    // Read indices and coordinates (gdim per vertex) of vertices,
+    // either base64 encoded or one <vertex> element per vertex
+    static void read_vertices(std::vector<std::size_t>& indices,
+                              std::vector<double>& coordinates,
+                              const pugi::xml_node xml_vertices,
+                              std::size_t gdim);
+
+    // Read indices and vertices of cells, either base64 encoded or
+    // one element per cell
+    static void read_cells(std::vector<std::size_t>& indices,
+                           std::vector<std::size_t>& vertices,
+                           const pugi::xml_node xml_cells,
+                           std::size_t num_vertices_per_cell);
+
     // Read mesh data
     static void read_data(MeshData& data,
                           const Mesh& mesh,
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2002-12-06
-// Last changed: 2011-11-17
+// Last changed: 2026-10-19
 
 #include <iomanip>
 #include <iostream>
@@ -79,9 +79,19 @@ void XMLVector::read(std::vector<double>& x,
                  "size is zero");
   }
 
-  // Iterate over array entries
   x.resize(size);
   indices.resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+    indices[i] = i;
+
+  // Decode binary data
+  if (XMLArray::base64_encoded(array))
+  {
+    XMLArray::read_base64(x.data(), 0, size, array);
+    return;
+  }
+
+  // Iterate over array entries
   for (pugi::xml_node_iterator it = array.begin(); it != array.end(); ++it)
   {
     const std::size_t index = it->attribute("index").as_uint();
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2012-08-20
-// Last changed: 2012-12-12
+// Last changed: 2026-10-19
 
 #ifndef __GENERIC_LINEAR_OPERATOR_H
 #define __GENERIC_LINEAR_OPERATOR_H
@@ -52,6 +52,15 @@ namespace dolfin
     /// Compute matrix-vector product y = Ax
     virtual void mult(const GenericVector& x, GenericVector& y) const = 0;
 
+    /// Compute diagonal of operator. This is optional and used for
+    /// Jacobi preconditioning of operators defined by their action.
+    virtual void get_diagonal(GenericVector& d) const
+    {
+      dolfin_error("GenericLinearOperator.h",
+                   "compute diagonal of linear operator",
+                   "Missing get_diagonal() function for linear operator");
+    }
+
     /// Return informal string representation (pretty-print)
     virtual std::string str(bool verbose) const = 0;
 
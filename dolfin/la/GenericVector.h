@@ -22,7 +22,7 @@
 // Modified by Johan Hake 2009-2010
 //
 // First added:  2006-04-25
-// Last changed: 2011-11-11
+// Last changed: 2026-10-19
 
 #ifndef __GENERIC_VECTOR_H
 #define __GENERIC_VECTOR_H
@@ -218,6 +218,22 @@ namespace dolfin
     /// Add multiple of given vector (AXPY operation)
     virtual void axpy(double a, const GenericVector& x) = 0;
 
+    /// Compute linear combination y = beta*y + sum_i a[i]*x[i] of
+    /// this vector y and the vectors x, which must not include y. If
+    /// beta is zero, the values of y are not read. Backends may
+    /// override this to make a single pass over the data.
+    virtual void maxpy(double beta, const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x)
+    {
+      dolfin_assert(a.size() == x.size());
+      if (beta == 0.0)
+        zero();
+      else if (beta != 1.0)
+        *this *= beta;
+      for (std::size_t i = 0; i < x.size(); ++i)
+        axpy(a[i], *x[i]);
+    }
+
     /// Replace all entries in the vector by their absolute values
     virtual void abs() = 0;
 
@@ -267,6 +283,10 @@ namespace dolfin
     /// Assignment operator
     virtual const GenericVector& operator= (double a) = 0;
 
+    /// Return true if data() gives direct access to the local values
+    virtual bool has_data() const
+    { return false; }
+
     /// Return pointer to underlying data (const version)
     virtual const double* data() const
     {
@@ -0,0 +1,188 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <algorithm>
+#include <dolfin/log/log.h>
+#include "HaloExchange.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+HaloExchange::HaloExchange(MPI_Comm comm,
+                           std::pair<std::size_t, std::size_t> local_range,
+                           const std::vector<std::size_t>& ghosts,
+                           const std::vector<int>& ghost_owners,
+                           std::size_t block_size)
+  : _mpi_comm(comm), _block_size(block_size)
+{
+  dolfin_assert(block_size > 0);
+  dolfin_assert(ghosts.size() == ghost_owners.size());
+  dolfin_assert(local_range.first % block_size == 0);
+  dolfin_assert(local_range.second % block_size == 0);
+  _num_owned_blocks = (local_range.second - local_range.first)/block_size;
+  const std::size_t block_offset = local_range.first/block_size;
+
+  // Order ghosts by owner
+  std::vector<std::pair<int, int> > owner_ghost(ghosts.size());
+  for (std::size_t i = 0; i < ghosts.size(); ++i)
+    owner_ghost[i] = std::make_pair(ghost_owners[i], (int) i);
+  std::sort(owner_ghost.begin(), owner_ghost.end());
+
+  _ghost_offsets.assign(1, 0);
+  _ghost_positions.resize(ghosts.size());
+  std::vector<std::size_t> send_indices(ghosts.size());
+  for (std::size_t i = 0; i < owner_ghost.size(); ++i)
+  {
+    if (_owners.empty() || _owners.back() != owner_ghost[i].first)
+    {
+      _owners.push_back(owner_ghost[i].first);
+      _ghost_offsets.push_back(_ghost_offsets.back());
+    }
+    _ghost_positions[i] = owner_ghost[i].second;
+    send_indices[i] = ghosts[owner_ghost[i].second];
+    ++_ghost_offsets.back();
+  }
+
+  // Send global indices of ghosts to owners, which gives each process
+  // the owned blocks it must send in a forward update
+  std::vector<std::size_t> shared_indices;
+  MPI::neighbor_all_to_all(_mpi_comm, _owners, _ghost_offsets, send_indices,
+                           _sharers, _shared_offsets, shared_indices);
+  _shared_blocks.resize(shared_indices.size());
+  for (std::size_t i = 0; i < shared_indices.size(); ++i)
+  {
+    dolfin_assert(shared_indices[i] >= block_offset);
+    dolfin_assert(shared_indices[i] - block_offset < _num_owned_blocks);
+    _shared_blocks[i] = shared_indices[i] - block_offset;
+  }
+
+  _ghost_buffer.resize(_block_size*_ghost_positions.size());
+  _shared_buffer.resize(_block_size*_shared_blocks.size());
+}
+//-----------------------------------------------------------------------------
+HaloExchange::~HaloExchange()
+{
+  // Complete any exchange in progress
+  MPI::wait_all(_requests);
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::update_begin(const std::vector<double>& x)
+{
+  dolfin_assert(x.size() >= num_owned());
+  dolfin_assert(_requests.empty());
+
+  // Pack owned values
+  const std::size_t bs = _block_size;
+  for (std::size_t i = 0; i < _shared_blocks.size(); ++i)
+    for (std::size_t k = 0; k < bs; ++k)
+      _shared_buffer[bs*i + k] = x[bs*_shared_blocks[i] + k];
+
+  post(true);
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::update_end(std::vector<double>& x)
+{
+  dolfin_assert(x.size() == num_owned() + num_ghosts());
+  MPI::wait_all(_requests);
+
+  // Unpack ghost values
+  const std::size_t bs = _block_size;
+  double* x_ghost = x.data() + num_owned();
+  for (std::size_t i = 0; i < _ghost_positions.size(); ++i)
+    for (std::size_t k = 0; k < bs; ++k)
+      x_ghost[bs*_ghost_positions[i] + k] = _ghost_buffer[bs*i + k];
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::update(std::vector<double>& x)
+{
+  update_begin(x);
+  update_end(x);
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::accumulate_begin(const std::vector<double>& x)
+{
+  dolfin_assert(x.size() == num_owned() + num_ghosts());
+  dolfin_assert(_requests.empty());
+
+  // Pack ghost values
+  const std::size_t bs = _block_size;
+  const double* x_ghost = x.data() + num_owned();
+  for (std::size_t i = 0; i < _ghost_positions.size(); ++i)
+    for (std::size_t k = 0; k < bs; ++k)
+      _ghost_buffer[bs*i + k] = x_ghost[bs*_ghost_positions[i] + k];
+
+  post(false);
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::accumulate_end(std::vector<double>& x)
+{
+  dolfin_assert(x.size() >= num_owned());
+  MPI::wait_all(_requests);
+
+  // Add received values to owned values
+  const std::size_t bs = _block_size;
+  for (std::size_t i = 0; i < _shared_blocks.size(); ++i)
+    for (std::size_t k = 0; k < bs; ++k)
+      x[bs*_shared_blocks[i] + k] += _shared_buffer[bs*i + k];
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::accumulate(std::vector<double>& x)
+{
+  accumulate_begin(x);
+  accumulate_end(x);
+}
+//-----------------------------------------------------------------------------
+void HaloExchange::post(bool forward)
+{
+  #ifdef HAS_MPI
+  const int tag = 5;
+  const std::size_t bs = _block_size;
+
+  // Forward: receive ghosts from owners, send shared blocks to
+  // sharers. Reverse: the other way around.
+  const std::vector<int>& recv_procs = forward ? _owners : _sharers;
+  const std::vector<int>& recv_offsets
+    = forward ? _ghost_offsets : _shared_offsets;
+  std::vector<double>& recv_buffer = forward ? _ghost_buffer : _shared_buffer;
+  const std::vector<int>& send_procs = forward ? _sharers : _owners;
+  const std::vector<int>& send_offsets
+    = forward ? _shared_offsets : _ghost_offsets;
+  std::vector<double>& send_buffer = forward ? _shared_buffer : _ghost_buffer;
+
+  _requests.resize(recv_procs.size() + send_procs.size());
+  for (std::size_t i = 0; i < recv_procs.size(); ++i)
+  {
+    MPI_Irecv(recv_buffer.data() + bs*recv_offsets[i],
+              bs*(recv_offsets[i + 1] - recv_offsets[i]), MPI_DOUBLE,
+              recv_procs[i], tag, _mpi_comm, &_requests[i]);
+  }
+  for (std::size_t i = 0; i < send_procs.size(); ++i)
+  {
+    MPI_Isend(send_buffer.data() + bs*send_offsets[i],
+              bs*(send_offsets[i + 1] - send_offsets[i]), MPI_DOUBLE,
+              send_procs[i], tag, _mpi_comm,
+              &_requests[recv_procs.size() + i]);
+  }
+  #else
+  // Without MPI there are no ghosts
+  dolfin_assert(_owners.empty() && _sharers.empty());
+  #endif
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __HALO_EXCHANGE_H
+#define __HALO_EXCHANGE_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <dolfin/common/MPI.h>
+
+namespace dolfin
+{
+
+  /// This class holds a communication plan for updating the ghost
+  /// entries of a distributed array. The plan is built once from the
+  /// ownership range and the ghost indices with their owners (as
+  /// provided by a dofmap) and may be reused for any number of
+  /// updates.
+  ///
+  /// The local array is laid out as for a dofmap: owned entries
+  /// first, followed by the ghost entries in the order the ghosts
+  /// were given. Each index holds block_size consecutive values.
+  ///
+  /// A forward update copies owned values to the ghost entries on
+  /// other processes. A reverse update (accumulate) adds ghost values
+  /// into the owned entries on the owning process. Both are split in
+  /// begin/end pairs, so that computation which does not depend on
+  /// the incoming values may be done while messages are in flight.
+
+  class HaloExchange
+  {
+  public:
+
+    /// Create halo exchange. local_range is the range of owned
+    /// entries (values, not blocks), ghosts holds the global block
+    /// index of each ghost and ghost_owners the process owning it.
+    HaloExchange(MPI_Comm comm,
+                 std::pair<std::size_t, std::size_t> local_range,
+                 const std::vector<std::size_t>& ghosts,
+                 const std::vector<int>& ghost_owners,
+                 std::size_t block_size=1);
+
+    /// Destructor
+    ~HaloExchange();
+
+    /// Return number of owned entries (values)
+    std::size_t num_owned() const
+    { return _block_size*_num_owned_blocks; }
+
+    /// Return number of ghost entries (values)
+    std::size_t num_ghosts() const
+    { return _block_size*_ghost_positions.size(); }
+
+    /// Return block size
+    std::size_t block_size() const
+    { return _block_size; }
+
+    /// Start forward update. The owned values of x are copied before
+    /// returning.
+    void update_begin(const std::vector<double>& x);
+
+    /// Complete forward update, setting the ghost values of x
+    void update_end(std::vector<double>& x);
+
+    /// Update ghost values of x (blocking)
+    void update(std::vector<double>& x);
+
+    /// Start reverse update. The ghost values of x are copied before
+    /// returning.
+    void accumulate_begin(const std::vector<double>& x);
+
+    /// Complete reverse update, adding the ghost values received
+    /// from other processes to the owned values of x
+    void accumulate_end(std::vector<double>& x);
+
+    /// Add ghost values of x on other processes to owned values of x
+    /// (blocking)
+    void accumulate(std::vector<double>& x);
+
+  private:
+
+    // Post receives and sends for the (forward or reverse) exchange
+    void post(bool forward);
+
+    // MPI communicator
+    MPI_Comm _mpi_comm;
+
+    // Block size and number of owned blocks
+    std::size_t _block_size, _num_owned_blocks;
+
+    // Processes owning ghosts on this process, and positions of the
+    // ghosts (relative to the first ghost) for each owner, stored as
+    // offsets into _ghost_positions
+    std::vector<int> _owners, _ghost_offsets, _ghost_positions;
+
+    // Processes holding ghosts of owned blocks, and local indices of
+    // the owned blocks for each of these processes, stored as offsets
+    // into _shared_blocks
+    std::vector<int> _sharers, _shared_offsets, _shared_blocks;
+
+    // Buffers for ghost and shared values, ordered as _ghost_positions
+    // and _shared_blocks
+    std::vector<double> _ghost_buffer, _shared_buffer;
+
+    // Requests for exchange in progress
+    std::vector<MPI_Request> _requests;
+
+  };
+
+}
+
+#endif
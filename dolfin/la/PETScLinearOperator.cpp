@@ -18,11 +18,12 @@
 // Modified by Andy R. Terrel 2005
 //
 // First added:  2005-01-17
-// Last changed: 2010-08-28
+// Last changed: 2026-10-19
 
 #ifdef HAS_PETSC
 
 #include <iostream>
+#include <stdexcept>
 #include <petscmat.h>
 #include <memory>
 #include <dolfin/common/NoDeleter.h>
@@ -56,6 +57,36 @@ namespace dolfin
 
     return 0;
   }
+
+  // Callback function for PETSc get diagonal function
+  int usergetdiagonal(Mat A, Vec d)
+  {
+    // Wrap PETSc Vec as dolfin::PETScVector
+    PETScVector _d(d);
+
+    // Extract pointer to PETScLinearOperator
+    void* ctx = 0;
+    MatShellGetContext(A, &ctx);
+    PETScLinearOperator* _matA = ((PETScLinearOperator*) ctx);
+
+    // Call user-defined get_diagonal function through wrapper. The
+    // operation is registered for all operators, so report operators
+    // without a diagonal to PETSc rather than throwing through it.
+    dolfin_assert(_matA);
+    GenericLinearOperator* wrapper = _matA->wrapper();
+    dolfin_assert(wrapper);
+    try
+    {
+      wrapper->get_diagonal(_d);
+    }
+    catch (std::exception& e)
+    {
+      warning("%s", e.what());
+      return PETSC_ERR_SUP;
+    }
+
+    return 0;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -140,6 +171,11 @@ void PETScLinearOperator::init_layout(const GenericVector& x,
 
   ierr = MatShellSetOperation(_matA, MATOP_MULT, (void (*)()) usermult);
   if (ierr != 0) petsc_error(ierr, __FILE__, "MatShellSetOperation");
+
+  // Diagonal is used by PETSc Jacobi preconditioner
+  ierr = MatShellSetOperation(_matA, MATOP_GET_DIAGONAL,
+                              (void (*)()) usergetdiagonal);
+  if (ierr != 0) petsc_error(ierr, __FILE__, "MatShellSetOperation");
 }
 //-----------------------------------------------------------------------------
 
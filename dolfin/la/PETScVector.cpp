@@ -21,7 +21,7 @@
 // Modified by Fredrik Valdmanis 2011-2012
 //
 // First added:  2004
-// Last changed: 2012-08-22
+// Last changed: 2026-10-19
 
 #ifdef HAS_PETSC
 
@@ -601,6 +601,48 @@ void PETScVector::axpy(double a, const GenericVector& y)
   update_ghost_values();
 }
 //-----------------------------------------------------------------------------
+void PETScVector::maxpy(double beta, const std::vector<double>& a,
+                        const std::vector<const GenericVector*>& x)
+{
+  dolfin_assert(_x);
+  dolfin_assert(a.size() == x.size());
+
+  std::vector<Vec> _x_vecs(x.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    const PETScVector& _xi = as_type<const PETScVector>(*x[i]);
+    dolfin_assert(_xi._x);
+    if (size() != _xi.size())
+    {
+      dolfin_error("PETScVector.cpp",
+                   "perform maxpy operation with PETSc vector",
+                   "Vectors are not of the same size");
+    }
+    _x_vecs[i] = _xi._x;
+  }
+
+  PetscErrorCode ierr;
+  if (beta == 0.0)
+  {
+    ierr = VecSet(_x, 0.0);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "VecSet");
+  }
+  else if (beta != 1.0)
+  {
+    ierr = VecScale(_x, beta);
+    if (ierr != 0) petsc_error(ierr, __FILE__, "VecScale");
+  }
+
+  if (!x.empty())
+  {
+    ierr = VecMAXPY(_x, x.size(), a.data(), _x_vecs.data());
+    if (ierr != 0) petsc_error(ierr, __FILE__, "VecMAXPY");
+  }
+
+  // Update ghost values
+  update_ghost_values();
+}
+//-----------------------------------------------------------------------------
 void PETScVector::abs()
 {
   dolfin_assert(_x);
@@ -22,7 +22,7 @@
 // Modified by Fredrik Valdmanis, 2011.
 //
 // First added:  2004-01-01
-// Last changed: 2011-09-29
+// Last changed: 2026-10-19
 
 #ifndef __PETSC_VECTOR_H
 #define __PETSC_VECTOR_H
@@ -177,6 +177,10 @@ namespace dolfin
     /// Add multiple of given vector (AXPY operation)
     virtual void axpy(double a, const GenericVector& x);
 
+    /// Compute linear combination y = beta*y + sum_i a[i]*x[i]
+    virtual void maxpy(double beta, const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x);
+
     /// Replace all entries in the vector by their absolute values
     virtual void abs();
 
@@ -19,7 +19,7 @@
 // Modified by Ilmar Wilbers 2008
 //
 // First added:  2007-01-17
-// Last changed: 2012-03-15
+// Last changed: 2026-10-19
 
 #include <algorithm>
 #include <iomanip>
@@ -227,89 +227,94 @@ void STLMatrix::apply(std::string mode)
   // Number of processes
   const std::size_t num_processes = MPI::size(_mpi_comm);
 
-  // Data to send
-  std::vector<std::vector<std::size_t> > send_non_local_rows(num_processes);
-  std::vector<std::vector<std::size_t> > send_non_local_cols(num_processes);
-  std::vector<std::vector<double> > send_non_local_vals(num_processes);
-
   std::vector<std::size_t> range(2);
   range[0] = _local_range.first;
   range[1] = _local_range.second;
   std::vector<std::size_t> process_ranges;
   dolfin::MPI::all_gather(_mpi_comm, range, process_ranges);
 
-  // Communicate off-process data
+  // Find owning process of each off-process entry by bisection over
+  // the (ordered) ownership ranges
+  std::vector<std::size_t> range_ends(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+    range_ends[p] = process_ranges[2*p + 1];
+  std::vector<int> owners(off_processs_data.size());
+  std::vector<int> num_entries(num_processes, 0);
   boost::unordered_map<std::pair<std::size_t,
                                std::size_t>, double>::const_iterator entry;
+  std::size_t k = 0;
   for (entry = off_processs_data.begin(); entry != off_processs_data.end();
-       ++entry)
+       ++entry, ++k)
   {
-    const std::size_t global_row = entry->first.first;
-
-    // FIXME: This can be more efficient by storing sparsity pattern,
-    //        or caching owning process for repeated assembly
+    owners[k] = std::upper_bound(range_ends.begin(), range_ends.end(),
+                                 entry->first.first) - range_ends.begin();
+    dolfin_assert(owners[k] < (int) num_processes);
+    ++num_entries[owners[k]];
+  }
 
-    // Get owning process
-    std::size_t owner = 0;
-    for (std::size_t proc = 0; proc < num_processes; ++proc)
+  // Compute destinations and offsets
+  std::vector<int> destinations, send_offsets(1, 0), send_index_offsets(1, 0);
+  std::vector<int> position(num_processes);
+  for (std::size_t p = 0; p < num_processes; ++p)
+  {
+    position[p] = send_offsets.back();
+    if (num_entries[p] > 0)
     {
-      if (global_row < process_ranges[2*proc + 1]
-          && global_row >= process_ranges[2*proc])
-      {
-        owner = proc;
-        break;
-      }
+      destinations.push_back(p);
+      send_offsets.push_back(send_offsets.back() + num_entries[p]);
+      send_index_offsets.push_back(2*send_offsets.back());
     }
+  }
 
-    send_non_local_rows[owner].push_back(global_row);
-    send_non_local_cols[owner].push_back(entry->first.second);
-    send_non_local_vals[owner].push_back(entry->second);
+  // Pack (row, column) pairs and values for each destination
+  std::vector<std::size_t> send_indices(2*off_processs_data.size());
+  std::vector<double> send_values(off_processs_data.size());
+  k = 0;
+  for (entry = off_processs_data.begin(); entry != off_processs_data.end();
+       ++entry, ++k)
+  {
+    const int pos = position[owners[k]]++;
+    send_indices[2*pos] = entry->first.first;
+    send_indices[2*pos + 1] = entry->first.second;
+    send_values[pos] = entry->second;
   }
 
-  // Send/receive data
-  std::vector<std::vector<std::size_t> > received_non_local_rows;
-  std::vector<std::vector<std::size_t> > received_non_local_cols;
-  std::vector<std::vector<double> > received_non_local_vals;
-  dolfin::MPI::all_to_all(_mpi_comm, send_non_local_rows,
-                          received_non_local_rows);
-  dolfin::MPI::all_to_all(_mpi_comm, send_non_local_cols,
-                          received_non_local_cols);
-  dolfin::MPI::all_to_all(_mpi_comm, send_non_local_vals,
-                          received_non_local_vals);
+  // Send/receive data with the processes that own off-process rows
+  const std::vector<int> sources
+    = dolfin::MPI::compute_sources(_mpi_comm, destinations);
+  std::vector<int> recv_offsets, recv_index_offsets;
+  std::vector<std::size_t> received_indices;
+  std::vector<double> received_values;
+  std::vector<MPI_Request> requests, value_requests;
+  dolfin::MPI::neighbor_all_to_all_begin(_mpi_comm, destinations,
+                                         send_index_offsets, send_indices,
+                                         sources, recv_index_offsets,
+                                         received_indices, requests);
+  dolfin::MPI::neighbor_all_to_all_begin(_mpi_comm, destinations,
+                                         send_offsets, send_values,
+                                         sources, recv_offsets,
+                                         received_values, value_requests);
+  requests.insert(requests.end(), value_requests.begin(),
+                  value_requests.end());
+  dolfin::MPI::wait_all(requests);
 
   // Add/insert off-process data
-  for (std::size_t p = 0; p < num_processes; ++p)
+  dolfin_assert(received_indices.size() == 2*received_values.size());
+  for (std::size_t i = 0; i < received_values.size(); ++i)
   {
-    const std::vector<std::size_t>& received_non_local_rows_p
-      = received_non_local_rows[p];
-    const std::vector<std::size_t>& received_non_local_cols_p
-      = received_non_local_cols[p];
-    const std::vector<double>& received_non_local_vals_p
-      = received_non_local_vals[p];
-
-    dolfin_assert(received_non_local_rows_p.size()
-           == received_non_local_cols_p.size());
-    dolfin_assert(received_non_local_rows_p.size()
-           == received_non_local_vals_p.size());
-
-    for (std::size_t i = 0; i < received_non_local_rows_p.size(); ++i)
-    {
-      dolfin_assert(received_non_local_rows_p[i] < _local_range.second
-                    && received_non_local_rows_p[i] >= _local_range.first);
-      const std::size_t I_local
-        = received_non_local_rows_p[i] - _local_range.first;
-      dolfin_assert(I_local < _values.size());
-
-      const std::size_t J = received_non_local_cols_p[i];
-      std::vector<std::pair<std::size_t, double> >::iterator e
-            = std::find_if(_values[I_local].begin(), _values[I_local].end(),
-                           CompareIndex(J));
-      if (e != _values[I_local].end())
-        e->second += received_non_local_vals_p[i];
-      else
-        _values[I_local].push_back(std::make_pair(J,
-                                               received_non_local_vals_p[i]));
-    }
+    dolfin_assert(received_indices[2*i] < _local_range.second
+                  && received_indices[2*i] >= _local_range.first);
+    const std::size_t I_local = received_indices[2*i] - _local_range.first;
+    dolfin_assert(I_local < _values.size());
+
+    const std::size_t J = received_indices[2*i + 1];
+    std::vector<std::pair<std::size_t, double> >::iterator e
+      = std::find_if(_values[I_local].begin(), _values[I_local].end(),
+                     CompareIndex(J));
+    if (e != _values[I_local].end())
+      e->second += received_values[i];
+    else
+      _values[I_local].push_back(std::make_pair(J, received_values[i]));
   }
 
   // Sort columns (csr)/rows (csc)
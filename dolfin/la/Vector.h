@@ -21,7 +21,7 @@
 // Modified by Martin Sandve Alnes, 2008.
 //
 // First added:  2007-07-03
-// Last changed: 2011-01-14
+// Last changed: 2026-10-19
 
 #ifndef __DOLFIN_VECTOR_H
 #define __DOLFIN_VECTOR_H
@@ -194,6 +194,11 @@ namespace dolfin
     virtual void axpy(double a, const GenericVector& x)
     { vector->axpy(a, x); }
 
+    /// Compute linear combination y = beta*y + sum_i a[i]*x[i]
+    virtual void maxpy(double beta, const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x)
+    { vector->maxpy(beta, a, x); }
+
     /// Replace all entries in the vector by their absolute values
     virtual void abs()
     { vector->abs(); }
@@ -257,6 +262,10 @@ namespace dolfin
     const Vector& operator= (double a)
     { *vector = a; return *this; }
 
+    /// Return true if data() gives direct access to the local values
+    virtual bool has_data() const
+    { return vector->has_data(); }
+
     /// Return pointer to underlying data (const version)
     virtual const double* data() const
     { return vector->data(); }
@@ -43,6 +43,7 @@
 #include <dolfin/la/PETScVector.h>
 
 #include <dolfin/la/SparsityPattern.h>
+#include <dolfin/la/HaloExchange.h>
 
 #include <dolfin/la/GenericLinearAlgebraFactory.h>
 #include <dolfin/la/DefaultFactory.h>
@@ -56,6 +57,7 @@
 #include <dolfin/la/uBLASPreconditioner.h>
 #include <dolfin/la/uBLASKrylovSolver.h>
 #include <dolfin/la/uBLASILUPreconditioner.h>
+#include <dolfin/la/uBLASJacobiPreconditioner.h>
 #include <dolfin/la/Vector.h>
 #include <dolfin/la/Matrix.h>
 #include <dolfin/la/Scalar.h>
@@ -18,9 +18,12 @@
 // Modified by Anders Logg, 2006-2010.
 //
 // First added:  2006-06-23
-// Last changed: 2010-08-31
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cmath>
 #include <dolfin/common/constants.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "uBLASVector.h"
 #include "uBLASSparseMatrix.h"
 #include "uBLASILUPreconditioner.h"
@@ -41,144 +44,255 @@ uBLASILUPreconditioner::~uBLASILUPreconditioner()
 //-----------------------------------------------------------------------------
 void uBLASILUPreconditioner::init(const uBLASMatrix<ublas_sparse_matrix>& P)
 {
-  ublas_sparse_matrix& _matM = M.mat();
-
-  const std::size_t size = P.size(0);
-  _matM.resize(size, size, false);
-  _matM.assign(P.mat());
+  // The below algorithm is based on that in the book
+  // Y. Saad, "Iterative Methods for Sparse Linear Systems", p.276-278.
+  // It is specific to compressed row storage. Rows are factorised
+  // level by level, using the same levels as forward substitution
+  // since row k only depends on the rows in its lower triangular
+  // part.
 
-  // Add term to diagonal to avoid negative pivots
   const double zero_shift = parameters("preconditioner")["shift_nonzero"];
-  if(zero_shift > 0.0)
-    _matM.plus_assign( zero_shift*ublas::identity_matrix<double>(size) );
-
-  /*
-  // Straightforward and very slow implementation. This is used for verification
-  tic();
-  M.assign(A);
-  for(std::size_t i=1; i < size; ++i)
+
+  // Copy matrix to flat compressed row storage and find diagonal
+  // entries. Missing diagonal entries are added if the diagonal is
+  // shifted.
+  const ublas_sparse_matrix& A = P.mat();
+  const std::size_t size = A.size1();
+  dolfin_assert(A.filled1() == size + 1);
+  const std::size_t nnz = A.index1_data()[size];
+  _row_ptr.resize(size + 1);
+  _row_ptr[0] = 0;
+  _cols.clear();
+  _cols.reserve(nnz + size);
+  _values.clear();
+  _values.reserve(nnz + size);
+  _diagonal.resize(size);
+  for (std::size_t k = 0; k < size; ++k)
   {
-    for(std::size_t k=0; k < i; ++k)
+    const std::size_t begin = A.index1_data()[k];
+    const std::size_t end = A.index1_data()[k + 1];
+    const std::size_t diag
+      = std::lower_bound(A.index2_data().begin() + begin,
+                         A.index2_data().begin() + end, k)
+      - A.index2_data().begin();
+
+    _cols.insert(_cols.end(), A.index2_data().begin() + begin,
+                 A.index2_data().begin() + diag);
+    _values.insert(_values.end(), A.value_data().begin() + begin,
+                   A.value_data().begin() + diag);
+    _diagonal[k] = _cols.size();
+    if (diag == end || A.index2_data()[diag] != k)
     {
-     if( fabs( M(i,k) ) > 0.0 )
+      if (zero_shift <= 0.0)
       {
-        M(i,k) = M(i,k)/M(k,k);
-        for(std::size_t j=k+1; j < size; ++j)
-        {
-          if( fabs( M(i,j) ) > DOLFIN_EPS )
-              M(i,j) = M(i,j) - M(i,k)*M(k,j);
-        }
+        dolfin_error("uBLASILUPreconditioner.cpp",
+                     "initialize uBLAS ILU preconditioner",
+                     "Zero pivot detected in row %u", k);
       }
+      _cols.push_back(k);
+      _values.push_back(0.0);
     }
+    _cols.insert(_cols.end(), A.index2_data().begin() + diag,
+                 A.index2_data().begin() + end);
+    _values.insert(_values.end(), A.value_data().begin() + diag,
+                   A.value_data().begin() + end);
+    _row_ptr[k + 1] = _cols.size();
   }
-  */
 
-  // This approach using uBLAS iterators is simple and quite fast.
-  // Is it possible to remove the M(.,.) calls? This would speed it up a lot.
+  // Add term to diagonal to avoid negative pivots
+  if (zero_shift > 0.0)
+  {
+    for (std::size_t k = 0; k < size; ++k)
+      _values[_diagonal[k]] += zero_shift;
+  }
+
+  // Compute levels
+  compute_levels(true, _lower_level_ptr, _lower_level_rows);
+  compute_levels(false, _upper_level_ptr, _upper_level_rows);
 
-  /*
-  // Sparse matrix iterators
-  typedef uBLASMatrix<ublas_sparse_matrix>::iterator1 it1;
-  typedef uBLASMatrix<ublas_sparse_matrix>::iterator2 it2;
-  it2 ij;
-  for (it1 i1 = M.begin1(); i1 != M.end1(); ++i1)  // iterate over rows  i=0 -> size
+  // Factorise rows level by level
+  const int num_levels = _lower_level_ptr.size() - 1;
+  long int zero_pivot = -1;
+  #ifdef HAS_OPENMP
+  const int nthreads = num_threads(_lower_level_ptr);
+  #pragma omp parallel num_threads(nthreads)
+  #endif
   {
-    for (it2 ik = i1.begin(); ik.index2() <  ik.index1(); ++ik) // move along row k=0 -> i
+    std::vector<long int> iw(size, -1);
+    for (int level = 0; level < num_levels; ++level)
     {
-      *ik /= M(ik.index2(),ik.index2());    // M(i,k) = M(i,k)/M(k,k)
-      ij=ik;
-      ++ij;
-      for( ; ij != i1.end(); ++ij)                  // over j=k+1 -> size
-        *ij -=  (*ik)*M(ik.index2(), ij.index2());  // M(i,j) = M(i,j) - M(i,k)*M(k, j)
+      const int begin = _lower_level_ptr[level];
+      const int end = _lower_level_ptr[level + 1];
+      #ifdef HAS_OPENMP
+      #pragma omp for schedule(static)
+      #endif
+      for (int i = begin; i < end; ++i)
+      {
+        const std::size_t k = _lower_level_rows[i];
+        if (!factorize_row(k, iw))
+        {
+          #ifdef HAS_OPENMP
+          #pragma omp critical
+          #endif
+          zero_pivot = (zero_pivot == -1) ? k : std::min(zero_pivot, (long int) k);
+        }
+      }
     }
   }
-  */
 
-  // The below algorithm is based on that in the book
-  // Y. Saad, "Iterative Methods for Sparse Linear Systems", p.276-278.
-  // It is specific to compressed row storage
+  if (zero_pivot != -1)
+  {
+    dolfin_error("uBLASILUPreconditioner.cpp",
+                 "initialize uBLAS ILU preconditioner",
+                 "Zero pivot detected in row %u", zero_pivot);
+  }
+}
+//-----------------------------------------------------------------------------
+void uBLASILUPreconditioner::solve(uBLASVector& x, const uBLASVector& b) const
+{
+  // Get underlying uBLAS vectors
+  ublas_vector& _x = x.vec();
+  const ublas_vector& _b = b.vec();
 
-  // Initialise some data
-  diagonal.resize(size);
-  diagonal[0] = 0;
+  dolfin_assert(!_diagonal.empty());
+  dolfin_assert(_x.size() == _diagonal.size());
+  dolfin_assert(_x.size() == _b.size());
 
-  std::vector<std::size_t> iw(size);
-  for(std::size_t i=0; i< size; ++i)
-    iw[i] = 0;
+  // Solve in-place
+  _x.assign(_b);
+  double* xx = x.data();
 
-  std::size_t j0=0, j1=0, j=0, jrow=0, jw=0;
-  double t1;
+  const std::size_t* row_ptr = _row_ptr.data();
+  const std::size_t* cols = _cols.data();
+  const double* values = _values.data();
+  const std::size_t* diagonal = _diagonal.data();
 
-  for (std::size_t k = 0; k < size ; ++k)        // i (rows)
+  // Forward substitution (unit lower triangular)
+  const int num_lower_levels = _lower_level_ptr.size() - 1;
+  #ifdef HAS_OPENMP
+  #pragma omp parallel num_threads(num_threads(_lower_level_ptr))
+  #endif
+  for (int level = 0; level < num_lower_levels; ++level)
   {
-    j0 = _matM.index1_data () [k];    // ia
-    j1 = _matM.index1_data () [k+1]-1;
-
-    // Initialise working array iw
-    for (std::size_t i = j0;  i <= j1; ++i)
-      iw[ _matM.index2_data () [i] ] = i;  // ja
-
-    // Move along row looking for diagonal
-    j=j0;
-    while(j <= j1)
+    const int begin = _lower_level_ptr[level];
+    const int end = _lower_level_ptr[level + 1];
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int r = begin; r < end; ++r)
     {
-      jrow = _matM.index2_data () [j];  // ja
-
-      if( jrow >= k ) // passed or found diagonal, therefore break
-        break;
-
-      t1 = (_matM.value_data() [j])/(_matM.value_data() [ diagonal[jrow] ]);  //M(k,j) = M(k,j)/M(j,j)
-      _matM.value_data() [j] = t1;
-      for(std::size_t jj = diagonal[jrow]+1; jj <= _matM.index1_data () [jrow+1]-1; ++jj)
-      {
-        jw = iw[ _matM.index2_data () [jj] ];
-        if(jw != 0)
-          _matM.value_data() [jw] = _matM.value_data() [jw] -t1*(_matM.value_data() [jj]);
-      } // jj
-      ++j;
+      const std::size_t i = _lower_level_rows[r];
+      double xi = xx[i];
+      for (std::size_t k = row_ptr[i]; k < diagonal[i]; ++k)
+        xi -= values[k]*xx[cols[k]];
+      xx[i] = xi;
     }
-    diagonal[k] = j;
+  }
 
-    if (jrow != k || fabs( _matM.value_data() [j] ) < DOLFIN_EPS)
+  // Backward substitution
+  const int num_upper_levels = _upper_level_ptr.size() - 1;
+  #ifdef HAS_OPENMP
+  #pragma omp parallel num_threads(num_threads(_upper_level_ptr))
+  #endif
+  for (int level = 0; level < num_upper_levels; ++level)
+  {
+    const int begin = _upper_level_ptr[level];
+    const int end = _upper_level_ptr[level + 1];
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int r = begin; r < end; ++r)
     {
-      dolfin_error("uBLASILUPreconditioner.cpp",
-                   "initialize uBLAS ILU preconditioner",
-                   "Zero pivot detected in row %u", k);
+      const std::size_t i = _upper_level_rows[r];
+      double xi = xx[i];
+      for (std::size_t k = diagonal[i] + 1; k < row_ptr[i + 1]; ++k)
+        xi -= values[k]*xx[cols[k]];
+      xx[i] = xi/values[diagonal[i]];
     }
-
-    for(std::size_t i=j0; i <= j1; ++i)
-      iw[ _matM.index2_data () [i] ] = 0;
-  } // k
+  }
 }
 //-----------------------------------------------------------------------------
-void uBLASILUPreconditioner::solve(uBLASVector& x, const uBLASVector& b) const
+void uBLASILUPreconditioner::compute_levels(bool lower,
+                                      std::vector<std::size_t>& level_ptr,
+                                      std::vector<std::size_t>& level_rows) const
 {
-  // Get underlying uBLAS matrices and vectors
-  ublas_vector& _x = x.vec();
-  const ublas_vector& _b = b.vec();
-  const ublas_sparse_matrix & _matM = M.mat();
+  // The level of a row is one more than the highest level of the
+  // rows it depends on: columns to the left of the diagonal for
+  // forward substitution and to the right for backward substitution
+  const std::size_t size = _diagonal.size();
+  std::vector<std::size_t> level(size, 0);
+  std::size_t num_levels = 0;
+  for (std::size_t n = 0; n < size; ++n)
+  {
+    const std::size_t i = lower ? n : size - 1 - n;
+    const std::size_t begin = lower ? _row_ptr[i] : _diagonal[i] + 1;
+    const std::size_t end = lower ? _diagonal[i] : _row_ptr[i + 1];
+    std::size_t l = 0;
+    for (std::size_t k = begin; k < end; ++k)
+      l = std::max(l, level[_cols[k]] + 1);
+    level[i] = l;
+    num_levels = std::max(num_levels, l + 1);
+  }
 
-  dolfin_assert(_matM.size1() > 0 && _matM.size2() > 0);
-  dolfin_assert( _x.size() == _matM.size1() );
-  dolfin_assert( _x.size() == _b.size());
+  // Sort rows by level (counting sort, keeping order within level)
+  level_ptr.assign(num_levels + 1, 0);
+  for (std::size_t i = 0; i < size; ++i)
+    ++level_ptr[level[i] + 1];
+  for (std::size_t l = 0; l < num_levels; ++l)
+    level_ptr[l + 1] += level_ptr[l];
 
-  // Solve in-place
-  _x.assign(_b);
+  level_rows.resize(size);
+  std::vector<std::size_t> position(level_ptr.begin(), level_ptr.end() - 1);
+  for (std::size_t n = 0; n < size; ++n)
+  {
+    const std::size_t i = lower ? n : size - 1 - n;
+    level_rows[position[level[i]]++] = i;
+  }
+}
+//-----------------------------------------------------------------------------
+bool uBLASILUPreconditioner::factorize_row(std::size_t k,
+                                           std::vector<long int>& iw)
+{
+  const std::size_t j0 = _row_ptr[k];
+  const std::size_t j1 = _row_ptr[k + 1];
+
+  // Initialise working array iw with positions of entries in row k
+  for (std::size_t j = j0; j < j1; ++j)
+    iw[_cols[j]] = j;
 
-  // Perform substitutions for compressed row storage. This is the fastest.
-  const std::size_t size = _matM.size1();
-  for(std::size_t i =0; i < size; ++i)
+  // Eliminate entries left of the diagonal
+  for (std::size_t j = j0; j < _diagonal[k]; ++j)
   {
-    std::size_t k;
-    for(k = _matM.index1_data () [i]; k < diagonal[i]; ++k)
-      _x(i) -= ( _matM.value_data () [k] )*x[ _matM.index2_data () [k] ];
+    const std::size_t jrow = _cols[j];
+    const double t1 = _values[j]/_values[_diagonal[jrow]];
+    _values[j] = t1;
+    for (std::size_t jj = _diagonal[jrow] + 1; jj < _row_ptr[jrow + 1]; ++jj)
+    {
+      const long int jw = iw[_cols[jj]];
+      if (jw != -1)
+        _values[jw] -= t1*_values[jj];
+    }
   }
-  for(int i =size-1; i >= 0; --i)
+
+  // Reset working array
+  for (std::size_t j = j0; j < j1; ++j)
+    iw[_cols[j]] = -1;
+
+  return std::abs(_values[_diagonal[k]]) >= DOLFIN_EPS;
+}
+//-----------------------------------------------------------------------------
+int uBLASILUPreconditioner::num_threads(const std::vector<std::size_t>& level_ptr)
+{
+  // Each level ends with a barrier, so threads only pay off if levels
+  // hold many rows on average
+  const std::size_t min_rows_per_level = 64;
+  const std::size_t num_levels = level_ptr.size() - 1;
+  if (num_levels == 0
+      || level_ptr.back() < min_rows_per_level*num_levels)
   {
-    std::size_t k;
-    for(k = _matM.index1_data () [i+1]-1; k > diagonal[i]; --k)
-      _x(i) -= ( _matM.value_data () [k] )*x[ _matM.index2_data () [k] ];
-    _x(i) /= ( _matM.value_data () [k] );
+    return 1;
   }
+
+  return std::max(1, (int) dolfin::parameters["num_threads"]);
 }
 //-----------------------------------------------------------------------------
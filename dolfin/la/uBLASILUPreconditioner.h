@@ -18,11 +18,12 @@
 // Modified by Anders Logg 2006.
 //
 // First added:  2006-06-23
-// Last changed: 2009-07-03
+// Last changed: 2026-10-19
 
 #ifndef __UBLAS_ILU_PRECONDITIONER_H
 #define __UBLAS_ILU_PRECONDITIONER_H
 
+#include <vector>
 #include "ublas.h"
 #include "uBLASPreconditioner.h"
 #include "uBLASMatrix.h"
@@ -35,6 +36,13 @@ namespace dolfin
 
   /// This class implements an incomplete LU factorization (ILU)
   /// preconditioner for the uBLAS Krylov solver.
+  ///
+  /// The factors are stored in compressed row storage, separate from
+  /// the matrix. Rows are grouped in levels computed from the
+  /// sparsity pattern, such that rows in a level only depend on rows
+  /// in earlier levels. Rows within a level are factorised and
+  /// solved for concurrently with OpenMP (using the global parameter
+  /// "num_threads").
 
   class uBLASILUPreconditioner : public uBLASPreconditioner
   {
@@ -54,11 +62,31 @@ namespace dolfin
 
   private:
 
-    // Preconditioner matrix (factorised)
-    uBLASMatrix<ublas_sparse_matrix> M;
+    // Compute levels for forward (lower = true) or backward
+    // substitution
+    void compute_levels(bool lower, std::vector<std::size_t>& level_ptr,
+                        std::vector<std::size_t>& level_rows) const;
 
-    // Diagonal
-    std::vector<std::size_t> diagonal;
+    // Factorise row k in place (iw is a work array which must be
+    // initialised to -1 and is returned so). Returns false on zero
+    // pivot.
+    bool factorize_row(std::size_t k, std::vector<long int>& iw);
+
+    // Return number of threads to use for a level schedule (one if
+    // levels are too small to pay for the synchronisation)
+    static int num_threads(const std::vector<std::size_t>& level_ptr);
+
+    // Factors in compressed row storage (unit lower triangular part
+    // and upper triangular part including diagonal)
+    std::vector<std::size_t> _row_ptr, _cols;
+    std::vector<double> _values;
+
+    // Position of diagonal entry for each row
+    std::vector<std::size_t> _diagonal;
+
+    // Rows of each level for forward and backward substitution
+    std::vector<std::size_t> _lower_level_ptr, _lower_level_rows;
+    std::vector<std::size_t> _upper_level_ptr, _upper_level_rows;
 
     const Parameters& parameters;
 
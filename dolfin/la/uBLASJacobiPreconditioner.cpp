@@ -0,0 +1,91 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <dolfin/log/log.h>
+#include "uBLASVector.h"
+#include "uBLASSparseMatrix.h"
+#include "uBLASLinearOperator.h"
+#include "uBLASJacobiPreconditioner.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+uBLASJacobiPreconditioner::uBLASJacobiPreconditioner()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+uBLASJacobiPreconditioner::~uBLASJacobiPreconditioner()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+void uBLASJacobiPreconditioner::init(const uBLASMatrix<ublas_sparse_matrix>& P)
+{
+  const ublas_sparse_matrix& A = P.mat();
+  const std::size_t size = P.size(0);
+  _inv_diagonal.resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+    _inv_diagonal[i] = A(i, i);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (_inv_diagonal[i] == 0.0)
+    {
+      dolfin_error("uBLASJacobiPreconditioner.cpp",
+                   "initialize Jacobi preconditioner",
+                   "Zero diagonal entry in row %d", i);
+    }
+    _inv_diagonal[i] = 1.0/_inv_diagonal[i];
+  }
+}
+//-----------------------------------------------------------------------------
+void uBLASJacobiPreconditioner::init(const uBLASLinearOperator& P)
+{
+  const std::size_t size = P.size(0);
+  uBLASVector d(size);
+  P.get_diagonal(d);
+
+  const ublas_vector& _d = d.vec();
+  _inv_diagonal.resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    if (_d(i) == 0.0)
+    {
+      dolfin_error("uBLASJacobiPreconditioner.cpp",
+                   "initialize Jacobi preconditioner",
+                   "Zero diagonal entry in row %d", i);
+    }
+    _inv_diagonal[i] = 1.0/_d(i);
+  }
+}
+//-----------------------------------------------------------------------------
+void uBLASJacobiPreconditioner::solve(uBLASVector& x,
+                                      const uBLASVector& b) const
+{
+  dolfin_assert(_inv_diagonal.size() == b.size());
+  const ublas_vector& _b = b.vec();
+  if (x.size() != b.size())
+    x.resize(b.size());
+  ublas_vector& _x = x.vec();
+  for (std::size_t i = 0; i < _inv_diagonal.size(); ++i)
+    _x(i) = _inv_diagonal[i]*_b(i);
+}
+//-----------------------------------------------------------------------------
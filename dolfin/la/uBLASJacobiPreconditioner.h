@@ -0,0 +1,68 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __UBLAS_JACOBI_PRECONDITIONER_H
+#define __UBLAS_JACOBI_PRECONDITIONER_H
+
+#include <vector>
+#include "ublas.h"
+#include "uBLASPreconditioner.h"
+
+namespace dolfin
+{
+
+  template<typename Mat> class uBLASMatrix;
+  class uBLASLinearOperator;
+  class uBLASVector;
+
+  /// This class implements a Jacobi (diagonal) preconditioner for the
+  /// uBLAS Krylov solver. Unlike ILU, it can be initialised from a
+  /// linear operator that provides its diagonal, for example a
+  /// matrix-free operator.
+
+  class uBLASJacobiPreconditioner : public uBLASPreconditioner
+  {
+  public:
+
+    /// Constructor
+    uBLASJacobiPreconditioner();
+
+    /// Destructor
+    ~uBLASJacobiPreconditioner();
+
+    /// Initialise preconditioner (sparse matrix)
+    void init(const uBLASMatrix<ublas_sparse_matrix>& P);
+
+    /// Initialise preconditioner (virtual matrix)
+    void init(const uBLASLinearOperator& P);
+
+    /// Solve linear system Ax = b approximately
+    void solve(uBLASVector& x, const uBLASVector& b) const;
+
+  private:
+
+    // Inverse of diagonal
+    std::vector<double> _inv_diagonal;
+
+  };
+
+}
+
+#endif
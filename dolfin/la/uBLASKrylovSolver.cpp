@@ -18,12 +18,13 @@
 // Modified by Anders Logg 2006-2012
 //
 // First added:  2006-05-31
-// Last changed: 2012-05-07
+// Last changed: 2026-10-19
 
 #include <dolfin/common/NoDeleter.h>
 #include <dolfin/log/LogStream.h>
 #include "uBLASILUPreconditioner.h"
 #include "uBLASDummyPreconditioner.h"
+#include "uBLASJacobiPreconditioner.h"
 #include "uBLASKrylovSolver.h"
 #include "KrylovSolver.h"
 
@@ -44,7 +45,8 @@ uBLASKrylovSolver::preconditioners()
 {
   return { {"default", "default preconditioner"},
            {"none",    "No preconditioner"},
-           {"ilu",     "Incomplete LU factorization"} };
+           {"ilu",     "Incomplete LU factorization"},
+           {"jacobi",  "Jacobi iteration"} };
 }
 //-----------------------------------------------------------------------------
 Parameters uBLASKrylovSolver::default_parameters()
@@ -62,7 +64,8 @@ uBLASKrylovSolver::uBLASKrylovSolver(std::string method,
   div_tol(0.0),
   max_it(0),
   restart(0),
-  report(false)
+  report(false),
+  _parameters_version(0)
 {
   // Set parameter values
   parameters = default_parameters();
@@ -74,7 +77,7 @@ uBLASKrylovSolver::uBLASKrylovSolver(std::string method,
 uBLASKrylovSolver::uBLASKrylovSolver(uBLASPreconditioner& pc)
   : _method("default"), _pc(reference_to_no_delete_pointer(pc)),
   rtol(0.0), atol(0.0), div_tol(0.0), max_it(0), restart(0),
-  report(false)
+  report(false), _parameters_version(0)
 {
   // Set parameter values
   parameters = default_parameters();
@@ -84,7 +87,7 @@ uBLASKrylovSolver::uBLASKrylovSolver(std::string method,
                                      uBLASPreconditioner& pc)
   : _method(method), _pc(reference_to_no_delete_pointer(pc)),
   rtol(0.0), atol(0.0), div_tol(0.0), max_it(0), restart(0),
-  report(false)
+  report(false), _parameters_version(0)
 {
   // Set parameter values
   parameters = default_parameters();
@@ -153,6 +156,8 @@ void uBLASKrylovSolver::select_preconditioner(std::string preconditioner)
     _pc.reset(new uBLASDummyPreconditioner());
   else if (preconditioner == "ilu")
     _pc.reset(new uBLASILUPreconditioner(parameters));
+  else if (preconditioner == "jacobi")
+    _pc.reset(new uBLASJacobiPreconditioner());
   else if (preconditioner == "default")
     _pc.reset(new uBLASILUPreconditioner(parameters));
   else
@@ -164,6 +169,9 @@ void uBLASKrylovSolver::select_preconditioner(std::string preconditioner)
 //-----------------------------------------------------------------------------
 void uBLASKrylovSolver::read_parameters()
 {
+  if (_parameters_version == Parameters::version())
+    return;
+
   // Set tolerances and other parameters
   rtol    = parameters["relative_tolerance"];
   atol    = parameters["absolute_tolerance"];
@@ -171,5 +179,7 @@ void uBLASKrylovSolver::read_parameters()
   max_it  = parameters["maximum_iterations"];
   restart = parameters("gmres")["restart"];
   report  = parameters["report"];
+
+  _parameters_version = Parameters::version();
 }
 //-----------------------------------------------------------------------------
@@ -18,7 +18,7 @@
 // Modified by Anders Logg 2006-2012
 //
 // First added:  2006-05-31
-// Last changed: 2012-08-20
+// Last changed: 2026-10-19
 
 #ifndef __UBLAS_KRYLOV_SOLVER_H
 #define __UBLAS_KRYLOV_SOLVER_H
@@ -129,7 +129,7 @@ namespace dolfin
     /// Select and create named preconditioner
     void select_preconditioner(std::string preconditioner);
 
-    /// Read solver parameters
+    /// Read solver parameters (if parameters have changed)
     void read_parameters();
 
     /// Krylov method
@@ -143,6 +143,9 @@ namespace dolfin
     std::size_t max_it, restart;
     bool report;
 
+    /// Version of parameters when solver parameters were read
+    std::size_t _parameters_version;
+
     /// Operator (the matrix)
     std::shared_ptr<const GenericLinearOperator> _matA;
 
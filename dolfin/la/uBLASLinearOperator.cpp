@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-07-07
-// Last changed: 2012-12-12
+// Last changed: 2026-10-19
 
 #include "GenericVector.h"
 #include "uBLASLinearOperator.h"
@@ -51,6 +51,12 @@ void uBLASLinearOperator::mult(const GenericVector& x, GenericVector& y) const
   _wrapper->mult(x, y);
 }
 //-----------------------------------------------------------------------------
+void uBLASLinearOperator::get_diagonal(GenericVector& d) const
+{
+  dolfin_assert(_wrapper);
+  _wrapper->get_diagonal(d);
+}
+//-----------------------------------------------------------------------------
 std::string uBLASLinearOperator::str(bool verbose) const
 {
   std::stringstream s;
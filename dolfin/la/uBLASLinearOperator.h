@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-06-30
-// Last changed: 2012-12-12
+// Last changed: 2026-10-19
 
 #ifndef __UBLAS_LINEAR_OPERATOR_H
 #define __UBLAS_LINEAR_OPERATOR_H
@@ -50,6 +50,9 @@ namespace dolfin
     /// Compute matrix-vector product y = Ax
     virtual void mult(const GenericVector& x, GenericVector& y) const;
 
+    /// Compute diagonal of operator
+    virtual void get_diagonal(GenericVector& d) const;
+
     /// Return informal string representation (pretty-print)
     virtual std::string str(bool verbose) const;
 
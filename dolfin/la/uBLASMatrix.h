@@ -22,7 +22,7 @@
 // Modified by Dag Lindbo 2008
 //
 // First added:  2006-07-05
-// Last changed: 2012-08-20
+// Last changed: 2026-10-19
 
 #ifndef __UBLAS_MATRIX_H
 #define __UBLAS_MATRIX_H
@@ -37,6 +37,7 @@
 #include "TensorLayout.h"
 #include "ublas.h"
 #include "uBLASFactory.h"
+#include "uBLASSpMV.h"
 #include "uBLASVector.h"
 
 namespace dolfin
@@ -255,27 +256,37 @@ namespace dolfin
     // uBLAS matrix object
     Mat _matA;
 
+    // Block size of tensor layout (vector-valued function spaces)
+    std::size_t _block_size;
+
+    // Block size for sparse matrix-vector product and number of
+    // non-zeroes when it was computed (see apply())
+    std::size_t _mult_block_size, _mult_nnz;
+
   };
 
   //---------------------------------------------------------------------------
   // Implementation of uBLASMatrix
   //---------------------------------------------------------------------------
   template <typename Mat>
-  uBLASMatrix<Mat>::uBLASMatrix() : GenericMatrix(), _matA(0, 0)
+  uBLASMatrix<Mat>::uBLASMatrix() : GenericMatrix(), _matA(0, 0),
+    _block_size(1), _mult_block_size(1), _mult_nnz(0)
   {
     // Do nothing
   }
   //---------------------------------------------------------------------------
   template <typename Mat>
   uBLASMatrix<Mat>::uBLASMatrix(std::size_t M, std::size_t N)
-    : GenericMatrix(), _matA(M, N)
+    : GenericMatrix(), _matA(M, N), _block_size(1), _mult_block_size(1),
+      _mult_nnz(0)
   {
     // Do nothing
   }
   //---------------------------------------------------------------------------
   template <typename Mat>
   uBLASMatrix<Mat>::uBLASMatrix(const uBLASMatrix& A)
-    : GenericMatrix(), _matA(A._matA)
+    : GenericMatrix(), _matA(A._matA), _block_size(A._block_size),
+      _mult_block_size(A._mult_block_size), _mult_nnz(A._mult_nnz)
   {
     // Do nothing
   }
@@ -611,6 +622,9 @@ namespace dolfin
       // Assume uBLAS take care of deleting an existing Matrix
       // using its assignment operator
       _matA = A.mat();
+      _block_size = A._block_size;
+      _mult_block_size = A._mult_block_size;
+      _mult_nnz = A._mult_nnz;
     }
     return *this;
   }
@@ -664,6 +678,7 @@ namespace dolfin
   {
     resize(tensor_layout.size(0), tensor_layout.size(1));
     _matA.clear();
+    _block_size = tensor_layout.block_size;
 
     // Get sparsity pattern
     dolfin_assert(tensor_layout.sparsity_pattern());
@@ -703,6 +718,10 @@ namespace dolfin
 
     // Make sure matrix assembly is complete
     _matA.complete_index1_data();
+
+    // Check if rows can be processed in blocks by mult()
+    _mult_block_size = uBLASSpMV::compute_block_size(_matA, _block_size);
+    _mult_nnz = _matA.nnz();
   }
   //---------------------------------------------------------------------------
   template <typename Mat>
@@ -711,6 +730,45 @@ namespace dolfin
     // Do nothing
   }
   //---------------------------------------------------------------------------
+  template <>
+  inline void uBLASMatrix<ublas_sparse_matrix>::mult(const GenericVector& x,
+                                                     GenericVector& y) const
+  {
+    const uBLASVector& xx = as_type<const uBLASVector>(x);
+    uBLASVector& yy = as_type<uBLASVector>(y);
+
+    if (size(1) != xx.size())
+    {
+      dolfin_error("uBLASMatrix.h",
+                   "compute matrix-vector product with uBLAS matrix",
+                   "Non-matching dimensions for matrix-vector product");
+    }
+
+    // Resize RHS if empty
+    if (yy.empty())
+      init_vector(yy, 0);
+
+    if (size(0) != yy.size())
+    {
+      dolfin_error("uBLASMatrix.h",
+                   "compute matrix-vector product with uBLAS matrix",
+                   "Vector for matrix-vector result has wrong size");
+    }
+
+    // Fall back on uBLAS if row index data is incomplete (apply() has
+    // not been called)
+    if (_matA.filled1() != size(0) + 1)
+    {
+      ublas::axpy_prod(_matA, xx.vec(), yy.vec(), true);
+      return;
+    }
+
+    // Use blocked product only if sparsity is unchanged since apply()
+    const std::size_t block_size
+      = (_matA.nnz() == _mult_nnz) ? _mult_block_size : 1;
+    uBLASSpMV::mult(_matA, xx.data(), yy.data(), block_size);
+  }
+  //---------------------------------------------------------------------------
   template <typename Mat>
   inline void uBLASMatrix<Mat>::axpy(double a, const GenericMatrix& A,
                                      bool same_nonzero_pattern)
@@ -0,0 +1,150 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <algorithm>
+#include <dolfin/log/log.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/parameter/ParameterHandle.h>
+#include "uBLASSpMV.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+std::size_t uBLASSpMV::compute_block_size(const ublas_sparse_matrix& A,
+                                          std::size_t block_size)
+{
+  const std::size_t num_rows = A.size1();
+  if ((block_size != 2 && block_size != 3) || num_rows % block_size != 0)
+    return 1;
+
+  dolfin_assert(A.filled1() == num_rows + 1);
+  const std::size_t* row_ptr = A.index1_data().begin();
+  const std::size_t* cols = A.index2_data().begin();
+
+  // Check that all rows of each block have the same column indices
+  // as the first row of the block
+  for (std::size_t i0 = 0; i0 < num_rows; i0 += block_size)
+  {
+    const std::size_t n = row_ptr[i0 + 1] - row_ptr[i0];
+    for (std::size_t r = 1; r < block_size; ++r)
+    {
+      if (row_ptr[i0 + r + 1] - row_ptr[i0 + r] != n)
+        return 1;
+      if (!std::equal(cols + row_ptr[i0], cols + row_ptr[i0] + n,
+                      cols + row_ptr[i0 + r]))
+      {
+        return 1;
+      }
+    }
+  }
+
+  return block_size;
+}
+//-----------------------------------------------------------------------------
+void uBLASSpMV::mult(const ublas_sparse_matrix& A, const double* x,
+                     double* y, std::size_t block_size)
+{
+  const std::size_t num_rows = A.size1();
+  dolfin_assert(A.filled1() == num_rows + 1);
+  const std::size_t* row_ptr = A.index1_data().begin();
+  const std::size_t* cols = A.index2_data().begin();
+  const double* values = A.value_data().begin();
+
+  static const ParameterHandle<int> num_threads_parameter(parameters,
+                                                          "num_threads");
+  const int num_threads = std::max(1, num_threads_parameter.value());
+
+  if (block_size == 2)
+    mult_blocked<2>(num_rows, row_ptr, cols, values, x, y, num_threads);
+  else if (block_size == 3)
+    mult_blocked<3>(num_rows, row_ptr, cols, values, x, y, num_threads);
+  else
+    mult_csr(num_rows, row_ptr, cols, values, x, y, num_threads);
+}
+//-----------------------------------------------------------------------------
+void uBLASSpMV::mult_csr(std::size_t num_rows, const std::size_t* row_ptr,
+                         const std::size_t* cols, const double* values,
+                         const double* x, double* y, int num_threads)
+{
+  const int m = num_rows;
+
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int i = 0; i < m; ++i)
+  {
+    // Use independent partial sums so that the compiler can
+    // vectorise the loop
+    const std::size_t begin = row_ptr[i];
+    const std::size_t end = row_ptr[i + 1];
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    std::size_t k = begin;
+    for (; k + 3 < end; k += 4)
+    {
+      s0 += values[k]*x[cols[k]];
+      s1 += values[k + 1]*x[cols[k + 1]];
+      s2 += values[k + 2]*x[cols[k + 2]];
+      s3 += values[k + 3]*x[cols[k + 3]];
+    }
+    for (; k < end; ++k)
+      s0 += values[k]*x[cols[k]];
+    y[i] = (s0 + s1) + (s2 + s3);
+  }
+}
+//-----------------------------------------------------------------------------
+template<int B>
+void uBLASSpMV::mult_blocked(std::size_t num_rows,
+                             const std::size_t* row_ptr,
+                             const std::size_t* cols, const double* values,
+                             const double* x, double* y, int num_threads)
+{
+  dolfin_assert(num_rows % B == 0);
+  const int num_blocks = num_rows/B;
+
+  #ifdef HAS_OPENMP
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int ib = 0; ib < num_blocks; ++ib)
+  {
+    const std::size_t i0 = B*ib;
+    const std::size_t n = row_ptr[i0 + 1] - row_ptr[i0];
+    const std::size_t* c = cols + row_ptr[i0];
+
+    // Entries of each row in block (all rows have the same columns)
+    const double* v[B];
+    double s[B];
+    for (int r = 0; r < B; ++r)
+    {
+      v[r] = values + row_ptr[i0 + r];
+      s[r] = 0.0;
+    }
+
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      const double xk = x[c[k]];
+      for (int r = 0; r < B; ++r)
+        s[r] += v[r][k]*xk;
+    }
+
+    for (int r = 0; r < B; ++r)
+      y[i0 + r] = s[r];
+  }
+}
+//-----------------------------------------------------------------------------
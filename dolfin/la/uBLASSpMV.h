@@ -0,0 +1,73 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __UBLAS_SPMV_H
+#define __UBLAS_SPMV_H
+
+#include <cstddef>
+#include "ublas.h"
+
+namespace dolfin
+{
+
+  /// This class provides sparse matrix-vector product kernels
+  /// operating directly on the compressed row storage of a uBLAS
+  /// sparse matrix. Rows are partitioned between OpenMP threads
+  /// (using the global parameter "num_threads"). For matrices from
+  /// vector-valued function spaces, rows may be processed in blocks
+  /// of size 2 or 3 when all rows of a block share the same column
+  /// indices, so each column index and entry of x is loaded once per
+  /// block rather than once per row.
+
+  class uBLASSpMV
+  {
+  public:
+
+    /// Return block size (2 or 3) to use with mult() if consecutive
+    /// rows of A form blocks of the given size with identical column
+    /// indices, otherwise 1. The row index data of A must be
+    /// complete.
+    static std::size_t compute_block_size(const ublas_sparse_matrix& A,
+                                          std::size_t block_size);
+
+    /// Compute y = Ax. The row index data of A must be complete and
+    /// block_size should be computed by compute_block_size().
+    static void mult(const ublas_sparse_matrix& A, const double* x,
+                     double* y, std::size_t block_size=1);
+
+  private:
+
+    // Compute y = Ax, one row at a time
+    static void mult_csr(std::size_t num_rows, const std::size_t* row_ptr,
+                         const std::size_t* cols, const double* values,
+                         const double* x, double* y, int num_threads);
+
+    // Compute y = Ax, B rows at a time
+    template<int B>
+    static void mult_blocked(std::size_t num_rows,
+                             const std::size_t* row_ptr,
+                             const std::size_t* cols, const double* values,
+                             const double* x, double* y, int num_threads);
+
+  };
+
+}
+
+#endif
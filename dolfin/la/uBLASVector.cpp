@@ -20,7 +20,7 @@
 // Modified by Martin Sandve Alnes 2008
 //
 // First added:  2006-04-04
-// Last changed: 2012-03-15
+// Last changed: 2026-10-19
 
 #include <algorithm>
 #include <iomanip>
@@ -33,6 +33,8 @@
 #include <dolfin/log/dolfin_log.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/common/Array.h>
+#include <dolfin/parameter/GlobalParameters.h>
+#include <dolfin/parameter/ParameterHandle.h>
 #include "uBLASVector.h"
 #include "uBLASFactory.h"
 #include "GenericLinearAlgebraFactory.h"
@@ -247,6 +249,60 @@ void uBLASVector::axpy(double a, const GenericVector& y)
   (*_x) += a * as_type<const uBLASVector>(y).vec();
 }
 //-----------------------------------------------------------------------------
+void uBLASVector::maxpy(double beta, const std::vector<double>& a,
+                        const std::vector<const GenericVector*>& x)
+{
+  dolfin_assert(a.size() == x.size());
+  const std::size_t num_terms = x.size();
+  std::vector<const double*> xx(num_terms);
+  for (std::size_t t = 0; t < num_terms; ++t)
+  {
+    if (size() != x[t]->size())
+    {
+      dolfin_error("uBLASVector.cpp",
+                   "perform maxpy operation with uBLAS vector",
+                   "Vectors are not of the same size");
+    }
+    xx[t] = as_type<const uBLASVector>(*x[t]).data();
+  }
+
+  // Process the vector in chunks small enough to stay in cache, so
+  // that each term is a simple (vectorisable) loop while y is only
+  // read and written once
+  const int n = size();
+  if (n == 0)
+    return;
+  const int chunk_size = 1024;
+  const int num_chunks = (n + chunk_size - 1)/chunk_size;
+  double* y = data();
+
+  #ifdef HAS_OPENMP
+  static const ParameterHandle<int>
+    num_threads_parameter(dolfin::parameters, "num_threads");
+  const int num_threads = std::max(1, num_threads_parameter.value());
+  #pragma omp parallel for num_threads(num_threads) schedule(static)
+  #endif
+  for (int c = 0; c < num_chunks; ++c)
+  {
+    const int begin = c*chunk_size;
+    const int end = std::min(n, begin + chunk_size);
+
+    if (beta == 0.0)
+      std::fill(y + begin, y + end, 0.0);
+    else if (beta != 1.0)
+      for (int i = begin; i < end; ++i)
+        y[i] *= beta;
+
+    for (std::size_t t = 0; t < num_terms; ++t)
+    {
+      const double at = a[t];
+      const double* xt = xx[t];
+      for (int i = begin; i < end; ++i)
+        y[i] += at*xt[i];
+    }
+  }
+}
+//-----------------------------------------------------------------------------
 void uBLASVector::abs()
 {
   dolfin_assert(_x);
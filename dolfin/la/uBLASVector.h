@@ -21,7 +21,7 @@
 // Modified by Martin Alnæs, 2008.
 //
 // First added:  2006-03-04
-// Last changed: 2011-01-14
+// Last changed: 2026-10-19
 
 #ifndef __UBLAS_VECTOR_H
 #define __UBLAS_VECTOR_H
@@ -215,6 +215,10 @@ namespace dolfin
     /// Add multiple of given vector (AXPY operation)
     virtual void axpy(double a, const GenericVector& x);
 
+    /// Compute linear combination y = beta*y + sum_i a[i]*x[i]
+    virtual void maxpy(double beta, const std::vector<double>& a,
+                       const std::vector<const GenericVector*>& x);
+
     /// Replace all entries in the vector by their absolute values
     virtual void abs();
 
@@ -264,6 +268,10 @@ namespace dolfin
     /// Assignment operator
     virtual const uBLASVector& operator= (double a);
 
+    /// Return true (data() is supported)
+    virtual bool has_data() const
+    { return true; }
+
     /// Return pointer to underlying data (const version)
     virtual const double* data() const
     { return &_x->data()[0]; }
@@ -18,8 +18,9 @@
 // Modified by Anders Logg 2011
 //
 // First added:  2011-09-17
-// Last changed: 2014-07-02
+// Last changed: 2026-10-19
 
+#include <algorithm>
 #include <boost/multi_array.hpp>
 
 #include "dolfin/common/MPI.h"
@@ -1037,13 +1038,13 @@ void DistributedMeshTools::init_facet_cell_connections(Mesh& mesh)
     // With ghost cells, shared facets may be on an external edge,
     // so need to check connectivity with the cell owner.
 
-    const std::size_t mpi_size = MPI::size(mesh.mpi_comm());
-    std::vector<std::vector<std::size_t> > send_facet(mpi_size);
-    std::vector<std::vector<std::size_t> > recv_facet(mpi_size);
-    
-    // Map shared facets 
+    // Map shared facets
     std::map<std::size_t, std::size_t> global_to_local_facet;
-    
+
+    // Singly attached ghost facets (owner of attached cell, local
+    // facet index)
+    std::vector<std::pair<int, std::size_t> > ghost_facets;
+
     for (MeshEntityIterator f(mesh, D - 1, "all"); !f.end(); ++f)
     {
       // Insert shared facets into mapping
@@ -1053,47 +1054,64 @@ void DistributedMeshTools::init_facet_cell_connections(Mesh& mesh)
       // Copy local values
       const std::size_t n_cells = f->num_entities(D);
       num_global_neighbors[f->index()] = n_cells;
-      
+
       if (f->is_ghost() && n_cells == 1)
       {
         // Singly attached ghost facet - check with owner of attached cell
         const Cell c(mesh, f->entities(D)[0]);
         dolfin_assert(c.is_ghost());
-        send_facet[c.owner()].push_back(f->global_index());
+        ghost_facets.push_back(std::make_pair(c.owner(), f->index()));
       }
     }
-    
-    MPI::all_to_all(mesh.mpi_comm(), send_facet, recv_facet);
-    
-    // Convert received global facet index into number of attached
-    // cells and return to sender
-    std::vector<std::vector<std::size_t> > send_response(mpi_size);  
-    for (unsigned int p = 0; p != mpi_size; ++p)
+
+    // Pack global facet indices by owner. Only the owners of
+    // attached ghost cells are contacted.
+    std::sort(ghost_facets.begin(), ghost_facets.end());
+    std::vector<int> destinations;
+    std::vector<int> send_offsets(1, 0);
+    std::vector<std::size_t> send_facet(ghost_facets.size());
+    for (std::size_t i = 0; i < ghost_facets.size(); ++i)
     {
-      for (auto r = recv_facet[p].begin(); r != recv_facet[p].end(); ++r)
+      if (destinations.empty() || destinations.back() != ghost_facets[i].first)
       {
-        auto map_it = global_to_local_facet.find(*r);
-        dolfin_assert(map_it != global_to_local_facet.end());
-        const Facet local_facet(mesh, map_it->second);
-        const std::size_t n_cells = local_facet.num_entities(D);
-        send_response[p].push_back(n_cells);
+        destinations.push_back(ghost_facets[i].first);
+        send_offsets.push_back(send_offsets.back());
       }
+      send_facet[i] = Facet(mesh, ghost_facets[i].second).global_index();
+      ++send_offsets.back();
     }
-    
-    MPI::all_to_all(mesh.mpi_comm(), send_response, recv_facet);
-    
-    // Insert received result into same facet that it came from
-    for (unsigned int p = 0; p != mpi_size; ++p)
+
+    std::vector<int> sources, recv_offsets;
+    std::vector<std::size_t> recv_facet;
+    MPI::neighbor_all_to_all(mesh.mpi_comm(), destinations, send_offsets,
+                             send_facet, sources, recv_offsets, recv_facet);
+
+    // Convert received global facet index into number of attached
+    // cells and return to sender (the communication pattern is the
+    // reverse of the one above, so sources need not be recomputed)
+    std::vector<std::size_t> send_response(recv_facet.size());
+    for (std::size_t i = 0; i < recv_facet.size(); ++i)
     {
-      for (unsigned int i = 0; i != recv_facet[p].size(); ++i)
-      {
-        auto f_it = global_to_local_facet.find(send_facet[p][i]);
-        dolfin_assert(f_it != global_to_local_facet.end());
-        num_global_neighbors[f_it->second] = recv_facet[p][i];
-      }
+      auto map_it = global_to_local_facet.find(recv_facet[i]);
+      dolfin_assert(map_it != global_to_local_facet.end());
+      const Facet local_facet(mesh, map_it->second);
+      send_response[i] = local_facet.num_entities(D);
     }
+
+    std::vector<int> response_offsets;
+    std::vector<std::size_t> recv_response;
+    std::vector<MPI_Request> requests;
+    MPI::neighbor_all_to_all_begin(mesh.mpi_comm(), sources, recv_offsets,
+                                   send_response, destinations,
+                                   response_offsets, recv_response, requests);
+    MPI::wait_all(requests);
+
+    // Insert received result into same facet that it came from
+    dolfin_assert(recv_response.size() == ghost_facets.size());
+    for (std::size_t i = 0; i < ghost_facets.size(); ++i)
+      num_global_neighbors[ghost_facets[i].second] = recv_response[i];
   }
-  
+
   mesh.topology()(D - 1, D).set_global_size(num_global_neighbors);
 }
 //-----------------------------------------------------------------------------
@@ -18,7 +18,7 @@
 // Modified by Anders Logg 2008-2011
 //
 // First added:  2008-11-28
-// Last changed: 2012-11-24
+// Last changed: 2026-10-19
 
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
@@ -26,6 +26,7 @@
 #include "Cell.h"
 #include "Mesh.h"
 #include "MeshDomains.h"
+#include "MeshRange.h"
 #include "Vertex.h"
 #include "LocalMeshData.h"
 
@@ -142,28 +143,25 @@ void LocalMeshData::extract_mesh_data(const Mesh& mesh)
   num_vertices_per_cell = mesh.type().num_entities(0);
 
   // Get coordinates for all vertices stored on local processor
+  const StridedArray<double> x = MeshRange::coordinates(mesh);
   vertex_coordinates.resize(boost::extents[mesh.num_vertices()][gdim]);
-  for (VertexIterator vertex(mesh); !vertex.end(); ++vertex)
-  {
-    const std::size_t index = vertex->index();
-    std::copy(vertex->x(), vertex->x() + gdim, vertex_coordinates[index].begin());
-  }
+  for (std::size_t v : MeshRange::entities(mesh, 0))
+    std::copy(x[v], x[v] + gdim, vertex_coordinates[v].begin());
 
   // Get global vertex indices for all vertices stored on local processor
   vertex_indices.reserve(mesh.num_vertices());
-  for (VertexIterator vertex(mesh); !vertex.end(); ++vertex)
-    vertex_indices.push_back(vertex->index());
+  for (std::size_t v : MeshRange::entities(mesh, 0))
+    vertex_indices.push_back(v);
 
   // Get global vertex indices for all cells stored on local processor
+  const StridedArray<unsigned int> cells = MeshRange::cells(mesh);
   cell_vertices.resize(boost::extents[mesh.num_cells()][num_vertices_per_cell]);
   global_cell_indices.reserve(mesh.num_cells());
-  //  std::vector<std::size_t> vertices(num_vertices_per_cell);
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  for (std::size_t c : MeshRange::entities(mesh, tdim))
   {
-    const std::size_t index = cell->index();
-    global_cell_indices.push_back(index);
-    std::copy(cell->entities(0), cell->entities(0) + num_vertices_per_cell,
-              cell_vertices[index].begin());
+    global_cell_indices.push_back(c);
+    std::copy(cells[c], cells[c] + num_vertices_per_cell,
+              cell_vertices[c].begin());
   }
 
   cout << "Number of global vertices: " << num_global_vertices << endl;
@@ -26,7 +26,7 @@
 // Modified by Jan Blechta 2013
 //
 // First added:  2006-05-09
-// Last changed: 2014-08-11
+// Last changed: 2026-10-19
 
 #include <dolfin/ale/ALE.h>
 #include <dolfin/common/Array.h>
@@ -56,6 +56,9 @@ using namespace dolfin;
 //-----------------------------------------------------------------------------
 Mesh::Mesh() : Variable("mesh", "DOLFIN mesh"),
                Hierarchical<Mesh>(*this),
+               _tree_version(0), _topology_hash(0),
+               _topology_hash_version(0), _geometry_hash(0),
+               _geometry_hash_version(0),
                _cell_type(0),
                _ordered(false),
                _cell_orientations(0),
@@ -66,6 +69,9 @@ Mesh::Mesh() : Variable("mesh", "DOLFIN mesh"),
 //-----------------------------------------------------------------------------
 Mesh::Mesh(MPI_Comm comm) : Variable("mesh", "DOLFIN mesh"),
                Hierarchical<Mesh>(*this),
+               _tree_version(0), _topology_hash(0),
+               _topology_hash_version(0), _geometry_hash(0),
+               _geometry_hash_version(0),
                _cell_type(0),
                _ordered(false),
                _cell_orientations(0),
@@ -76,6 +82,9 @@ Mesh::Mesh(MPI_Comm comm) : Variable("mesh", "DOLFIN mesh"),
 //-----------------------------------------------------------------------------
 Mesh::Mesh(const Mesh& mesh) : Variable("mesh", "DOLFIN mesh"),
                                Hierarchical<Mesh>(*this),
+                               _tree_version(0), _topology_hash(0),
+                               _topology_hash_version(0), _geometry_hash(0),
+                               _geometry_hash_version(0),
                                _cell_type(0),
                                _ordered(false),
                                _cell_orientations(0),
@@ -86,6 +95,10 @@ Mesh::Mesh(const Mesh& mesh) : Variable("mesh", "DOLFIN mesh"),
 //-----------------------------------------------------------------------------
 Mesh::Mesh(std::string filename) : Variable("mesh", "DOLFIN mesh"),
                                    Hierarchical<Mesh>(*this),
+                                   _tree_version(0), _topology_hash(0),
+                                   _topology_hash_version(0),
+                                   _geometry_hash(0),
+                                   _geometry_hash_version(0),
                                    _cell_type(0),
                                    _ordered(false),
                                    _cell_orientations(0),
@@ -98,7 +111,9 @@ Mesh::Mesh(std::string filename) : Variable("mesh", "DOLFIN mesh"),
 //-----------------------------------------------------------------------------
 Mesh::Mesh(MPI_Comm comm, std::string filename)
   : Variable("mesh", "DOLFIN mesh"), Hierarchical<Mesh>(*this),
-    _cell_type(0), _ordered(false), _cell_orientations(0), _mpi_comm(comm)
+    _tree_version(0), _topology_hash(0), _topology_hash_version(0),
+    _geometry_hash(0), _geometry_hash_version(0), _cell_type(0),
+    _ordered(false), _cell_orientations(0), _mpi_comm(comm)
 {
   File file(_mpi_comm, filename);
   file >> *this;
@@ -107,7 +122,9 @@ Mesh::Mesh(MPI_Comm comm, std::string filename)
 //-----------------------------------------------------------------------------
 Mesh::Mesh(MPI_Comm comm, LocalMeshData& local_mesh_data)
   : Variable("mesh", "DOLFIN mesh"), Hierarchical<Mesh>(*this),
-    _cell_type(0), _ordered(false), _cell_orientations(0),
+    _tree_version(0), _topology_hash(0), _topology_hash_version(0),
+    _geometry_hash(0), _geometry_hash_version(0), _cell_type(0),
+    _ordered(false), _cell_orientations(0),
     _mpi_comm(comm)
 {
   MeshPartitioning::build_distributed_mesh(*this, local_mesh_data);
@@ -270,6 +287,9 @@ void Mesh::order()
   // Order mesh
   MeshOrdering::order(*this);
 
+  // Cell-vertex connectivity may have been renumbered
+  _topology.changed();
+
   // Remember that the mesh has been ordered
   _ordered = true;
 
@@ -377,11 +397,18 @@ Mesh::color(std::vector<std::size_t> coloring_type) const
 //-----------------------------------------------------------------------------
 std::shared_ptr<BoundingBoxTree> Mesh::bounding_box_tree() const
 {
-  // Allocate and build tree if necessary
+  // Allocate and build tree if necessary, and update it (refit or
+  // rebuild) if the mesh has changed
   if (!_tree)
   {
     _tree.reset(new BoundingBoxTree());
     _tree->build(*this);
+    _tree_version = version();
+  }
+  else if (_tree_version != version())
+  {
+    _tree->refit();
+    _tree_version = version();
   }
 
   return _tree;
@@ -429,9 +456,20 @@ double Mesh::rmax() const
 //-----------------------------------------------------------------------------
 std::size_t Mesh::hash() const
 {
-  // Get local hashes
-  const std::size_t kt_local = _topology.hash();
-  const std::size_t kg_local = _geometry.hash();
+  // Get local hashes, recomputing only if topology or geometry has
+  // changed since last call
+  if (_topology_hash_version != _topology.version())
+  {
+    _topology_hash = _topology.hash();
+    _topology_hash_version = _topology.version();
+  }
+  if (_geometry_hash_version != _geometry.version())
+  {
+    _geometry_hash = _geometry.hash();
+    _geometry_hash_version = _geometry.version();
+  }
+  const std::size_t kt_local = _topology_hash;
+  const std::size_t kg_local = _geometry_hash;
 
   // Compute global hash
   const std::size_t kt = hash_global(_mpi_comm, kt_local);
@@ -26,7 +26,7 @@
 // Modified by Jan Blechta 2013
 //
 // First added:  2006-05-08
-// Last changed: 2014-08-11
+// Last changed: 2026-10-19
 
 #ifndef __MESH_H
 #define __MESH_H
@@ -225,7 +225,8 @@ namespace dolfin
     std::size_t num_entities(std::size_t d) const
     { return _topology.size(d); }
 
-    /// Get vertex coordinates.
+    /// Get vertex coordinates. The coordinates are marked as changed,
+    /// since they may be modified through the returned reference.
     ///
     /// *Returns*
     ///     std::vector<double>&
@@ -236,7 +237,7 @@ namespace dolfin
     ///
     ///         No example code available for this function.
     std::vector<double>& coordinates()
-    { return _geometry.x(); }
+    { _geometry.changed(); return _geometry.x(); }
 
     /// Return coordinates of all vertices (const version).
     const std::vector<double>& coordinates() const
@@ -326,12 +327,13 @@ namespace dolfin
     { return _domains; }
 
     /// Get bounding box tree for mesh. The bounding box tree is
-    /// initialized and built upon the first call to this
-    /// function. The bounding box tree can be used to compute
-    /// collisions between the mesh and other objects. It is the
-    /// responsibility of the caller to use (and possibly rebuild) the
-    /// tree. It is stored as a (mutable) member of the mesh to enable
-    /// sharing of the bounding box tree data structure.
+    /// initialized and built upon the first call to this function,
+    /// and updated if the mesh has changed since (see version() and
+    /// BoundingBoxTree::refit()). The
+    /// bounding box tree can be used to compute collisions between
+    /// the mesh and other objects. It is stored as a (mutable) member
+    /// of the mesh to enable sharing of the bounding box tree data
+    /// structure.
     std::shared_ptr<BoundingBoxTree> bounding_box_tree() const;
 
     /// Get mesh data.
@@ -588,7 +590,9 @@ namespace dolfin
     double rmax() const;
 
     /// Compute hash of mesh, currently based on the has of the mesh
-    /// geometry and mesh topology.
+    /// geometry and mesh topology. The local hashes are cached and
+    /// only recomputed when the geometry or topology has changed,
+    /// but the function is still collective.
     ///
     /// *Returns*
     ///     std::size_t
@@ -596,6 +600,17 @@ namespace dolfin
     ///
     std::size_t hash() const;
 
+    /// Return state token of mesh. The token changes whenever the
+    /// geometry or topology changes (see MeshGeometry::version() and
+    /// MeshTopology::version()). Unlike hash(), it is cheap and not
+    /// collective, and may be used to key cached data on the mesh.
+    ///
+    /// *Returns*
+    ///     std::size_t
+    ///         The sum of the geometry and topology versions.
+    std::size_t version() const
+    { return _topology.version() + _geometry.version(); }
+
     /// Informal string representation.
     ///
     /// *Arguments*
@@ -664,6 +679,14 @@ namespace dolfin
     // and is allocated and built when bounding_box_tree() is called.
     mutable std::shared_ptr<BoundingBoxTree> _tree;
 
+    // Mesh version for which the bounding box tree was built
+    mutable std::size_t _tree_version;
+
+    // Cached local hashes of topology and geometry, and the versions
+    // for which they were computed
+    mutable std::size_t _topology_hash, _topology_hash_version;
+    mutable std::size_t _geometry_hash, _geometry_hash_version;
+
     // Cell type
     CellType* _cell_type;
 
@@ -19,8 +19,9 @@
 // Modified by Johannes Ring 2011
 //
 // First added:  2010-11-15
-// Last changed: 2011-11-14
+// Last changed: 2026-10-19
 
+#include <algorithm>
 #include <map>
 #include <utility>
 #include <dolfin/common/Array.h>
@@ -29,6 +30,7 @@
 #include <dolfin/graph/GraphBuilder.h>
 #include <dolfin/graph/GraphColoring.h>
 #include <dolfin/log/log.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Cell.h"
 #include "Edge.h"
 #include "Facet.h"
@@ -107,6 +109,37 @@ std::size_t MeshColoring::compute_colors(const Mesh& mesh,
                  "Mesh coloring does not support dim i - j coloring");
   }
 
+  // Use the threaded greedy coloring on CSR graphs if requested
+  const std::string colorer = parameters["graph_coloring_library"];
+  if (colorer == "greedy")
+  {
+    const bool balanced = parameters["balanced_graph_coloring"];
+
+    // A symmetric coloring type [d0, ..., dm, ..., d0] connects two
+    // entities if they are both connected to some entity of dimension
+    // dm. This is a distance-2 coloring of the d0 -> dm graph, which
+    // avoids building the (much denser) d0 -> d0 graph.
+    const std::size_t n = coloring_type.size();
+    if (n % 2 == 1 && std::equal(coloring_type.begin(),
+                                 coloring_type.begin() + n/2,
+                                 coloring_type.rbegin()))
+    {
+      const std::vector<std::size_t> path(coloring_type.begin(),
+                                          coloring_type.begin() + n/2 + 1);
+      const CSRGraph<int> graph = GraphBuilder::local_csr_graph(mesh, path);
+      return GraphColoring::compute_local_distance2_coloring(graph,
+                                          mesh.num_entities(path.back()),
+                                          colors, balanced);
+    }
+    else
+    {
+      const CSRGraph<int> graph
+        = GraphBuilder::local_csr_graph(mesh, coloring_type);
+      return GraphColoring::compute_local_vertex_coloring(graph, colors,
+                                                          balanced);
+    }
+  }
+
   // Create graph
   Graph graph;
   if (coloring_type.size() == 3)
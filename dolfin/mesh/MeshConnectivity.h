@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-05-09
-// Last changed: 2010-11-28
+// Last changed: 2026-10-19
 
 #ifndef __MESH_CONNECTIVITY_H
 #define __MESH_CONNECTIVITY_H
@@ -90,6 +90,12 @@ namespace dolfin
     const std::vector<unsigned int>& operator() () const
     { return _connections; }
 
+    /// Return position of first connection for each entity in the
+    /// contiguous array (size is number of entities + 1, or zero if
+    /// the connectivity has not been initialized)
+    const std::vector<unsigned int>& offsets() const
+    { return index_to_position; }
+
     /// Clear all data
     void clear();
 
@@ -18,7 +18,7 @@
 // Modified by Benjamin Kehlet, 2012
 //
 // First added:  2006-05-16
-// Last changed: 2014-02-06
+// Last changed: 2026-10-19
 
 #include <dolfin/log/log.h>
 #include <dolfin/geometry/Point.h>
@@ -264,8 +264,12 @@ void MeshEditor::add_cell(std::size_t local_index, std::size_t global_index,
 //-----------------------------------------------------------------------------
 void MeshEditor::close(bool order)
 {
-  // Order mesh if requested
+  // Vertices and cells have been added
   dolfin_assert(_mesh);
+  _mesh->topology().changed();
+  _mesh->geometry().changed();
+
+  // Order mesh if requested
   if (order && !_mesh->ordered())
     _mesh->order();
 
@@ -19,7 +19,7 @@
 // Modified by Kristoffer Selim, 2008.
 //
 // First added:  2006-05-19
-// Last changed: 2010-04-29
+// Last changed: 2026-10-19
 
 #include <sstream>
 #include <boost/functional/hash.hpp>
@@ -29,13 +29,17 @@
 
 using namespace dolfin;
 
+// Initialize static data
+std::atomic<std::size_t> MeshGeometry::_num_changes(0);
+
 //-----------------------------------------------------------------------------
-MeshGeometry::MeshGeometry() : _dim(0)
+MeshGeometry::MeshGeometry() : _dim(0), _version(++_num_changes)
 {
   // Do nothing
 }
 //-----------------------------------------------------------------------------
-MeshGeometry::MeshGeometry(const MeshGeometry& geometry) : _dim(0)
+MeshGeometry::MeshGeometry(const MeshGeometry& geometry)
+  : _dim(0), _version(++_num_changes)
 {
   *this = geometry;
 }
@@ -52,6 +56,7 @@ const MeshGeometry& MeshGeometry::operator= (const MeshGeometry& geometry)
   coordinates             = geometry.coordinates;
   position_to_local_index = geometry.position_to_local_index;
   local_index_to_position = geometry.local_index_to_position;
+  changed();
 
   return *this;
 }
@@ -79,6 +84,7 @@ void MeshGeometry::clear()
   coordinates.clear();
   position_to_local_index.clear();
   local_index_to_position.clear();
+  changed();
 }
 //-----------------------------------------------------------------------------
 void MeshGeometry::init(std::size_t dim, std::size_t size)
@@ -95,6 +101,7 @@ void MeshGeometry::init(std::size_t dim, std::size_t size)
 
   // Save dimension and size
   _dim = dim;
+  changed();
 }
 //-----------------------------------------------------------------------------
 void MeshGeometry::set(std::size_t local_index,
@@ -18,11 +18,12 @@
 // Modified by Garth N. Wells, 2008.
 //
 // First added:  2006-05-08
-// Last changed: 2010-11-29
+// Last changed: 2026-10-19
 
 #ifndef __MESH_GEOMETRY_H
 #define __MESH_GEOMETRY_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <dolfin/geometry/Point.h>
@@ -111,7 +112,9 @@ namespace dolfin
     /// Initialize coordinate list to given dimension and size
     void init(std::size_t dim, std::size_t size);
 
-    /// Set value of coordinate
+    /// Set value of coordinate. The version is not increased, so
+    /// several threads may set different coordinates concurrently;
+    /// call changed() (or MeshEditor::close) when done.
     //void set(std::size_t n, std::size_t i, double x);
     void set(std::size_t local_index, const std::vector<double>& x);
 
@@ -123,6 +126,19 @@ namespace dolfin
     ///
     std::size_t hash() const;
 
+    /// Return version of the coordinates. The version increases
+    /// each time the coordinates are initialized, assigned or marked
+    /// as changed, and may be used to detect changes without hashing
+    /// or communication. Writing through the non-const x() accessors
+    /// does not update the version; call changed() when done.
+    std::size_t version() const
+    { return _version; }
+
+    /// Mark coordinates as changed (increases version). Call this
+    /// after modifying coordinates through x() or set().
+    void changed()
+    { _version = ++_num_changes; }
+
     /// Return informal string representation (pretty-print)
     std::string str(bool verbose) const;
 
@@ -144,6 +160,12 @@ namespace dolfin
     // Local coordinate indices (local index -> array position)
     std::vector<unsigned int> local_index_to_position;
 
+    // Version of coordinates
+    std::size_t _version;
+
+    // Number of changes to all geometries (used to create versions)
+    static std::atomic<std::size_t> _num_changes;
+
   };
 
 }
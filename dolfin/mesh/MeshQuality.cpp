@@ -16,10 +16,15 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-10-07
-// Last changed:
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 #include <dolfin/common/MPI.h>
+#include <dolfin/common/constants.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Cell.h"
 #include "Mesh.h"
 #include "MeshFunction.h"
@@ -27,6 +32,66 @@
 
 using namespace dolfin;
 
+const std::size_t MeshQualityStatistics::num_measures;
+const std::size_t MeshQuality::block_size;
+
+//-----------------------------------------------------------------------------
+MeshQualityStatistics::MeshQualityStatistics(std::size_t num_bins)
+  : _num_bins(num_bins), _num_cells(0),
+    _min(num_measures, std::numeric_limits<double>::max()),
+    _max(num_measures, -std::numeric_limits<double>::max()),
+    _histogram(num_measures*num_bins, 0.0)
+{
+  dolfin_assert(num_bins > 0);
+}
+//-----------------------------------------------------------------------------
+double MeshQualityStatistics::min(std::string measure) const
+{
+  return _min[index(measure)];
+}
+//-----------------------------------------------------------------------------
+double MeshQualityStatistics::max(std::string measure) const
+{
+  return _max[index(measure)];
+}
+//-----------------------------------------------------------------------------
+std::vector<double> MeshQualityStatistics::bins(std::string measure) const
+{
+  const std::pair<double, double> r = range(index(measure));
+  const double interval = (r.second - r.first)/static_cast<double>(_num_bins);
+  std::vector<double> bins(_num_bins);
+  for (std::size_t i = 0; i < _num_bins; ++i)
+    bins[i] = r.first + static_cast<double>(i)*interval + interval/2.0;
+  return bins;
+}
+//-----------------------------------------------------------------------------
+std::vector<double>
+MeshQualityStatistics::histogram(std::string measure) const
+{
+  const std::size_t m = index(measure);
+  return std::vector<double>(_histogram.begin() + m*_num_bins,
+                             _histogram.begin() + (m + 1)*_num_bins);
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshQualityStatistics::index(std::string measure)
+{
+  if (measure == "radius_ratio")
+    return 0;
+  else if (measure == "min_angle")
+    return 1;
+  else if (measure == "edge_ratio")
+    return 2;
+
+  dolfin_error("MeshQuality.cpp",
+               "access mesh quality statistics",
+               "Unknown quality measure \"%s\"", measure.c_str());
+  return 0;
+}
+//-----------------------------------------------------------------------------
+std::pair<double, double> MeshQualityStatistics::range(std::size_t measure)
+{
+  return measure == 1 ? std::make_pair(0.0, 90.0) : std::make_pair(0.0, 1.0);
+}
 //-----------------------------------------------------------------------------
 dolfin::CellFunction<double>
 MeshQuality::radius_ratios(std::shared_ptr<const Mesh> mesh)
@@ -34,55 +99,25 @@ MeshQuality::radius_ratios(std::shared_ptr<const Mesh> mesh)
   // Create CellFunction
   CellFunction<double> cf(mesh, 0.0);
 
-  // Compute radius ration
-  for (CellIterator cell(*mesh); !cell.end(); ++cell)
-    cf[*cell] = cell->radius_ratio();
+  // Compute radius ratio
+  compute(*mesh, cf.values(), NULL);
 
   return cf;
 }
 //-----------------------------------------------------------------------------
 std::pair<double, double> MeshQuality::radius_ratio_min_max(const Mesh& mesh)
 {
-  CellIterator cell(mesh);
-  double qmin = cell->radius_ratio();
-  double qmax = cell->radius_ratio();
-  for (; !cell.end(); ++cell)
-  {
-    qmin = std::min(qmin, cell->radius_ratio());
-    qmax = std::max(qmax, cell->radius_ratio());
-  }
-
-  qmin = MPI::min(mesh.mpi_comm(), qmin);
-  qmax = MPI::max(mesh.mpi_comm(), qmax);
-  return std::make_pair(qmin, qmax);
+  const MeshQualityStatistics q = statistics(mesh, 1);
+  return std::make_pair(q.min("radius_ratio"), q.max("radius_ratio"));
 }
 //-----------------------------------------------------------------------------
 std::pair<std::vector<double>, std::vector<double> >
 MeshQuality::radius_ratio_histogram_data(const Mesh& mesh,
                                          std::size_t num_bins)
 {
-  std::vector<double> bins(num_bins), values(num_bins, 0.0);
-  dolfin_assert(radius_ratio_min_max(mesh).second <= 1.0);
-
-  const double interval = 1.0/static_cast<double>(num_bins);
-  for (std::size_t i = 0; i < num_bins; ++i)
-    bins[i] = static_cast<double>(i)*interval + interval/2.0;
-
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
-  {
-    const double ratio = cell->radius_ratio();
-
-    // Compute 'bin' index, and handle special case that ratio = 1.0
-    const std::size_t slot
-      = std::min(static_cast<std::size_t>(ratio/interval), num_bins -1);
-
-    values[slot] += 1.0;
-  }
-
-  for (std::size_t i = 0; i < values.size(); ++i)
-    values[i] = MPI::sum(mesh.mpi_comm(), values[i]);
-
-  return std::make_pair(bins, values);
+  const MeshQualityStatistics q = statistics(mesh, num_bins);
+  dolfin_assert(q.num_cells() == 0 || q.max("radius_ratio") <= 1.0);
+  return std::make_pair(q.bins("radius_ratio"), q.histogram("radius_ratio"));
 }
 //-----------------------------------------------------------------------------
 std::string
@@ -133,3 +168,307 @@ MeshQuality::radius_ratio_matplotlib_histogram(const Mesh& mesh,
   return matplotlib.str();
 }
 //-----------------------------------------------------------------------------
+MeshQualityStatistics MeshQuality::statistics(const Mesh& mesh,
+                                              std::size_t num_bins)
+{
+  // Compute local statistics
+  MeshQualityStatistics q(num_bins);
+  compute(mesh, NULL, &q);
+
+  // Reduce across processes
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  q._num_cells = MPI::sum(mpi_comm, q._num_cells);
+  for (std::size_t m = 0; m < MeshQualityStatistics::num_measures; ++m)
+  {
+    q._min[m] = MPI::min(mpi_comm, q._min[m]);
+    q._max[m] = MPI::max(mpi_comm, q._max[m]);
+  }
+  for (std::size_t i = 0; i < q._histogram.size(); ++i)
+    q._histogram[i] = MPI::sum(mpi_comm, q._histogram[i]);
+
+  return q;
+}
+//-----------------------------------------------------------------------------
+void MeshQuality::compute(const Mesh& mesh, double* radius_ratios,
+                          MeshQualityStatistics* statistics)
+{
+  // Check cell type
+  const CellType::Type cell_type = mesh.type().cell_type();
+  if (cell_type != CellType::interval && cell_type != CellType::triangle
+      && cell_type != CellType::tetrahedron)
+  {
+    dolfin_error("MeshQuality.cpp",
+                 "compute mesh quality",
+                 "Mesh quality is only implemented for simplicial cells");
+  }
+  if (cell_type == CellType::tetrahedron && mesh.geometry().dim() != 3)
+  {
+    dolfin_error("MeshQuality.cpp",
+                 "compute mesh quality",
+                 "Tetrahedra must be embedded in R^3");
+  }
+
+  // Statistics are computed for owned cells only
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t num_cells = mesh.num_cells();
+  const std::size_t num_owned_cells = mesh.topology().ghost_offset(D);
+
+  const std::size_t num_measures = MeshQualityStatistics::num_measures;
+  const int num_blocks = (num_cells + block_size - 1)/block_size;
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel num_threads(num_threads)
+  #endif
+  {
+    // Thread-local statistics
+    MeshQualityStatistics q(statistics ? statistics->_num_bins : 1);
+    std::vector<double> values(num_measures*block_size);
+
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int b = 0; b < num_blocks; b++)
+    {
+      const std::size_t cell0 = b*block_size;
+      compute_block(mesh, cell0, values.data());
+
+      const std::size_t n = std::min(block_size, num_cells - cell0);
+      if (radius_ratios)
+      {
+        for (std::size_t l = 0; l < n; l++)
+          radius_ratios[cell0 + l] = values[l];
+      }
+
+      if (!statistics)
+        continue;
+      for (std::size_t l = 0; l < n && cell0 + l < num_owned_cells; l++)
+      {
+        q._num_cells++;
+        for (std::size_t m = 0; m < num_measures; m++)
+        {
+          const double value = values[m*block_size + l];
+          q._min[m] = std::min(q._min[m], value);
+          q._max[m] = std::max(q._max[m], value);
+
+          // Compute bin index (values outside range go in first or
+          // last bin)
+          const std::pair<double, double> r = MeshQualityStatistics::range(m);
+          const double interval
+            = (r.second - r.first)/static_cast<double>(q._num_bins);
+          const double slot = std::max(0.0, (value - r.first)/interval);
+          const std::size_t i
+            = std::min(static_cast<std::size_t>(slot), q._num_bins - 1);
+          q._histogram[m*q._num_bins + i] += 1.0;
+        }
+      }
+    }
+
+    // Merge thread-local statistics
+    if (statistics)
+    {
+      #ifdef HAS_OPENMP
+      #pragma omp critical
+      #endif
+      {
+        statistics->_num_cells += q._num_cells;
+        for (std::size_t m = 0; m < num_measures; m++)
+        {
+          statistics->_min[m] = std::min(statistics->_min[m], q._min[m]);
+          statistics->_max[m] = std::max(statistics->_max[m], q._max[m]);
+        }
+        for (std::size_t i = 0; i < q._histogram.size(); i++)
+          statistics->_histogram[i] += q._histogram[i];
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+void MeshQuality::compute_block(const Mesh& mesh, std::size_t cell0,
+                                double* values)
+{
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t gdim = mesh.geometry().dim();
+  const std::size_t num_cells = mesh.num_cells();
+  const std::vector<unsigned int>& cells = mesh.cells();
+  const std::vector<double>& coordinates = mesh.geometry().x();
+  const std::size_t B = block_size;
+
+  // Gather vertex coordinates, padded to R^3, as x[v][i][lane]
+  double x[4][3][block_size];
+  for (std::size_t l = 0; l < B; l++)
+  {
+    const std::size_t c = std::min(cell0 + l, num_cells - 1);
+    for (std::size_t v = 0; v <= D; v++)
+    {
+      const double* xv = coordinates.data() + cells[c*(D + 1) + v]*gdim;
+      for (std::size_t i = 0; i < 3; i++)
+        x[v][i][l] = i < gdim ? xv[i] : 0.0;
+    }
+  }
+
+  // Edge vectors and lengths, as e[k][i][lane] for edge k = (v0, v1)
+  // in the order (0, 1), (0, 2), (1, 2), (0, 3), (1, 3), (2, 3)
+  static const std::size_t edge_vertices[6][2]
+    = {{0, 1}, {0, 2}, {1, 2}, {0, 3}, {1, 3}, {2, 3}};
+  const std::size_t num_edges = D*(D + 1)/2;
+  double e[6][3][block_size], length[6][block_size];
+  for (std::size_t k = 0; k < num_edges; k++)
+  {
+    const std::size_t v0 = edge_vertices[k][0];
+    const std::size_t v1 = edge_vertices[k][1];
+    for (std::size_t i = 0; i < 3; i++)
+      for (std::size_t l = 0; l < B; l++)
+        e[k][i][l] = x[v1][i][l] - x[v0][i][l];
+    for (std::size_t l = 0; l < B; l++)
+    {
+      length[k][l] = std::sqrt(e[k][0][l]*e[k][0][l] + e[k][1][l]*e[k][1][l]
+                               + e[k][2][l]*e[k][2][l]);
+    }
+  }
+
+  double* radius_ratio = values;
+  double* min_angle = values + B;
+  double* edge_ratio = values + 2*B;
+
+  // Edge ratio
+  for (std::size_t l = 0; l < B; l++)
+  {
+    double lmin = length[0][l], lmax = length[0][l];
+    for (std::size_t k = 1; k < num_edges; k++)
+    {
+      lmin = std::min(lmin, length[k][l]);
+      lmax = std::max(lmax, length[k][l]);
+    }
+    edge_ratio[l] = lmax > 0.0 ? lmin/lmax : 0.0;
+  }
+
+  if (D == 1)
+  {
+    for (std::size_t l = 0; l < B; l++)
+    {
+      radius_ratio[l] = length[0][l] > 0.0 ? 1.0 : 0.0;
+      min_angle[l] = 180.0;
+    }
+  }
+  else if (D == 2)
+  {
+    for (std::size_t l = 0; l < B; l++)
+    {
+      // Area from cross product of edges (0, 1) and (0, 2)
+      const double n0 = e[0][1][l]*e[1][2][l] - e[0][2][l]*e[1][1][l];
+      const double n1 = e[0][2][l]*e[1][0][l] - e[0][0][l]*e[1][2][l];
+      const double n2 = e[0][0][l]*e[1][1][l] - e[0][1][l]*e[1][0][l];
+      const double V = 0.5*std::sqrt(n0*n0 + n1*n1 + n2*n2);
+
+      // Side lengths opposite vertices 0, 1 and 2
+      const double a = length[2][l];
+      const double b = length[1][l];
+      const double c = length[0][l];
+
+      // Radius ratio 2*dim*inradius/diameter, with inradius
+      // 2*V/(a + b + c) and diameter (2*circumradius) a*b*c/(2*V)
+      if (V == 0.0)
+        radius_ratio[l] = 0.0;
+      else
+      {
+        const double r = 2.0*V/(a + b + c);
+        radius_ratio[l] = 4.0*r/(0.5*a*b*c/V);
+      }
+
+      // Minimum angle from the law of cosines
+      double angle = 0.0;
+      if (a > 0.0 && b > 0.0 && c > 0.0)
+      {
+        const double c0 = (b*b + c*c - a*a)/(2.0*b*c);
+        const double c1 = (a*a + c*c - b*b)/(2.0*a*c);
+        const double c2 = (a*a + b*b - c*c)/(2.0*a*b);
+        const double cmax = std::min(1.0, std::max(c0, std::max(c1, c2)));
+        angle = std::acos(cmax)*180.0/DOLFIN_PI;
+      }
+      min_angle[l] = angle;
+    }
+  }
+  else
+  {
+    // Faces opposite each vertex (as indices of two edges from a
+    // common vertex)
+    static const std::size_t face_edges[4][2]
+      = {{2, 4}, {1, 3}, {0, 3}, {0, 1}};
+
+    // Vertices opposite each edge (for dihedral angles)
+    static const std::size_t opposite_vertices[6][2]
+      = {{2, 3}, {1, 3}, {0, 3}, {1, 2}, {0, 2}, {0, 1}};
+
+    for (std::size_t l = 0; l < B; l++)
+    {
+      // Volume
+      const double det
+        = e[0][0][l]*(e[1][1][l]*e[3][2][l] - e[1][2][l]*e[3][1][l])
+        - e[0][1][l]*(e[1][0][l]*e[3][2][l] - e[1][2][l]*e[3][0][l])
+        + e[0][2][l]*(e[1][0][l]*e[3][1][l] - e[1][1][l]*e[3][0][l]);
+      const double V = std::abs(det)/6.0;
+
+      // Total area of faces
+      double A = 0.0;
+      for (std::size_t f = 0; f < 4; f++)
+      {
+        const std::size_t k0 = face_edges[f][0];
+        const std::size_t k1 = face_edges[f][1];
+        const double n0 = e[k0][1][l]*e[k1][2][l] - e[k0][2][l]*e[k1][1][l];
+        const double n1 = e[k0][2][l]*e[k1][0][l] - e[k0][0][l]*e[k1][2][l];
+        const double n2 = e[k0][0][l]*e[k1][1][l] - e[k0][1][l]*e[k1][0][l];
+        A += 0.5*std::sqrt(n0*n0 + n1*n1 + n2*n2);
+      }
+
+      // Radius ratio 2*dim*inradius/diameter, with inradius 3*V/A and
+      // diameter (2*circumradius) from products of opposite edges
+      if (V == 0.0)
+        radius_ratio[l] = 0.0;
+      else
+      {
+        const double r = 3.0*V/A;
+        const double la = length[2][l]*length[3][l];
+        const double lb = length[1][l]*length[4][l];
+        const double lc = length[0][l]*length[5][l];
+        const double s = 0.5*(la + lb + lc);
+        const double area = std::sqrt(s*(s - la)*(s - lb)*(s - lc));
+        radius_ratio[l] = 6.0*r/(area/(3.0*V));
+      }
+
+      // Minimum dihedral angle: angle between the components of the
+      // two opposite vertices orthogonal to each edge
+      double angle = 180.0;
+      for (std::size_t k = 0; k < 6; k++)
+      {
+        const std::size_t v0 = edge_vertices[k][0];
+        const double ee = length[k][l]*length[k][l];
+        double u[2][3];
+        for (std::size_t j = 0; j < 2; j++)
+        {
+          const std::size_t w = opposite_vertices[k][j];
+          double d[3], de = 0.0;
+          for (std::size_t i = 0; i < 3; i++)
+          {
+            d[i] = x[w][i][l] - x[v0][i][l];
+            de += d[i]*e[k][i][l];
+          }
+          const double t = ee > 0.0 ? de/ee : 0.0;
+          for (std::size_t i = 0; i < 3; i++)
+            u[j][i] = d[i] - t*e[k][i][l];
+        }
+        const double uu = u[0][0]*u[0][0] + u[0][1]*u[0][1] + u[0][2]*u[0][2];
+        const double ww = u[1][0]*u[1][0] + u[1][1]*u[1][1] + u[1][2]*u[1][2];
+        const double uw = u[0][0]*u[1][0] + u[0][1]*u[1][1] + u[0][2]*u[1][2];
+        if (uu == 0.0 || ww == 0.0)
+        {
+          angle = 0.0;
+          break;
+        }
+        const double cosine = std::max(-1.0, std::min(1.0, uw/std::sqrt(uu*ww)));
+        angle = std::min(angle, std::acos(cosine)*180.0/DOLFIN_PI);
+      }
+      min_angle[l] = V == 0.0 ? 0.0 : angle;
+    }
+  }
+}
+//-----------------------------------------------------------------------------
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-10-07
-// Last changed:
+// Last changed: 2026-10-19
 
 #ifndef __MESH_QUALITY_H
 #define __MESH_QUALITY_H
@@ -33,6 +33,70 @@ namespace dolfin
 
   class Mesh;
 
+  /// This class holds the minimum, maximum and histogram (across
+  /// all processes) of cell quality measures, as computed by
+  /// MeshQuality::statistics. The measures are
+  ///
+  ///   "radius_ratio": geometric_dimension * inradius / circumradius,
+  ///                   in [0, 1]
+  ///   "min_angle":    minimum dihedral angle (tetrahedra) or minimum
+  ///                   angle (triangles) in degrees, histogram over
+  ///                   [0, 90]; 180 for intervals
+  ///   "edge_ratio":   shortest edge / longest edge, in [0, 1]
+  ///
+  /// Zero indicates a degenerate cell for all measures.
+
+  class MeshQualityStatistics
+  {
+  public:
+
+    /// Create empty statistics with given number of histogram bins
+    explicit MeshQualityStatistics(std::size_t num_bins);
+
+    /// Return number of cells (across all processes)
+    std::size_t num_cells() const
+    { return _num_cells; }
+
+    /// Return minimum value of quality measure
+    double min(std::string measure) const;
+
+    /// Return maximum value of quality measure
+    double max(std::string measure) const;
+
+    /// Return centers of histogram bins for quality measure
+    std::vector<double> bins(std::string measure) const;
+
+    /// Return number of cells in each histogram bin for quality
+    /// measure
+    std::vector<double> histogram(std::string measure) const;
+
+  private:
+
+    friend class MeshQuality;
+
+    // Number of quality measures
+    static const std::size_t num_measures = 3;
+
+    // Return index of quality measure
+    static std::size_t index(std::string measure);
+
+    // Return histogram range of quality measure
+    static std::pair<double, double> range(std::size_t measure);
+
+    // Number of histogram bins
+    std::size_t _num_bins;
+
+    // Number of cells
+    std::size_t _num_cells;
+
+    // Minimum and maximum values for each measure
+    std::vector<double> _min, _max;
+
+    // Histograms (num_bins values for each measure)
+    std::vector<double> _histogram;
+
+  };
+
   /// The class provides functions to quantify mesh quality
 
   class MeshQuality
@@ -88,6 +152,40 @@ namespace dolfin
     static std::string
       radius_ratio_matplotlib_histogram(const Mesh& mesh,
 					std::size_t num_bins = 50);
+
+    /// Compute minimum, maximum and histogram of the radius ratio,
+    /// the minimum angle and the edge ratio of cells (across all
+    /// processes). All measures are computed in one (threaded) pass
+    /// over the cells, so this is cheap enough to be called in each
+    /// step of an adaptive or ALE loop, e.g. to trigger remeshing.
+    ///
+    /// *Example*
+    ///     .. note::
+    ///
+    ///         MeshQualityStatistics q = MeshQuality::statistics(mesh);
+    ///         if (q.min("radius_ratio") < 0.1)
+    ///           ...
+    static MeshQualityStatistics statistics(const Mesh& mesh,
+                                            std::size_t num_bins = 50);
+
+  private:
+
+    // Number of cells processed together
+    static const std::size_t block_size = 8;
+
+    // Compute quality measures for cells [cell0, cell0 + block_size)
+    // in mesh (cells past the end of the mesh repeat the last cell).
+    // Values are stored as values[measure*block_size + lane].
+    static void compute_block(const Mesh& mesh, std::size_t cell0,
+                              double* values);
+
+    // Compute quality measures for all cells. If radius_ratios is
+    // not null, the radius ratio of each cell is stored in it. If
+    // statistics is not null, the statistics of owned cells are
+    // accumulated in it (not reduced across processes).
+    static void compute(const Mesh& mesh, double* radius_ratios,
+                        MeshQualityStatistics* statistics);
+
   };
 
 }
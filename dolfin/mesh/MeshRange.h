@@ -0,0 +1,303 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __MESH_RANGE_H
+#define __MESH_RANGE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <dolfin/log/log.h>
+#include "Mesh.h"
+#include "MeshConnectivity.h"
+
+namespace dolfin
+{
+
+  /// This class represents a range of entity indices [begin, end)
+  /// and may be used in range-based for loops:
+  ///
+  ///     for (std::size_t c : MeshRange::entities(mesh, tdim))
+  ///       ...
+  ///
+  /// For OpenMP loops, use begin_index() and end_index() as loop
+  /// bounds.
+
+  class IndexRange
+  {
+  public:
+
+    /// Iterator over indices in range
+    class iterator
+    {
+    public:
+
+      /// Create iterator at given index
+      explicit iterator(std::size_t i) : _i(i) {}
+
+      /// Return index
+      std::size_t operator*() const
+      { return _i; }
+
+      /// Step to next index
+      iterator& operator++()
+      { ++_i; return *this; }
+
+      /// Comparison operators
+      bool operator==(const iterator& it) const
+      { return _i == it._i; }
+      bool operator!=(const iterator& it) const
+      { return _i != it._i; }
+
+    private:
+
+      std::size_t _i;
+
+    };
+
+    /// Create range [begin, end)
+    IndexRange(std::size_t begin, std::size_t end)
+      : _begin(begin), _end(end) { dolfin_assert(begin <= end); }
+
+    /// Return iterator to first index
+    iterator begin() const
+    { return iterator(_begin); }
+
+    /// Return iterator to one past the last index
+    iterator end() const
+    { return iterator(_end); }
+
+    /// Return first index
+    std::size_t begin_index() const
+    { return _begin; }
+
+    /// Return one past the last index
+    std::size_t end_index() const
+    { return _end; }
+
+    /// Return number of indices in range
+    std::size_t size() const
+    { return _end - _begin; }
+
+  private:
+
+    std::size_t _begin, _end;
+
+  };
+
+  /// This class provides a view of a contiguous array of blocks of
+  /// equal size, such as vertex coordinates (stride gdim) or the
+  /// vertices of all cells (stride number of vertices per cell). The
+  /// view does not own the data and is invalidated if the mesh is
+  /// modified.
+
+  template<typename T>
+  class StridedArray
+  {
+  public:
+
+    /// Create view of size blocks with given stride
+    StridedArray(const T* data, std::size_t size, std::size_t stride)
+      : _data(data), _size(size), _stride(stride) {}
+
+    /// Return pointer to block i
+    const T* operator[](std::size_t i) const
+    {
+      dolfin_assert(i < _size);
+      return _data + i*_stride;
+    }
+
+    /// Return number of blocks
+    std::size_t size() const
+    { return _size; }
+
+    /// Return size of each block
+    std::size_t stride() const
+    { return _stride; }
+
+    /// Return pointer to underlying data (size()*stride() values)
+    const T* data() const
+    { return _data; }
+
+  private:
+
+    const T* _data;
+    std::size_t _size;
+    std::size_t _stride;
+
+  };
+
+  /// This class provides a view of a _MeshConnectivity_ d0 -- d1 as
+  /// an adjacency list. The entities of dimension d1 incident to
+  /// entity i of dimension d0 are begin(i) ... end(i) - 1. The view
+  /// does not own the data and is invalidated if the mesh is
+  /// modified.
+
+  class ConnectivityArray
+  {
+  public:
+
+    /// Create view of connectivity
+    explicit ConnectivityArray(const MeshConnectivity& connectivity)
+      : _connections(connectivity().data()),
+        _offsets(connectivity.offsets().data()),
+        _size(connectivity.offsets().empty()
+              ? 0 : connectivity.offsets().size() - 1) {}
+
+    /// Return number of entities
+    std::size_t size() const
+    { return _size; }
+
+    /// Return number of connections for entity i
+    std::size_t size(std::size_t i) const
+    {
+      dolfin_assert(i < _size);
+      return _offsets[i + 1] - _offsets[i];
+    }
+
+    /// Return pointer to connections of entity i
+    const unsigned int* operator[](std::size_t i) const
+    { return begin(i); }
+
+    /// Return pointer to first connection of entity i
+    const unsigned int* begin(std::size_t i) const
+    {
+      dolfin_assert(i < _size);
+      return _connections + _offsets[i];
+    }
+
+    /// Return pointer to one past the last connection of entity i
+    const unsigned int* end(std::size_t i) const
+    {
+      dolfin_assert(i < _size);
+      return _connections + _offsets[i + 1];
+    }
+
+    /// Return pointer to connections of all entities
+    const unsigned int* data() const
+    { return _connections; }
+
+    /// Return pointer to offsets (size() + 1 values)
+    const unsigned int* offsets() const
+    { return _offsets; }
+
+  private:
+
+    const unsigned int* _connections;
+    const unsigned int* _offsets;
+    std::size_t _size;
+
+  };
+
+  /// This class provides index-based access to mesh entities and
+  /// their connectivity and coordinates, without creating
+  /// _MeshEntity_ objects. It is an alternative to the mesh entity
+  /// iterators (CellIterator etc.) for loops that only need indices,
+  /// vertex numbers and coordinates:
+  ///
+  ///     const StridedArray<unsigned int> cells = MeshRange::cells(mesh);
+  ///     const StridedArray<double> x = MeshRange::coordinates(mesh);
+  ///     for (std::size_t c : MeshRange::entities(mesh, tdim))
+  ///     {
+  ///       const unsigned int* v = cells[c];
+  ///       const double* x0 = x[v[0]];
+  ///       ...
+  ///     }
+  ///
+  /// Since the arrays are plain views, the loops may also be
+  /// parallelised with OpenMP. Connectivity is computed on demand,
+  /// so the views should be created before entering a parallel
+  /// region.
+
+  class MeshRange
+  {
+  public:
+
+    /// Return range of entity indices of given dimension. The option
+    /// selects "regular" (default), "ghost" or "all" entities, as for
+    /// _MeshEntityIterator_.
+    static IndexRange entities(const Mesh& mesh, std::size_t dim,
+                               std::string opt="regular")
+    {
+      mesh.init(dim);
+      const MeshTopology& topology = mesh.topology();
+      if (opt == "regular")
+        return IndexRange(0, topology.ghost_offset(dim));
+      else if (opt == "ghost")
+        return IndexRange(topology.ghost_offset(dim), topology.size(dim));
+      else if (opt != "all")
+      {
+        dolfin_error("MeshRange.h",
+                     "create range of mesh entities",
+                     "Unknown option \"%s\"", opt.c_str());
+      }
+      return IndexRange(0, topology.size(dim));
+    }
+
+    /// Return connectivity d0 -- d1 (computed if missing)
+    static ConnectivityArray connectivity(const Mesh& mesh, std::size_t d0,
+                                          std::size_t d1)
+    {
+      mesh.init(d0, d1);
+      return ConnectivityArray(mesh.topology()(d0, d1));
+    }
+
+    /// Return vertices of all entities of given dimension (> 0),
+    /// with stride equal to the number of vertices per entity
+    /// (computed if missing)
+    static StridedArray<unsigned int> entity_vertices(const Mesh& mesh,
+                                                      std::size_t dim)
+    {
+      dolfin_assert(dim > 0);
+      mesh.init(dim);
+      const std::size_t num_entities = mesh.topology().size(dim);
+      const MeshConnectivity& c = mesh.topology()(dim, 0);
+      const std::size_t stride = num_entities > 0 ? c.size(0) : 0;
+      dolfin_assert(c.size() == num_entities*stride);
+      return StridedArray<unsigned int>(c().data(), num_entities, stride);
+    }
+
+    /// Return vertices of all cells
+    static StridedArray<unsigned int> cells(const Mesh& mesh)
+    { return entity_vertices(mesh, mesh.topology().dim()); }
+
+    /// Return cells incident to each facet (one for exterior facets
+    /// and two for interior facets)
+    static ConnectivityArray facet_cells(const Mesh& mesh)
+    {
+      const std::size_t D = mesh.topology().dim();
+      dolfin_assert(D > 0);
+      return connectivity(mesh, D - 1, D);
+    }
+
+    /// Return vertex coordinates, with stride equal to the geometric
+    /// dimension
+    static StridedArray<double> coordinates(const Mesh& mesh)
+    {
+      const MeshGeometry& geometry = mesh.geometry();
+      return StridedArray<double>(geometry.x().data(), geometry.size(),
+                                  geometry.dim());
+    }
+
+  };
+
+}
+
+#endif
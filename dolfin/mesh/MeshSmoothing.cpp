@@ -18,11 +18,20 @@
 // Modified by Garth N. Wells, 2010
 //
 // First added:  2008-07-16
-// Last changed: 2011-03-17
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
 #include <dolfin/ale/ALE.h>
 #include <dolfin/common/Array.h>
+#include <dolfin/common/MPI.h>
+#include <dolfin/common/Timer.h>
 #include <dolfin/common/constants.h>
+#include <dolfin/graph/CSRGraph.h>
+#include <dolfin/graph/GraphBuilder.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include "Mesh.h"
 #include "BoundaryMesh.h"
 #include "Vertex.h"
@@ -39,12 +48,11 @@ using namespace dolfin;
 void MeshSmoothing::smooth(Mesh& mesh, std::size_t num_iterations)
 {
   log(PROGRESS, "Smoothing mesh");
+  Timer timer("Mesh smoothing");
 
-  // Make sure we have cell-facet connectivity
-  mesh.init(mesh.topology().dim(), mesh.topology().dim() - 1);
-
-  // Make sure we have vertex-edge connectivity
-  mesh.init(0, 1);
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t d = mesh.geometry().dim();
+  const std::size_t num_vertices = mesh.num_vertices();
 
   // Make sure the mesh is ordered
   mesh.order();
@@ -52,98 +60,412 @@ void MeshSmoothing::smooth(Mesh& mesh, std::size_t num_iterations)
   // Mark vertices on the boundary so we may skip them
   BoundaryMesh boundary(mesh, "exterior");
   const MeshFunction<std::size_t> vertex_map = boundary.entity_map(0);
-  MeshFunction<bool> on_boundary(mesh, 0);
-  on_boundary = false;
+  std::vector<bool> on_boundary(num_vertices, false);
   if (boundary.num_vertices() > 0)
   {
     for (VertexIterator v(boundary); !v.end(); ++v)
       on_boundary[vertex_map[*v]] = true;
   }
 
-  // Iterate over all vertices
-  const std::size_t d = mesh.geometry().dim();
-  std::vector<double> xx(d);
+  // Neighbours of each vertex (vertices connected by an edge)
+  std::vector<std::size_t> path(3, 0);
+  path[1] = 1;
+  const CSRGraph<int> neighbours = GraphBuilder::local_csr_graph(mesh, path);
+
+  // Cells of each vertex
+  mesh.init(0, D);
+  const MeshConnectivity& vertex_cells = mesh.topology()(0, D);
+  const std::vector<unsigned int>& cells = mesh.cells();
+  const std::size_t num_cell_vertices = D + 1;
+
+  // Communication pattern for vertices shared with other processes
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const bool distributed = MPI::size(mpi_comm) > 1;
+  SharedVertices shared;
+  std::vector<bool> is_shared(num_vertices, false);
+  if (distributed)
+  {
+    build_shared_vertices(shared, mesh, neighbours, on_boundary);
+    for (std::size_t i = 0; i < shared.vertices.size(); i++)
+      is_shared[shared.vertices[i]] = true;
+  }
+
+  // Coordinates of previous (x0) and current (x1) iteration
+  std::vector<double>& x = mesh.geometry().x();
+  dolfin_assert(x.size() >= num_vertices*d);
+  std::vector<double> x0(x.begin(), x.begin() + num_vertices*d);
+  std::vector<double> x1(x0);
+
+  // Center of mass of neighbours and distance to boundary of star
+  std::vector<double> center(num_vertices*d, 0.0);
+  std::vector<double> rmin(num_vertices, 0.0);
+
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #endif
+  const int n = num_vertices;
+  std::vector<std::vector<double> > send_values, received_values;
   for (std::size_t iteration = 0; iteration < num_iterations; iteration++)
   {
-    for (VertexIterator v(mesh); !v.end(); ++v)
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    #endif
+    for (int v = 0; v < n; v++)
     {
       // Skip vertices on the boundary
-      if (on_boundary[*v])
+      if (on_boundary[v])
         continue;
 
-      // Get coordinates of vertex
-      double* x = mesh.geometry().x(v->index());
-      const Point p = v->point();
+      // Compute closest distance to boundary of star
+      double r = 0.0;
+      const unsigned int* star = vertex_cells(v);
+      for (std::size_t k = 0; k < vertex_cells.size(v); k++)
+      {
+        const unsigned int* cell = cells.data() + star[k]*num_cell_vertices;
+        const std::size_t local_vertex
+          = std::find(cell, cell + num_cell_vertices, (unsigned int) v) - cell;
+        const double h = height(x0.data(), cell, num_cell_vertices,
+                                local_vertex, d);
+        r = (r == 0.0) ? h : std::min(r, h);
+      }
+      rmin[v] = r;
 
-      // Compute center of mass of neighboring vertices
-      for (std::size_t i = 0; i < d; i++) xx[i] = 0.0;
-      std::size_t num_neighbors = 0;
-      for (EdgeIterator e(*v); !e.end(); ++e)
+      // Compute center of mass of neighboring vertices (shared
+      // vertices are handled below)
+      if (is_shared[v])
+        continue;
+      double* c = center.data() + v*d;
+      std::fill(c, c + d, 0.0);
+      for (const int* w = neighbours.begin(v); w != neighbours.end(v); ++w)
       {
-        // Get the other vertex
-        dolfin_assert(e->num_entities(0) == 2);
-        std::size_t other_index = e->entities(0)[0];
-        if (other_index == v->index())
-          other_index = e->entities(0)[1];
-
-        // Create the vertex
-        Vertex vn(mesh, other_index);
-
-        // Skip the vertex itself
-        if (v->index() == vn.index())
-          continue;
-        num_neighbors += 1;
-
-        // Compute center of mass
-        const double* xn = vn.x();
+        const double* xw = x0.data() + (*w)*d;
         for (std::size_t i = 0; i < d; i++)
-          xx[i] += xn[i];
+          c[i] += xw[i];
       }
+      const std::size_t num_neighbors = neighbours.degree(v);
       for (std::size_t i = 0; i < d; i++)
-        xx[i] /= static_cast<double>(num_neighbors);
+        c[i] /= static_cast<double>(num_neighbors);
+    }
 
-      // Compute closest distance to boundary of star
-      double rmin = 0.0;
-      for (CellIterator c(*v); !c.end(); ++c)
+    // Exchange neighbour coordinates and distances for shared
+    // vertices
+    if (distributed)
+    {
+      send_values.resize(shared.send_vertices.size());
+      for (std::size_t p = 0; p < shared.send_vertices.size(); p++)
       {
-        // Get local number of vertex relative to facet
-        const std::size_t local_vertex = c->index(*v);
-
-        // Get normal of corresponding facet
-        Point n = c->normal(local_vertex);
-
-        // Get first vertex in facet
-        Facet f(mesh, c->entities(mesh.topology().dim() - 1)[local_vertex]);
-        VertexIterator fv(f);
-
-        // Compute length of projection of v - fv onto normal
-        const double r = std::abs(n.dot(p - fv->point()));
-        if (rmin == 0.0)
-          rmin = r;
-        else
-          rmin = std::min(rmin, r);
+        send_values[p].clear();
+        for (std::size_t k = 0; k < shared.send_vertices[p].size(); k++)
+        {
+          const unsigned int v = shared.send_vertices[p][k];
+          send_values[p].push_back(rmin[v]);
+          for (const int* w = neighbours.begin(v); w != neighbours.end(v); ++w)
+          {
+            send_values[p].insert(send_values[p].end(),
+                                  x0.begin() + (*w)*d,
+                                  x0.begin() + (*w + 1)*d);
+          }
+        }
       }
+      MPI::all_to_all(mpi_comm, send_values, received_values);
+
+      for (std::size_t i = 0; i < shared.vertices.size(); i++)
+      {
+        const unsigned int v = shared.vertices[i];
+
+        double* c = center.data() + v*d;
+        std::fill(c, c + d, 0.0);
+        for (std::size_t k = shared.offsets[i]; k < shared.offsets[i + 1]; k++)
+        {
+          const double* xw = shared.process[k] < 0
+            ? x0.data() + shared.index[k]*d
+            : received_values[shared.process[k]].data() + shared.index[k];
+          for (std::size_t j = 0; j < d; j++)
+            c[j] += xw[j];
+        }
+        const std::size_t num_neighbors = shared.offsets[i + 1] - shared.offsets[i];
+        for (std::size_t j = 0; j < d; j++)
+          c[j] /= static_cast<double>(num_neighbors);
+
+        double r = 0.0;
+        for (std::size_t k = shared.rmin_offsets[i];
+             k < shared.rmin_offsets[i + 1]; k++)
+        {
+          const double h = shared.rmin_process[k] < 0
+            ? rmin[v]
+            : received_values[shared.rmin_process[k]][shared.rmin_index[k]];
+          r = (r == 0.0) ? h : std::min(r, h);
+        }
+        rmin[v] = r;
+      }
+    }
+
+    // Move vertices at most a distance rmin / 2
+    #ifdef HAS_OPENMP
+    #pragma omp parallel for num_threads(num_threads) schedule(static)
+    #endif
+    for (int v = 0; v < n; v++)
+    {
+      if (on_boundary[v])
+        continue;
+
+      const double* c = center.data() + v*d;
+      const double* xv0 = x0.data() + v*d;
+      double* xv1 = x1.data() + v*d;
 
-      // Move vertex at most a distance rmin / 2
       double r = 0.0;
       for (std::size_t i = 0; i < d; i++)
       {
-        const double dx = xx[i] - x[i];
+        const double dx = c[i] - xv0[i];
         r += dx*dx;
       }
       r = std::sqrt(r);
-      if (r < DOLFIN_EPS)
+      if (r < DOLFIN_EPS || neighbours.degree(v) == 0)
+      {
+        std::copy(xv0, xv0 + d, xv1);
         continue;
-      rmin = std::min(0.5*rmin, r);
+      }
+
+      const double step = std::min(0.5*rmin[v], r);
       for (std::size_t i = 0; i < d; i++)
-        x[i] += rmin*(xx[i] - x[i])/r;
+        xv1[i] = xv0[i] + step*(c[i] - xv0[i])/r;
     }
+
+    x0.swap(x1);
   }
 
+  // Update mesh coordinates
+  std::copy(x0.begin(), x0.end(), x.begin());
+  mesh.geometry().changed();
+
   if (num_iterations > 1)
     log(PROGRESS, "Mesh smoothing repeated %d times.", num_iterations);
 }
 //-----------------------------------------------------------------------------
+void MeshSmoothing::build_shared_vertices(SharedVertices& shared,
+                                          const Mesh& mesh,
+                                          const CSRGraph<int>& neighbours,
+                                          std::vector<bool>& on_boundary)
+{
+  const MPI_Comm mpi_comm = mesh.mpi_comm();
+  const std::size_t num_processes = MPI::size(mpi_comm);
+  const int process_number = MPI::rank(mpi_comm);
+  const std::size_t d = mesh.geometry().dim();
+
+  // Shared vertices and their global indices
+  const std::map<unsigned int, std::set<unsigned int> > no_shared_vertices;
+  const std::map<unsigned int, std::set<unsigned int> >& shared_vertices
+    = mesh.topology().have_shared_entities(0)
+    ? mesh.topology().shared_entities(0) : no_shared_vertices;
+  const std::vector<std::size_t>& global_indices
+    = mesh.topology().global_indices(0);
+  std::map<std::size_t, unsigned int> global_to_local;
+  std::map<unsigned int, std::set<unsigned int> >::const_iterator it;
+  for (it = shared_vertices.begin(); it != shared_vertices.end(); ++it)
+    global_to_local[global_indices[it->first]] = it->first;
+
+  // A shared vertex is on the boundary if it is on the boundary on
+  // any process
+  std::vector<std::vector<std::size_t> > send_data(num_processes);
+  std::vector<std::vector<std::size_t> > received_data;
+  std::set<unsigned int>::const_iterator p;
+  for (it = shared_vertices.begin(); it != shared_vertices.end(); ++it)
+  {
+    if (!on_boundary[it->first])
+      continue;
+    for (p = it->second.begin(); p != it->second.end(); ++p)
+      send_data[*p].push_back(global_indices[it->first]);
+  }
+  MPI::all_to_all(mpi_comm, send_data, received_data);
+  for (std::size_t q = 0; q < received_data.size(); q++)
+    for (std::size_t k = 0; k < received_data[q].size(); k++)
+      on_boundary[global_to_local[received_data[q][k]]] = true;
+
+  // Interior shared vertices, sorted by global index so that all
+  // processes agree on the order
+  std::vector<std::pair<std::size_t, unsigned int> > sorted_vertices;
+  for (it = shared_vertices.begin(); it != shared_vertices.end(); ++it)
+  {
+    if (!on_boundary[it->first])
+    {
+      sorted_vertices.push_back(std::make_pair(global_indices[it->first],
+                                               it->first));
+    }
+  }
+  std::sort(sorted_vertices.begin(), sorted_vertices.end());
+
+  // Send global indices of neighbours of shared vertices
+  shared.vertices.clear();
+  shared.send_vertices.assign(num_processes, std::vector<unsigned int>());
+  std::map<unsigned int, std::size_t> shared_position;
+  for (std::size_t i = 0; i < num_processes; i++)
+    send_data[i].clear();
+  for (std::size_t i = 0; i < sorted_vertices.size(); i++)
+  {
+    const unsigned int v = sorted_vertices[i].second;
+    shared_position[v] = i;
+    shared.vertices.push_back(v);
+    const std::set<unsigned int>& processes = shared_vertices.find(v)->second;
+    for (p = processes.begin(); p != processes.end(); ++p)
+    {
+      shared.send_vertices[*p].push_back(v);
+      send_data[*p].push_back(neighbours.degree(v));
+      for (const int* w = neighbours.begin(v); w != neighbours.end(v); ++w)
+        send_data[*p].push_back(global_indices[*w]);
+    }
+  }
+  MPI::all_to_all(mpi_comm, send_data, received_data);
+
+  // Locate data for each shared vertex in the messages from other
+  // processes: (process, position in received_data, position in the
+  // values received in each iteration)
+  const std::size_t num_shared = shared.vertices.size();
+  std::vector<std::vector<std::pair<int, std::pair<std::size_t, std::size_t> > > >
+    remote(num_shared);
+  for (std::size_t q = 0; q < num_processes; q++)
+  {
+    std::size_t position = 0;
+    std::size_t value_position = 0;
+    for (std::size_t k = 0; k < shared.send_vertices[q].size(); k++)
+    {
+      dolfin_assert(position < received_data[q].size());
+      const std::size_t i = shared_position[shared.send_vertices[q][k]];
+      const std::size_t degree = received_data[q][position];
+      remote[i].push_back(std::make_pair(q, std::make_pair(position,
+                                                           value_position)));
+      position += 1 + degree;
+      value_position += 1 + degree*d;
+    }
+  }
+
+  // Collect unique neighbours of each shared vertex in order of
+  // process number
+  shared.offsets.assign(1, 0);
+  shared.rmin_offsets.assign(1, 0);
+  shared.process.clear();
+  shared.index.clear();
+  shared.rmin_process.clear();
+  shared.rmin_index.clear();
+  std::set<std::size_t> seen;
+  for (std::size_t i = 0; i < num_shared; i++)
+  {
+    const unsigned int v = shared.vertices[i];
+
+    // Insert local contribution in order of process number
+    std::size_t k = 0;
+    while (k < remote[i].size() && remote[i][k].first < process_number)
+      k++;
+    remote[i].insert(remote[i].begin() + k,
+                     std::make_pair(-1, std::make_pair(0, 0)));
+
+    seen.clear();
+    for (k = 0; k < remote[i].size(); k++)
+    {
+      const int q = remote[i][k].first;
+      if (q < 0)
+      {
+        for (const int* w = neighbours.begin(v); w != neighbours.end(v); ++w)
+        {
+          if (seen.insert(global_indices[*w]).second)
+          {
+            shared.process.push_back(-1);
+            shared.index.push_back(*w);
+          }
+        }
+        shared.rmin_process.push_back(-1);
+        shared.rmin_index.push_back(v);
+      }
+      else
+      {
+        const std::size_t position = remote[i][k].second.first;
+        const std::size_t value_position = remote[i][k].second.second;
+        const std::size_t degree = received_data[q][position];
+        for (std::size_t j = 0; j < degree; j++)
+        {
+          if (seen.insert(received_data[q][position + 1 + j]).second)
+          {
+            shared.process.push_back(q);
+            shared.index.push_back(value_position + 1 + j*d);
+          }
+        }
+        shared.rmin_process.push_back(q);
+        shared.rmin_index.push_back(value_position);
+      }
+    }
+    shared.offsets.push_back(shared.process.size());
+    shared.rmin_offsets.push_back(shared.rmin_process.size());
+  }
+}
+//-----------------------------------------------------------------------------
+double MeshSmoothing::height(const double* x, const unsigned int* cell,
+                             std::size_t num_cell_vertices,
+                             std::size_t local_vertex, std::size_t gdim)
+{
+  // The height is sqrt(det(G_K)/det(G_F)), where G_K is the Gram
+  // matrix of the edges from the vertex to the other vertices of the
+  // cell, and G_F is the Gram matrix of the edges of the opposite
+  // facet
+  dolfin_assert(num_cell_vertices >= 2 && num_cell_vertices <= 4);
+  const double* p = x + cell[local_vertex]*gdim;
+  const double* q[3];
+  std::size_t m = 0;
+  for (std::size_t i = 0; i < num_cell_vertices; i++)
+  {
+    if (i != local_vertex)
+      q[m++] = x + cell[i]*gdim;
+  }
+
+  // Edges of cell from vertex (e) and edges of opposite facet (f)
+  double e[3][3], f[2][3];
+  for (std::size_t j = 0; j < m; j++)
+    for (std::size_t i = 0; i < gdim; i++)
+      e[j][i] = q[j][i] - p[i];
+  for (std::size_t j = 1; j < m; j++)
+    for (std::size_t i = 0; i < gdim; i++)
+      f[j - 1][i] = q[j][i] - q[0][i];
+
+  // Gram matrices
+  double GK[3][3], GF[2][2];
+  for (std::size_t a = 0; a < m; a++)
+  {
+    for (std::size_t b = 0; b < m; b++)
+    {
+      GK[a][b] = 0.0;
+      for (std::size_t i = 0; i < gdim; i++)
+        GK[a][b] += e[a][i]*e[b][i];
+    }
+  }
+  for (std::size_t a = 0; a + 1 < m; a++)
+  {
+    for (std::size_t b = 0; b + 1 < m; b++)
+    {
+      GF[a][b] = 0.0;
+      for (std::size_t i = 0; i < gdim; i++)
+        GF[a][b] += f[a][i]*f[b][i];
+    }
+  }
+
+  double det_K = 0.0, det_F = 1.0;
+  if (m == 1)
+    det_K = GK[0][0];
+  else if (m == 2)
+  {
+    det_K = GK[0][0]*GK[1][1] - GK[0][1]*GK[1][0];
+    det_F = GF[0][0];
+  }
+  else
+  {
+    det_K = GK[0][0]*(GK[1][1]*GK[2][2] - GK[1][2]*GK[2][1])
+          - GK[0][1]*(GK[1][0]*GK[2][2] - GK[1][2]*GK[2][0])
+          + GK[0][2]*(GK[1][0]*GK[2][1] - GK[1][1]*GK[2][0]);
+    det_F = GF[0][0]*GF[1][1] - GF[0][1]*GF[1][0];
+  }
+
+  if (det_F <= 0.0 || det_K <= 0.0)
+    return 0.0;
+  return std::sqrt(det_K/det_F);
+}
+//-----------------------------------------------------------------------------
 void MeshSmoothing::smooth_boundary(Mesh& mesh,
                                     std::size_t num_iterations,
                                     bool harmonic_smoothing)
@@ -202,6 +524,7 @@ void MeshSmoothing::move_interior_vertices(Mesh& mesh,
       for (std::size_t i = 0; i < d; i++)
         xm[i] = xb[i];
     }
+    mesh.geometry().changed();
   }
 }
 //-----------------------------------------------------------------------------
@@ -16,16 +16,21 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2008-07-16
-// Last changed: 2010-03-02
+// Last changed: 2026-10-19
 
 #ifndef __MESH_SMOOTHING_H
 #define __MESH_SMOOTHING_H
 
+#include <cstddef>
+#include <vector>
+
 namespace dolfin
 {
 
+  class BoundaryMesh;
   class Mesh;
   class SubDomain;
+  template<typename T> class CSRGraph;
 
   /// This class implements various mesh smoothing algorithms.
 
@@ -33,7 +38,13 @@ namespace dolfin
   {
   public:
 
-    /// Smooth internal vertices of mesh by local averaging
+    /// Smooth internal vertices of mesh by local averaging. Each
+    /// vertex is moved towards the center of mass of its neighbours
+    /// (at most half the distance to the boundary of its star). All
+    /// vertices are updated simultaneously from the coordinates of
+    /// the previous iteration (Jacobi), using
+    /// parameters["num_threads"] threads. In parallel, vertices on
+    /// process boundaries see their neighbours on all processes.
     static void smooth(Mesh& mesh, std::size_t num_iterations=1);
 
     /// Smooth boundary vertices of mesh by local averaging and
@@ -50,6 +61,44 @@ namespace dolfin
 
   private:
 
+    // Data for vertices shared with other processes. The center of
+    // mass of shared vertex i is computed from the contributions
+    // offsets[i] ... offsets[i + 1] - 1, where contribution k is the
+    // local vertex index[k] if process[k] is -1, and otherwise the
+    // coordinates at position index[k] of the values received from
+    // process[k]. The contributions are in the same order on all
+    // processes, so that the shared vertices move identically.
+    struct SharedVertices
+    {
+      std::vector<unsigned int> vertices;
+      std::vector<std::size_t> offsets;
+      std::vector<int> process;
+      std::vector<std::size_t> index;
+
+      // Local vertices sent to each process, and position of the
+      // distance to the star boundary of shared vertex i received
+      // from process rmin_process[j] for rmin_offsets[i] <= j <
+      // rmin_offsets[i + 1]
+      std::vector<std::vector<unsigned int> > send_vertices;
+      std::vector<std::size_t> rmin_offsets;
+      std::vector<int> rmin_process;
+      std::vector<std::size_t> rmin_index;
+    };
+
+    // Compute communication pattern for shared vertices. Boundary
+    // markers of shared vertices are made consistent across
+    // processes.
+    static void build_shared_vertices(SharedVertices& shared,
+                                      const Mesh& mesh,
+                                      const CSRGraph<int>& neighbours,
+                                      std::vector<bool>& on_boundary);
+
+    // Compute distance from a vertex to the opposite facet of a
+    // simplex cell (the height of the cell)
+    static double height(const double* x, const unsigned int* cell,
+                         std::size_t num_cell_vertices,
+                         std::size_t local_vertex, std::size_t gdim);
+
     // Move interior vertices
     static void move_interior_vertices(Mesh& mesh,
                                        BoundaryMesh& boundary,
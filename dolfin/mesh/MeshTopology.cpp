@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-05-08
-// Last changed: 2014-07-02
+// Last changed: 2026-10-19
 
 #include <numeric>
 #include <sstream>
@@ -27,8 +27,11 @@
 
 using namespace dolfin;
 
+// Initialize static data
+std::atomic<std::size_t> MeshTopology::_num_changes(0);
+
 //-----------------------------------------------------------------------------
-MeshTopology::MeshTopology()
+MeshTopology::MeshTopology() : _version(++_num_changes)
 {
   // Do nothing
 }
@@ -39,7 +42,7 @@ MeshTopology::MeshTopology(const MeshTopology& topology)
     global_num_entities(topology.global_num_entities),
     _global_indices(topology._global_indices),
     _shared_entities(topology._shared_entities),
-    connectivity(topology.connectivity)
+    connectivity(topology.connectivity), _version(++_num_changes)
 {
   // Do nothing
 }
@@ -66,6 +69,7 @@ MeshTopology& MeshTopology::operator= (const MeshTopology& topology)
   _global_indices = topology._global_indices;
   _shared_entities = topology._shared_entities;
   connectivity = topology.connectivity;
+  changed();
 
   return *this;
 }
@@ -112,6 +116,7 @@ void MeshTopology::clear()
   _global_indices.clear();
   _shared_entities.clear();
   connectivity.clear();
+  changed();
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::clear(std::size_t d0, std::size_t d1)
@@ -139,6 +144,8 @@ void MeshTopology::init(std::size_t dim)
   for (std::size_t d0 = 0; d0 <= dim; d0++)
     for (std::size_t d1 = 0; d1 <= dim; d1++)
       connectivity[d0].push_back(MeshConnectivity(d0, d1));
+
+  changed();
 }
 //-----------------------------------------------------------------------------
 void MeshTopology::init(std::size_t dim, std::size_t local_size,
@@ -16,11 +16,12 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2006-05-08
-// Last changed: 2014-07-02
+// Last changed: 2026-10-19
 
 #ifndef __MESH_TOPOLOGY_H
 #define __MESH_TOPOLOGY_H
 
+#include <atomic>
 #include <map>
 #include <utility>
 #include <vector>
@@ -152,6 +153,19 @@ namespace dolfin
     /// Return hash based on the hash of cell-vertex connectivity
     size_t hash() const;
 
+    /// Return version of the topology. The version increases each
+    /// time the topology is initialized, cleared, assigned or
+    /// renumbered (but not when new connectivity is computed), and
+    /// may be used to detect changes without hashing or
+    /// communication.
+    std::size_t version() const
+    { return _version; }
+
+    /// Mark topology as changed (increases version). Call this after
+    /// modifying cell-vertex connectivity.
+    void changed()
+    { _version = ++_num_changes; }
+
     /// Return informal string representation (pretty-print)
     std::string str(bool verbose) const;
 
@@ -199,6 +213,12 @@ namespace dolfin
     // Connectivity for pairs of topological dimensions
     std::vector<std::vector<MeshConnectivity> > connectivity;
 
+    // Version of topology
+    std::size_t _version;
+
+    // Number of changes to all topologies (used to create versions)
+    static std::atomic<std::size_t> _num_changes;
+
   };
 
 }
@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2012-01-16
-// Last changed: 2013-06-28
+// Last changed: 2026-10-19
 
 #include <cmath>
 
@@ -43,6 +43,7 @@ void MeshTransformation::translate(Mesh& mesh, const Point& point)
     for (std::size_t j = 0; j < gdim; j++)
       x[j] += dx[j];
   }
+  geometry.changed();
 }
 //-----------------------------------------------------------------------------
 void MeshTransformation::rotate(Mesh& mesh, double angle, std::size_t axis)
@@ -182,5 +183,6 @@ void MeshTransformation::rotate(Mesh& mesh, double angle, std::size_t axis,
                  "Mesh rotation has not been implemented for meshes of dimension %d",
                  gdim);
   }
+  mesh.geometry().changed();
 }
 //-----------------------------------------------------------------------------
@@ -18,7 +18,7 @@
 // Modified by August Johansson 2014
 //
 // First added:  2013-08-05
-// Last changed: 2014-05-28
+// Last changed: 2026-10-19
 
 #include <dolfin/log/log.h>
 #include <dolfin/plot/plot.h>
@@ -219,10 +219,9 @@ void MultiMesh::_build_bounding_box_trees()
   // Build trees for each part
   for (std::size_t i = 0; i < num_parts(); i++)
   {
-    // Build tree for mesh
-    std::shared_ptr<BoundingBoxTree> tree(new BoundingBoxTree());
-    tree->build(*_meshes[i]);
-    _trees.push_back(tree);
+    // Get tree for mesh. The tree is owned by the mesh and is refitted
+    // (not rebuilt) when a part has moved.
+    _trees.push_back(_meshes[i]->bounding_box_tree());
 
     // Build tree for boundary mesh
     std::shared_ptr<BoundingBoxTree> boundary_tree(new BoundingBoxTree());
@@ -56,7 +56,8 @@ PointIntegralSolver::PointIntegralSolver(std::shared_ptr<MultiStageScheme> schem
   _u0(_system_size), _residual(_system_size), _y(_system_size),
   _dx(_system_size),
   _ufcs(), _coefficient_index(), _recompute_jacobian(),
-  _jacobians(), _eta(1.0), _num_jacobian_computations(0)
+  _jacobians(), _eta(1.0), _num_jacobian_computations(0),
+  _parameters_version(0)
 {
   Timer construct_pis("Construct PointIntegralSolver");
 
@@ -94,18 +95,44 @@ void PointIntegralSolver::reset_stage_solutions()
   }
 }
 //-----------------------------------------------------------------------------
+void PointIntegralSolver::_read_parameters()
+{
+  // Parameters are read once per step only if they have changed
+  if (_parameters_version == Parameters::version())
+    return;
+
+  _reset_stage_solutions = parameters["reset_stage_solutions"];
+
+  const Parameters& newton_solver_params = parameters("newton_solver");
+  _reset_newton_solver = newton_solver_params["reset_each_step"];
+  _report_vertex = newton_solver_params["report_vertex"];
+  _kappa = newton_solver_params["kappa"];
+  _rtol = newton_solver_params["relative_tolerance"];
+  _atol = newton_solver_params["absolute_tolerance"];
+  _max_iterations = newton_solver_params["maximum_iterations"];
+  _max_relative_previous_residual
+    = newton_solver_params["max_relative_previous_residual"];
+  _relaxation = newton_solver_params["relaxation_parameter"];
+  _report = newton_solver_params["report"];
+  _verbose_report = newton_solver_params["verbose_report"];
+  _always_recompute_jacobian
+    = newton_solver_params["always_recompute_jacobian"];
+  _recompute_jacobian_each_solve
+    = newton_solver_params["recompute_jacobian_each_solve"];
+
+  _parameters_version = Parameters::version();
+}
+//-----------------------------------------------------------------------------
 void PointIntegralSolver::step(double dt)
 {
-  const bool reset_stage_solutions_ = parameters["reset_stage_solutions"];
-  const bool reset_newton_solver_
-    = parameters("newton_solver")["reset_each_step"];
+  _read_parameters();
 
   // Check for reseting stage solutions
-  if (reset_stage_solutions_)
+  if (_reset_stage_solutions)
     reset_stage_solutions();
 
   // Check for reseting newtonsolver for each time step
-  if (reset_newton_solver_)
+  if (_reset_newton_solver)
     reset_newton_solver();
 
   Timer t_step("PointIntegralSolver::step");
@@ -598,19 +625,17 @@ void PointIntegralSolver::_simplified_newton_solve(
 			      const std::vector<double>& vertex_coordinates)
 {
   //Timer _timer_newton_solve("Implicit stage: Newton solve");
-  const Parameters& newton_solver_params = parameters("newton_solver");
-  const size_t report_vertex = newton_solver_params["report_vertex"];
-  const double kappa = newton_solver_params["kappa"];
-  const double rtol = newton_solver_params["relative_tolerance"];
-  const double atol = newton_solver_params["absolute_tolerance"];
-  std::size_t max_iterations = newton_solver_params["maximum_iterations"];
+  const size_t report_vertex = _report_vertex;
+  const double kappa = _kappa;
+  const double rtol = _rtol;
+  const double atol = _atol;
+  std::size_t max_iterations = _max_iterations;
   const double max_relative_previous_residual
-    = newton_solver_params["max_relative_previous_residual"];
-  const double relaxation = newton_solver_params["relaxation_parameter"];
-  const bool report = newton_solver_params["report"];
-  const bool verbose_report = newton_solver_params["verbose_report"];
-  bool always_recompute_jacobian
-    = newton_solver_params["always_recompute_jacobian"];
+    = _max_relative_previous_residual;
+  const double relaxation = _relaxation;
+  const bool report = _report;
+  const bool verbose_report = _verbose_report;
+  bool always_recompute_jacobian = _always_recompute_jacobian;
   const unsigned int local_vert = _vertex_map[vert_ind].second;
   UFC& loc_ufc_F = *_ufcs[stage][0];
   UFC& loc_ufc_J = *_ufcs[stage][1];
@@ -620,7 +645,7 @@ void PointIntegralSolver::_simplified_newton_solve(
   const unsigned int jac_index = _scheme->jacobian_index(stage);
   std::vector<double>& jac = _jacobians[jac_index];
 
-  if (newton_solver_params["recompute_jacobian_each_solve"])
+  if (_recompute_jacobian_each_solve)
     _recompute_jacobian[jac_index] = true;
 
   bool newton_solve_restared = false;
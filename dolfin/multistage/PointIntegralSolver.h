@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2013-02-15
-// Last changed: 2014-10-01
+// Last changed: 2026-10-19
 
 #ifndef __POINTINTEGRALSOLVER_H
 #define __POINTINTEGRALSOLVER_H
@@ -117,6 +117,9 @@ namespace dolfin
 
     };
 
+    // Read settings from parameters (if parameters have changed)
+    void _read_parameters();
+
     // In-place LU factorization of jacobian matrix
     void _lu_factorize(std::vector<double>& A);
 
@@ -222,6 +225,16 @@ namespace dolfin
     // Number of computations of Jacobian
     std::size_t _num_jacobian_computations;
 
+    // Settings read from parameters
+    bool _reset_stage_solutions, _reset_newton_solver;
+    std::size_t _report_vertex, _max_iterations;
+    double _kappa, _rtol, _atol, _max_relative_previous_residual, _relaxation;
+    bool _report, _verbose_report, _always_recompute_jacobian;
+    bool _recompute_jacobian_each_solve;
+
+    // Version of parameters when settings were read
+    std::size_t _parameters_version;
+
   };
 
 }
@@ -18,7 +18,7 @@
 // Modified by Fredrik Valdmanis, 2011
 //
 // First added:  2009-07-02
-// Last changed: 2013-06-21
+// Last changed: 2026-10-19
 
 #ifndef __GLOBAL_PARAMETERS_H
 #define __GLOBAL_PARAMETERS_H
@@ -90,6 +90,9 @@ namespace dolfin
       p.add("ghost_mode", "none",
             {"shared_facet", "shared_vertex", "none"});
 
+      // Encoding of mesh and vector arrays written to XML files
+      p.add("xml_array_encoding", "ascii", {"ascii", "base64"});
+
       // Mesh ordering via SCOTCH and GPS
       p.add("reorder_cells_gps", false);
       p.add("reorder_vertices_gps", false);
@@ -123,11 +126,15 @@ namespace dolfin
       // Graph coloring
       std::set<std::string> allowed_coloring_libraries;
       allowed_coloring_libraries.insert("Boost");
+      allowed_coloring_libraries.insert("greedy");
       #ifdef HAS_TRILINOS
       allowed_coloring_libraries.insert("Zoltan");
       #endif
       p.add("graph_coloring_library", "Boost", allowed_coloring_libraries);
 
+      // Balance size of color classes (greedy graph coloring only)
+      p.add("balanced_graph_coloring", false);
+
       // Mesh refinement
       p.add("refinement_algorithm",
         "recursive_bisection",
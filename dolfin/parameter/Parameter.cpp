@@ -19,11 +19,12 @@
 // Modified by Joachim B Haga 2012
 //
 // First added:  2009-05-08
-// Last changed: 2012-09-11
+// Last changed: 2026-10-19
 
 #include <sstream>
 #include <dolfin/log/log.h>
 #include "Parameter.h"
+#include "Parameters.h"
 
 using namespace dolfin;
 
@@ -61,6 +62,7 @@ bool Parameter::is_set() const
 void Parameter::reset()
 {
   _is_set = false;
+  ++Parameters::_version;
 }
 //-----------------------------------------------------------------------------
 std::size_t Parameter::access_count() const
@@ -73,6 +75,12 @@ std::size_t Parameter::change_count() const
   return _change_count;
 }
 //-----------------------------------------------------------------------------
+void Parameter::changed()
+{
+  _change_count++;
+  ++Parameters::_version;
+}
+//-----------------------------------------------------------------------------
 void Parameter::set_range(int min_value, int max_value)
 {
   dolfin_error("Parameter.cpp",
@@ -281,7 +289,7 @@ const IntParameter& IntParameter::operator= (int value)
 
   // Set value
   _value = value;
-  _change_count++;
+  changed();
   _is_set = true;
 
   return *this;
@@ -423,7 +431,7 @@ const DoubleParameter& DoubleParameter::operator= (double value)
 
   // Set value
   _value = value;
-  _change_count++;
+  changed();
   _is_set = true;
 
   return *this;
@@ -533,7 +541,7 @@ const StringParameter& StringParameter::operator= (std::string value)
 
   // Set value
   _value = value;
-  _change_count++;
+  changed();
   _is_set = true;
 
   return *this;
@@ -556,7 +564,7 @@ const StringParameter& StringParameter::operator= (const char* value)
 
   // Set value
   _value = s;
-  _change_count++;
+  changed();
   _is_set = true;
 
   return *this;
@@ -648,7 +656,7 @@ const BoolParameter& BoolParameter::operator= (bool value)
 {
   // Set value
   _value = value;
-  _change_count++;
+  changed();
   _is_set = true;
 
   return *this;
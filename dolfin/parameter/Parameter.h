@@ -18,7 +18,7 @@
 // Modified by Joachim B Haga 2012
 //
 // First added:  2009-05-08
-// Last changed: 2012-09-11
+// Last changed: 2026-10-19
 
 #ifndef __PARAMETER_H
 #define __PARAMETER_H
@@ -30,6 +30,8 @@
 namespace dolfin
 {
 
+  template<typename T> class ParameterHandle;
+
   /// Base class for parameters.
 
   class Parameter
@@ -123,8 +125,14 @@ namespace dolfin
     // Check that key name is allowed
     static void check_key(std::string key);
 
+    // Handles read values directly
+    template<typename T> friend class ParameterHandle;
+
   protected:
 
+    // Count change of value
+    void changed();
+
     // Access count
     mutable std::size_t _access_count;
 
@@ -183,6 +191,9 @@ namespace dolfin
     /// Return short string description
     std::string str() const;
 
+    // Handles read value directly
+    template<typename T> friend class ParameterHandle;
+
   private:
 
     /// Parameter value
@@ -231,6 +242,9 @@ namespace dolfin
     /// Return short string description
     std::string str() const;
 
+    // Handles read value directly
+    template<typename T> friend class ParameterHandle;
+
   private:
 
     /// Parameter value
@@ -282,6 +296,9 @@ namespace dolfin
     /// Return short string description
     std::string str() const;
 
+    // Handles read value directly
+    template<typename T> friend class ParameterHandle;
+
   private:
 
     /// Parameter value
@@ -324,6 +341,9 @@ namespace dolfin
     /// Return short string description
     std::string str() const;
 
+    // Handles read value directly
+    template<typename T> friend class ParameterHandle;
+
   private:
 
     /// Parameter value
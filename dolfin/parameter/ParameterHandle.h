@@ -0,0 +1,199 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __PARAMETER_HANDLE_H
+#define __PARAMETER_HANDLE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <dolfin/log/log.h>
+#include "Parameter.h"
+#include "Parameters.h"
+
+namespace dolfin
+{
+
+  /// This class provides fast access to the value of a parameter.
+  /// The key, which may refer to a nested parameter set using '.'
+  /// as separator (e.g. "newton_solver.relative_tolerance"), is
+  /// looked up once when the handle is created. Reading the value
+  /// then costs a pointer dereference. The key is looked up again
+  /// only if parameters have been removed since, for example when
+  /// a parameter set has been assigned.
+  ///
+  /// The value type T must be the type of the parameter: int,
+  /// double, bool or std::string. The handle refers to the given
+  /// parameter set, which must outlive the handle. Reads through a
+  /// handle are not counted by Parameter::access_count().
+  ///
+  /// value() may be called concurrently from several threads (for
+  /// example through a function-local static handle), as long as
+  /// parameters are not changed at the same time.
+
+  template<typename T>
+  class ParameterHandle
+  {
+  public:
+
+    /// Create handle for parameter with given key in parameter set
+    ParameterHandle(const Parameters& parameters, std::string key)
+      : _parameters(parameters), _key(key), _parameter(0), _value(0),
+        _num_removals(0)
+    {
+      // Split key into nested parameter set keys and parameter key
+      std::size_t begin = 0;
+      std::size_t end = key.find('.');
+      while (end != std::string::npos)
+      {
+        _path.push_back(key.substr(begin, end - begin));
+        begin = end + 1;
+        end = key.find('.', begin);
+      }
+      _path.push_back(key.substr(begin));
+
+      lookup();
+    }
+
+    /// Destructor
+    ~ParameterHandle() {}
+
+    /// Return value of parameter
+    const T& value() const
+    {
+      if (_num_removals.load(std::memory_order_acquire)
+          != Parameters::_num_removals)
+      {
+        lookup();
+      }
+      if (!_parameter.load(std::memory_order_relaxed)->_is_set)
+      {
+        dolfin_error("ParameterHandle.h",
+                     "read value of parameter",
+                     "Parameter \"%s\" has not been set", _key.c_str());
+      }
+      return *_value.load(std::memory_order_relaxed);
+    }
+
+    /// Return value of parameter
+    operator const T&() const
+    { return value(); }
+
+  private:
+
+    // Look up parameter and value
+    void lookup() const
+    {
+      // Read number of removals before looking up, so that a removal
+      // during the lookup triggers another lookup
+      const std::size_t num_removals = Parameters::_num_removals;
+
+      const Parameters* parameters = &_parameters;
+      for (std::size_t i = 0; i + 1 < _path.size(); ++i)
+      {
+        parameters = parameters->find_parameter_set(_path[i]);
+        if (!parameters)
+        {
+          dolfin_error("ParameterHandle.h",
+                       "look up parameter",
+                       "No parameter set \"%s\" on path to parameter \"%s\"",
+                       _path[i].c_str(), _key.c_str());
+        }
+      }
+
+      const Parameter* parameter
+        = parameters->find_parameter(_path.back());
+      if (!parameter)
+      {
+        dolfin_error("ParameterHandle.h",
+                     "look up parameter",
+                     "No parameter \"%s\"", _key.c_str());
+      }
+
+      const T* value = value_pointer(*parameter);
+      if (!value)
+      {
+        dolfin_error("ParameterHandle.h",
+                     "look up parameter",
+                     "Parameter \"%s\" of type %s does not match type of handle",
+                     _key.c_str(), parameter->type_str().c_str());
+      }
+
+      // Publish parameter and value before number of removals
+      // (threads looking up concurrently store the same values)
+      _parameter.store(parameter, std::memory_order_relaxed);
+      _value.store(value, std::memory_order_relaxed);
+      _num_removals.store(num_removals, std::memory_order_release);
+    }
+
+    // Return pointer to value of parameter (0 if type does not match)
+    static const T* value_pointer(const Parameter& parameter);
+
+    // Parameter set and key
+    const Parameters& _parameters;
+    const std::string _key;
+
+    // Keys of nested parameter sets followed by key of parameter
+    std::vector<std::string> _path;
+
+    // Parameter and value (atomic, since value() may look up the
+    // parameter again from several threads)
+    mutable std::atomic<const Parameter*> _parameter;
+    mutable std::atomic<const T*> _value;
+
+    // Number of removals of parameters at last look up
+    mutable std::atomic<std::size_t> _num_removals;
+
+  };
+
+  // Specialisations for supported parameter types
+  template<> inline const int*
+  ParameterHandle<int>::value_pointer(const Parameter& parameter)
+  {
+    const IntParameter* p = dynamic_cast<const IntParameter*>(&parameter);
+    return p ? &p->_value : 0;
+  }
+
+  template<> inline const double*
+  ParameterHandle<double>::value_pointer(const Parameter& parameter)
+  {
+    const DoubleParameter* p
+      = dynamic_cast<const DoubleParameter*>(&parameter);
+    return p ? &p->_value : 0;
+  }
+
+  template<> inline const bool*
+  ParameterHandle<bool>::value_pointer(const Parameter& parameter)
+  {
+    const BoolParameter* p = dynamic_cast<const BoolParameter*>(&parameter);
+    return p ? &p->_value : 0;
+  }
+
+  template<> inline const std::string*
+  ParameterHandle<std::string>::value_pointer(const Parameter& parameter)
+  {
+    const StringParameter* p
+      = dynamic_cast<const StringParameter*>(&parameter);
+    return p ? &p->_value : 0;
+  }
+
+}
+
+#endif
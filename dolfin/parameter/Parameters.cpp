@@ -19,7 +19,7 @@
 // Modified by Garth N. Wells, 2009
 //
 // First added:  2009-05-08
-// Last changed: 2012-10-26
+// Last changed: 2026-10-19
 
 #include <sstream>
 #include <stdio.h>
@@ -43,6 +43,10 @@ typedef std::map<std::string, Parameter*>::const_iterator const_parameter_iterat
 typedef std::map<std::string, Parameters*>::iterator parameter_set_iterator;
 typedef std::map<std::string, Parameters*>::const_iterator const_parameter_set_iterator;
 
+// Global counters
+std::atomic<std::size_t> Parameters::_version(1);
+std::atomic<std::size_t> Parameters::_num_removals(0);
+
 //-----------------------------------------------------------------------------
 Parameters::Parameters(std::string key) : _key(key)
 {
@@ -52,7 +56,9 @@ Parameters::Parameters(std::string key) : _key(key)
 //-----------------------------------------------------------------------------
 Parameters::~Parameters()
 {
-  clear();
+  // Not counted as a removal, since handles may not refer to a
+  // parameter set that is destroyed
+  delete_parameters();
 }
 //-----------------------------------------------------------------------------
 Parameters::Parameters(const Parameters& parameters)
@@ -72,6 +78,18 @@ void Parameters::rename(std::string key)
 }
 //-----------------------------------------------------------------------------
 void Parameters::clear()
+{
+  // Count removal
+  if (!_parameters.empty() || !_parameter_sets.empty())
+  {
+    ++_version;
+    ++_num_removals;
+  }
+
+  delete_parameters();
+}
+//-----------------------------------------------------------------------------
+void Parameters::delete_parameters()
 {
   // Delete parameters
   for (parameter_iterator it = _parameters.begin(); it != _parameters.end();
@@ -250,6 +268,10 @@ void Parameters::remove(std::string key)
                  this->name().c_str(), key.c_str());
   }
 
+  // Count removal
+  ++_version;
+  ++_num_removals;
+
   // Delete objects (safe to delete both even if only one is nonzero)
   delete find_parameter(key);
   delete find_parameter_set(key);
@@ -19,11 +19,12 @@
 // Modified by Garth N. Wells, 2009
 //
 // First added:  2009-05-08
-// Last changed: 2011-10-24
+// Last changed: 2026-10-19
 
 #ifndef __PARAMETERS_H
 #define __PARAMETERS_H
 
+#include <atomic>
 #include <set>
 #include <map>
 #include <vector>
@@ -222,6 +223,16 @@ namespace dolfin
     // Return pointer to parameter set for given key and 0 if not found
     Parameters* find_parameter_set(std::string key) const;
 
+    /// Return global version of parameters. The version is
+    /// incremented whenever a parameter is assigned a value or reset,
+    /// and whenever parameters are removed from a parameter set (by
+    /// remove(), clear() or assignment, but not when a parameter set
+    /// is destroyed). Objects that cache settings derived from
+    /// parameters may compare the version to detect changes. The
+    /// version starts at 1, so 0 may be used to mark settings that
+    /// have not been read.
+    static std::size_t version()
+    { return _version; }
 
   protected:
 
@@ -253,6 +264,21 @@ namespace dolfin
     // Map from key to parameter sets
     std::map<std::string, Parameters*> _parameter_sets;
 
+    // Delete parameters and parameter sets
+    void delete_parameters();
+
+    // Global version of parameters
+    static std::atomic<std::size_t> _version;
+
+    // Global number of removals of parameters or parameter sets
+    static std::atomic<std::size_t> _num_removals;
+
+    // Parameters count changes of values
+    friend class Parameter;
+
+    // Handles detect removal of parameters
+    template<typename T> friend class ParameterHandle;
+
   };
 
   // Specialised templated for unset parameters
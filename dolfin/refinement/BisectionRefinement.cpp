@@ -20,7 +20,7 @@
 // Modified by Marie E. Rognes, 2011.
 //
 // First added:  2006-11-01
-// Last changed: 2011-04-07
+// Last changed: 2026-10-19
 
 #include <memory>
 #include <dolfin/log/dolfin_log.h>
@@ -28,6 +28,7 @@
 #include <dolfin/mesh/Facet.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/MeshFunction.h>
+#include "MarkerTransfer.h"
 #include "RivaraRefinement.h"
 #include "BisectionRefinement.h"
 
@@ -94,6 +95,9 @@ void BisectionRefinement::refine_by_recursive_bisection(Mesh& refined_mesh,
     // Assign parent facet index to this facet
     ff[facet->index()] = parent_facet_index;
   }
+
+  // Transfer subdomain markers
+  MarkerTransfer::transfer_domains(refined_mesh, mesh);
 }
 /*
 //-----------------------------------------------------------------------------
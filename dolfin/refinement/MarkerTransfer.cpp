@@ -0,0 +1,175 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <limits>
+#include <map>
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshData.h>
+#include <dolfin/mesh/MeshDomains.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "MarkerTransfer.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<MeshFunction<std::size_t> > >
+MarkerTransfer::transfer(const std::vector<std::shared_ptr<const MeshFunction<std::size_t> > >&
+                         mesh_functions,
+                         std::shared_ptr<const Mesh> refined_mesh)
+{
+  dolfin_assert(refined_mesh);
+  std::vector<std::shared_ptr<MeshFunction<std::size_t> > >
+    refined_mesh_functions(mesh_functions.size());
+  if (mesh_functions.empty())
+    return refined_mesh_functions;
+
+  // Check that mesh functions are defined over cells or facets of
+  // the same mesh
+  dolfin_assert(mesh_functions[0]);
+  dolfin_assert(mesh_functions[0]->mesh());
+  const Mesh& mesh = *mesh_functions[0]->mesh();
+  const std::size_t D = mesh.topology().dim();
+  for (std::size_t k = 0; k < mesh_functions.size(); ++k)
+  {
+    dolfin_assert(mesh_functions[k]);
+    if (mesh_functions[k]->mesh().get() != &mesh)
+    {
+      dolfin_error("MarkerTransfer.cpp",
+                   "transfer mesh functions to refined mesh",
+                   "Mesh functions must be defined on the same mesh");
+    }
+    if (mesh_functions[k]->dim() != D && mesh_functions[k]->dim() + 1 != D)
+    {
+      dolfin_error("MarkerTransfer.cpp",
+                   "transfer mesh functions to refined mesh",
+                   "Only mesh functions over cells and facets can be transferred");
+    }
+  }
+
+  // Use very large value as 'undefined'
+  const std::size_t undefined = std::numeric_limits<std::size_t>::max();
+
+  // Transfer all mesh functions of each dimension in one pass over
+  // the parent map
+  for (std::size_t dim = D - 1; dim <= D; ++dim)
+  {
+    std::vector<const std::size_t*> values;
+    std::vector<std::size_t*> refined_values;
+    for (std::size_t k = 0; k < mesh_functions.size(); ++k)
+    {
+      if (mesh_functions[k]->dim() != dim)
+        continue;
+      refined_mesh_functions[k].reset(new MeshFunction<std::size_t>(refined_mesh,
+                                                                    dim));
+      values.push_back(mesh_functions[k]->values());
+      refined_values.push_back(refined_mesh_functions[k]->values());
+    }
+    if (values.empty())
+      continue;
+
+    const std::vector<std::size_t>* parent = parent_map(*refined_mesh, dim);
+    if (!parent)
+    {
+      dolfin_error("MarkerTransfer.cpp",
+                   "transfer mesh functions to refined mesh",
+                   "Unable to extract information about parent mesh entities");
+    }
+    dolfin_assert(parent->size() == refined_mesh->num_entities(dim));
+
+    const std::size_t num_entities = mesh.num_entities(dim);
+    const std::size_t num_values = values.size();
+    for (std::size_t i = 0; i < parent->size(); ++i)
+    {
+      const std::size_t p = (*parent)[i];
+      if (p < num_entities)
+      {
+        for (std::size_t k = 0; k < num_values; ++k)
+          refined_values[k][i] = values[k][p];
+      }
+      else
+      {
+        for (std::size_t k = 0; k < num_values; ++k)
+          refined_values[k][i] = undefined;
+      }
+    }
+  }
+
+  return refined_mesh_functions;
+}
+//-----------------------------------------------------------------------------
+void MarkerTransfer::transfer_domains(Mesh& refined_mesh, const Mesh& mesh)
+{
+  const MeshDomains& domains = mesh.domains();
+  if (domains.is_empty())
+    return;
+
+  const std::size_t D = mesh.topology().dim();
+  MeshDomains& refined_domains = refined_mesh.domains();
+  refined_domains.init(D);
+
+  const std::size_t undefined = std::numeric_limits<std::size_t>::max();
+  for (std::size_t dim = D - 1; dim <= D; ++dim)
+  {
+    if (dim > domains.max_dim() || domains.num_marked(dim) == 0)
+      continue;
+
+    const std::vector<std::size_t>* parent = parent_map(refined_mesh, dim);
+    if (!parent)
+      continue;
+
+    // Flatten markers of mesh
+    mesh.init(dim);
+    const std::map<std::size_t, std::size_t>& markers = domains.markers(dim);
+    std::vector<std::size_t> values(mesh.num_entities(dim), undefined);
+    for (std::map<std::size_t, std::size_t>::const_iterator m
+           = markers.begin(); m != markers.end(); ++m)
+    {
+      dolfin_assert(m->first < values.size());
+      values[m->first] = m->second;
+    }
+
+    // Refined entities are visited in increasing order, so markers
+    // are appended at the end of the map
+    std::map<std::size_t, std::size_t>& refined_markers
+      = refined_domains.markers(dim);
+    for (std::size_t i = 0; i < parent->size(); ++i)
+    {
+      const std::size_t p = (*parent)[i];
+      if (p < values.size() && values[p] != undefined)
+      {
+        refined_markers.insert(refined_markers.end(),
+                               std::make_pair(i, values[p]));
+      }
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::size_t>*
+MarkerTransfer::parent_map(const Mesh& refined_mesh, std::size_t dim)
+{
+  const std::size_t D = refined_mesh.topology().dim();
+  const std::string name = (dim == D) ? "parent_cell" : "parent_facet";
+  dolfin_assert(dim == D || dim + 1 == D);
+  if (!refined_mesh.data().exists(name, dim))
+    return NULL;
+  return &refined_mesh.data().array(name, dim);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,68 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __MARKER_TRANSFER_H
+#define __MARKER_TRANSFER_H
+
+#include <memory>
+#include <vector>
+
+namespace dolfin
+{
+
+  class Mesh;
+  template <typename T> class MeshFunction;
+
+  /// This class transfers cell and facet markers from a mesh to a
+  /// refined mesh. It uses the parent maps recorded by the refinement
+  /// as flat arrays in the mesh data of the refined mesh
+  /// ("parent_cell" of dimension D and "parent_facet" of dimension
+  /// D - 1). The parent map is traversed once per dimension, and all
+  /// markers of that dimension are transferred in the same pass.
+
+  class MarkerTransfer
+  {
+  public:
+
+    /// Transfer mesh functions (over cells or facets of the same
+    /// mesh) to refined mesh. Refined entities without a parent
+    /// entity are set to the maximum value of std::size_t.
+    static std::vector<std::shared_ptr<MeshFunction<std::size_t> > >
+    transfer(const std::vector<std::shared_ptr<const MeshFunction<std::size_t> > >&
+             mesh_functions,
+             std::shared_ptr<const Mesh> refined_mesh);
+
+    /// Transfer subdomain markers (MeshDomains) of cells and facets
+    /// of mesh to refined mesh. Dimensions for which the refined
+    /// mesh has no parent map are skipped.
+    static void transfer_domains(Mesh& refined_mesh, const Mesh& mesh);
+
+  private:
+
+    // Return parent map of given dimension of refined mesh, or NULL
+    // if the map does not exist
+    static const std::vector<std::size_t>*
+      parent_map(const Mesh& refined_mesh, std::size_t dim);
+
+  };
+
+}
+
+#endif
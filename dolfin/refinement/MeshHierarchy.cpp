@@ -0,0 +1,129 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#include <dolfin/log/log.h>
+#include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshData.h>
+#include <dolfin/mesh/MeshFunction.h>
+#include "refine.h"
+#include "MeshHierarchy.h"
+
+using namespace dolfin;
+
+//-----------------------------------------------------------------------------
+MeshHierarchy::MeshHierarchy(std::shared_ptr<const Mesh> coarse_mesh)
+  : _meshes(1, coarse_mesh), _parent_cells(1)
+{
+  dolfin_assert(coarse_mesh);
+}
+//-----------------------------------------------------------------------------
+MeshHierarchy::MeshHierarchy(std::shared_ptr<const Mesh> coarse_mesh,
+                             std::size_t num_refinements)
+  : _meshes(1, coarse_mesh), _parent_cells(1)
+{
+  dolfin_assert(coarse_mesh);
+  for (std::size_t i = 0; i < num_refinements; ++i)
+    refine();
+}
+//-----------------------------------------------------------------------------
+MeshHierarchy::~MeshHierarchy()
+{
+  // Do nothing
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const Mesh> MeshHierarchy::refine()
+{
+  std::shared_ptr<Mesh> refined_mesh(new Mesh);
+  dolfin::refine(*refined_mesh, *_meshes.back());
+  add(refined_mesh);
+  return refined_mesh;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const Mesh>
+MeshHierarchy::refine(const MeshFunction<bool>& cell_markers)
+{
+  if (cell_markers.mesh().get() != _meshes.back().get())
+  {
+    dolfin_error("MeshHierarchy.cpp",
+                 "refine mesh hierarchy",
+                 "Cell markers must be defined on the finest mesh");
+  }
+
+  std::shared_ptr<Mesh> refined_mesh(new Mesh);
+  dolfin::refine(*refined_mesh, *_meshes.back(), cell_markers);
+  add(refined_mesh);
+  return refined_mesh;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<const Mesh> MeshHierarchy::mesh(std::size_t level) const
+{
+  if (level >= _meshes.size())
+  {
+    dolfin_error("MeshHierarchy.cpp",
+                 "access mesh in hierarchy",
+                 "Level %d is out of range [0, %d)", level, _meshes.size());
+  }
+  return _meshes[level];
+}
+//-----------------------------------------------------------------------------
+std::size_t MeshHierarchy::level(const Mesh& mesh) const
+{
+  for (std::size_t i = 0; i < _meshes.size(); ++i)
+  {
+    if (_meshes[i].get() == &mesh)
+      return i;
+  }
+
+  dolfin_error("MeshHierarchy.cpp",
+               "find level of mesh in hierarchy",
+               "Mesh is not part of the hierarchy");
+  return 0;
+}
+//-----------------------------------------------------------------------------
+const std::vector<std::size_t>&
+MeshHierarchy::parent_cells(std::size_t level) const
+{
+  if (level == 0 || level >= _meshes.size())
+  {
+    dolfin_error("MeshHierarchy.cpp",
+                 "access parent cells in hierarchy",
+                 "Level %d is out of range [1, %d)", level, _meshes.size());
+  }
+  return _parent_cells[level];
+}
+//-----------------------------------------------------------------------------
+void MeshHierarchy::add(std::shared_ptr<const Mesh> refined_mesh)
+{
+  const std::size_t D = refined_mesh->topology().dim();
+  if (!refined_mesh->data().exists("parent_cell", D))
+  {
+    dolfin_error("MeshHierarchy.cpp",
+                 "add refined mesh to hierarchy",
+                 "Refinement did not record parent cells (not supported for meshes refined in parallel)");
+  }
+
+  const std::vector<std::size_t>& parent_cells
+    = refined_mesh->data().array("parent_cell", D);
+  dolfin_assert(parent_cells.size() == refined_mesh->num_cells());
+
+  _meshes.push_back(refined_mesh);
+  _parent_cells.push_back(parent_cells);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+
+#ifndef __MESH_HIERARCHY_H
+#define __MESH_HIERARCHY_H
+
+#include <memory>
+#include <vector>
+
+namespace dolfin
+{
+
+  // Forward declarations
+  class Mesh;
+  template <typename T> class MeshFunction;
+
+  /// This class represents a sequence of nested meshes obtained by
+  /// repeated refinement of a coarse mesh, as needed for geometric
+  /// multigrid. For each level l > 0, the parent cell (in the mesh
+  /// at level l - 1) of each cell of the mesh at level l is stored as
+  /// a flat array. Transfer operators between function spaces on
+  /// consecutive levels can be built with _MultigridTransfer_.
+  ///
+  /// The parent cell maps are recorded by serial refinement. Meshes
+  /// refined in parallel do not carry parent information.
+
+  class MeshHierarchy
+  {
+  public:
+
+    /// Create hierarchy with a single (coarse) mesh
+    explicit MeshHierarchy(std::shared_ptr<const Mesh> coarse_mesh);
+
+    /// Create hierarchy by uniform refinement of coarse mesh the
+    /// given number of times
+    MeshHierarchy(std::shared_ptr<const Mesh> coarse_mesh,
+                  std::size_t num_refinements);
+
+    /// Destructor
+    ~MeshHierarchy();
+
+    /// Refine finest mesh uniformly and add it to the hierarchy.
+    /// Returns the new finest mesh.
+    std::shared_ptr<const Mesh> refine();
+
+    /// Refine finest mesh locally and add it to the hierarchy.
+    /// Returns the new finest mesh.
+    std::shared_ptr<const Mesh> refine(const MeshFunction<bool>& cell_markers);
+
+    /// Return number of levels
+    std::size_t size() const
+    { return _meshes.size(); }
+
+    /// Return mesh at given level (0 is the coarsest)
+    std::shared_ptr<const Mesh> mesh(std::size_t level) const;
+
+    /// Return coarsest mesh
+    std::shared_ptr<const Mesh> coarse_mesh() const
+    { return _meshes.front(); }
+
+    /// Return finest mesh
+    std::shared_ptr<const Mesh> finest_mesh() const
+    { return _meshes.back(); }
+
+    /// Return level of mesh in hierarchy. Throws an error if the mesh
+    /// is not in the hierarchy.
+    std::size_t level(const Mesh& mesh) const;
+
+    /// Return parent cell (in mesh at level - 1) of each cell of the
+    /// mesh at given level > 0
+    const std::vector<std::size_t>& parent_cells(std::size_t level) const;
+
+  private:
+
+    // Add refined mesh to hierarchy and extract its parent cell map
+    void add(std::shared_ptr<const Mesh> refined_mesh);
+
+    // Meshes, coarsest first
+    std::vector<std::shared_ptr<const Mesh> > _meshes;
+
+    // Parent cell maps for each level (empty for level 0)
+    std::vector<std::vector<std::size_t> > _parent_cells;
+
+  };
+
+}
+
+#endif
@@ -17,14 +17,16 @@
 //
 //
 // First Added: 2013-01-02
-// Last Changed: 2013-05-12
+// Last Changed: 2026-10-19
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <vector>
 #include <boost/multi_array.hpp>
 #include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
+#include <dolfin/parameter/GlobalParameters.h>
 #include <dolfin/common/types.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/DistributedMeshTools.h>
@@ -32,8 +34,11 @@
 #include <dolfin/mesh/LocalMeshData.h>
 #include <dolfin/mesh/Mesh.h>
 #include <dolfin/mesh/MeshEditor.h>
+#include <dolfin/mesh/MeshConnectivity.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
+#include <dolfin/mesh/MeshGeometry.h>
 #include <dolfin/mesh/MeshPartitioning.h>
+#include <dolfin/mesh/MeshTopology.h>
 #include <dolfin/mesh/Vertex.h>
 
 #include "ParallelRefinement.h"
@@ -70,7 +75,7 @@ void ParallelRefinement::mark_all()
   marked_edges.assign(_mesh.num_edges(), true);
 }
 //-----------------------------------------------------------------------------
-const std::map<std::size_t, std::size_t>&
+const std::vector<std::int64_t>&
 ParallelRefinement::edge_to_new_vertex() const
 {
   return local_edge_to_new_vertex;
@@ -167,6 +172,7 @@ void ParallelRefinement::create_new_vertices()
 
   // Copy over existing mesh vertices
   new_vertex_coordinates = _mesh.coordinates();
+  local_edge_to_new_vertex.assign(_mesh.num_edges(), -1);
 
   // Tally up unshared marked edges, and shared marked edges which are
   // owned on this process.  Index them sequentially from zero.
@@ -215,27 +221,30 @@ void ParallelRefinement::create_new_vertices()
   // sent off-process.  Add offset to map, and collect up any shared
   // new vertices that need to send the new index off-process
   std::vector<std::vector<std::size_t> > values_to_send(num_processes);
-  for (auto local_edge = local_edge_to_new_vertex.begin();
-       local_edge != local_edge_to_new_vertex.end();
-       ++local_edge)
+  for (std::size_t local_i = 0; local_i < local_edge_to_new_vertex.size();
+       ++local_i)
   {
+    // Only locally owned new vertices are in the map at this point
+    std::int64_t& new_vertex = local_edge_to_new_vertex[local_i];
+    if (new_vertex < 0)
+      continue;
+
     // Add global_offset to map, to get new global index of new
     // vertices
-    local_edge->second += global_offset;
+    new_vertex += global_offset;
 
-    const std::size_t local_i = local_edge->first;
     //shared, but locally owned : remote owned are not in list.
     auto shared_edge_i = shared_edges.find(local_i);
     if (shared_edge_i != shared_edges.end())
     {
-      for (auto remote_process_edge = shared_edges[local_i].begin();
-           remote_process_edge != shared_edges[local_i].end();
+      for (auto remote_process_edge = shared_edge_i->second.begin();
+           remote_process_edge != shared_edge_i->second.end();
            ++remote_process_edge)
       {
         const std::size_t remote_proc_num = remote_process_edge->first;
         // send mapping from remote local edge index to new global vertex index
         values_to_send[remote_proc_num].push_back(remote_process_edge->second);
-        values_to_send[remote_proc_num].push_back(local_edge->second);
+        values_to_send[remote_proc_num].push_back(new_vertex);
       }
     }
   }
@@ -339,6 +348,8 @@ void ParallelRefinement::reorder_vertices_by_global_indices(
 //-----------------------------------------------------------------------------
 void ParallelRefinement::build_local(Mesh& new_mesh) const
 {
+  Timer t("Parallel Refine: build local mesh");
+
   MeshEditor ed;
   const std::size_t tdim = _mesh.topology().dim();
   const std::size_t gdim = _mesh.geometry().dim();
@@ -351,27 +362,46 @@ void ParallelRefinement::build_local(Mesh& new_mesh) const
 
   ed.open(new_mesh, tdim, gdim);
   ed.init_vertices(num_vertices);
-  std::size_t i = 0;
-  for (auto p = new_vertex_coordinates.begin(); p != new_vertex_coordinates.end();
-       p += gdim)
-  {
-    std::vector<double> vertex(p, p + gdim);
-    ed.add_vertex(i, vertex);
-    ++i;
-  }
-
   ed.init_cells(num_cells);
-  i = 0;
-  std::vector<std::size_t> cell(num_cell_vertices);
-  for (auto p = new_cell_topology.begin(); p != new_cell_topology.end();
-       p += num_cell_vertices)
+
+  // Write vertices and cells directly into the geometry and topology
+  // storage (local and global indices are equal in serial)
+  MeshGeometry& geometry = new_mesh.geometry();
+  MeshTopology& topology = new_mesh.topology();
+  MeshConnectivity& cell_vertices = topology(tdim, 0);
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel num_threads(num_threads)
+  #endif
   {
-    std::copy(p, p + num_cell_vertices, cell.begin());
-    ed.add_cell(i, cell);
-    ++i;
+    std::vector<double> vertex(gdim);
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int i = 0; i < (int) num_vertices; i++)
+    {
+      std::copy(new_vertex_coordinates.begin() + i*gdim,
+                new_vertex_coordinates.begin() + (i + 1)*gdim,
+                vertex.begin());
+      geometry.set(i, vertex);
+      topology.set_global_index(0, i, i);
+    }
+
+    std::vector<std::size_t> cell(num_cell_vertices);
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int i = 0; i < (int) num_cells; i++)
+    {
+      std::copy(new_cell_topology.begin() + i*num_cell_vertices,
+                new_cell_topology.begin() + (i + 1)*num_cell_vertices,
+                cell.begin());
+      cell_vertices.set(i, cell.data());
+      topology.set_global_index(tdim, i, i);
+    }
   }
-  ed.close();
 
+  ed.close();
 }
 //-----------------------------------------------------------------------------
 void ParallelRefinement::partition(Mesh& new_mesh, bool redistribute) const
@@ -448,3 +478,9 @@ void ParallelRefinement::new_cell(const std::vector<std::size_t>& idx)
   new_cell_topology.insert(new_cell_topology.end(), idx.begin(), idx.end());
 }
 //-----------------------------------------------------------------------------
+void ParallelRefinement::new_cells(std::vector<std::size_t>& cell_topology)
+{
+  new_cell_topology.swap(cell_topology);
+  cell_topology.clear();
+}
+//-----------------------------------------------------------------------------
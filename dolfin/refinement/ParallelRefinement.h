@@ -17,11 +17,12 @@
 //
 //
 // First Added: 2013-01-02
-// Last Changed: 2013-01-17
+// Last Changed: 2026-10-19
 
 #ifndef __PARALLEL_REFINEMENT_H
 #define __PARALLEL_REFINEMENT_H
 
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -79,8 +80,9 @@ namespace dolfin
     void create_new_vertices();
 
     /// Mapping of old edge (to be removed) to new global vertex
-    /// number. Useful for forming new topology
-    const std::map<std::size_t, std::size_t>& edge_to_new_vertex() const;
+    /// number, indexed by local edge index. Unmarked edges map to
+    /// -1. Useful for forming new topology
+    const std::vector<std::int64_t>& edge_to_new_vertex() const;
 
     /// Add a new cell to the list in 3D or 2D
     void new_cell(const Cell& cell);
@@ -89,6 +91,10 @@ namespace dolfin
     void new_cell(std::size_t i0, std::size_t i1, std::size_t i2);
     void new_cell(const std::vector<std::size_t>& idx);
 
+    /// Set topology (global vertex indices) of all new cells. The
+    /// array is swapped into this object and is empty on return.
+    void new_cells(std::vector<std::size_t>& cell_topology);
+
     /// Use vertex and topology data to partition new mesh across processes
     void partition(Mesh& new_mesh, bool redistribute) const;
 
@@ -104,9 +110,9 @@ namespace dolfin
     std::unordered_map<unsigned int, std::vector<std::pair<unsigned int,
       unsigned int> > > shared_edges;
 
-    // Mapping from old local edge index to new global vertex, needed
-    // to create new topology
-    std::map<std::size_t, std::size_t> local_edge_to_new_vertex;
+    // Mapping from old local edge index to new global vertex (-1 if
+    // edge is not marked), needed to create new topology
+    std::vector<std::int64_t> local_edge_to_new_vertex;
 
     // New storage for all coordinates when creating new vertices
     std::vector<double> new_vertex_coordinates;
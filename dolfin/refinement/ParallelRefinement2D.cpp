@@ -17,10 +17,10 @@
 //
 //
 // First Added: 2012-12-19
-// Last Changed: 2013-05-12
+// Last Changed: 2026-10-19
 
 
-#include <map>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 #include <boost/multi_array.hpp>
@@ -95,12 +95,9 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
   // Mark all edges, and create new vertices
   p.mark_all();
   p.create_new_vertices();
-  const std::map<std::size_t, std::size_t>& edge_to_new_vertex
+  const std::vector<std::int64_t>& edge_to_new_vertex
     = p.edge_to_new_vertex();
 
-  // Convenience iterator
-  std::map<std::size_t, std::size_t>::const_iterator it;
-
   // Generate new topology
   for (CellIterator cell(mesh); !cell.end(); ++cell)
   {
@@ -111,21 +108,14 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
     const std::size_t v1 = v[1].global_index();
     const std::size_t v2 = v[2].global_index();
 
-    it = edge_to_new_vertex.find(e[0].index());
-    dolfin_assert(it != edge_to_new_vertex.end());
-    const std::size_t e0 = it->second;
-
-    it = edge_to_new_vertex.find(e[1].index());
-    dolfin_assert(it != edge_to_new_vertex.end());
-    const std::size_t e1 = it->second;
+    dolfin_assert(edge_to_new_vertex[e[0].index()] != -1);
+    const std::size_t e0 = edge_to_new_vertex[e[0].index()];
 
-    it = edge_to_new_vertex.find(e[2].index());
-    dolfin_assert(it != edge_to_new_vertex.end());
-    const std::size_t e2 = it->second;
+    dolfin_assert(edge_to_new_vertex[e[1].index()] != -1);
+    const std::size_t e1 = edge_to_new_vertex[e[1].index()];
 
-    //const std::size_t e0 = edge_to_new_vertex[e[0].index()];
-    //const std::size_t e1 = edge_to_new_vertex[e[1].index()];
-    //const std::size_t e2 = edge_to_new_vertex[e[2].index()];
+    dolfin_assert(edge_to_new_vertex[e[2].index()] != -1);
+    const std::size_t e2 = edge_to_new_vertex[e[2].index()];
 
     p.new_cell(v0, e2, e1);
     p.new_cell(e2, v1, e0);
@@ -206,12 +196,9 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
   // Generate new vertices from marked edges, and assign global vertex
   // index map.
   p.create_new_vertices();
-  const std::map<std::size_t, std::size_t>& edge_to_new_vertex
+  const std::vector<std::int64_t>& edge_to_new_vertex
     = p.edge_to_new_vertex();
 
-  // Convenience iterator
-  std::map<std::size_t, std::size_t>::const_iterator it;
-
   // Stage 4 - do refinement
   // FIXME - keep reference edges somehow?...
 
@@ -228,18 +215,14 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
     const std::size_t v1 = v[i1].global_index();
     const std::size_t v2 = v[i2].global_index();
 
-    //const std::size_t e0 = edge_to_new_vertex[e[i0].index()];
-    //const std::size_t e1 = edge_to_new_vertex[e[i1].index()];
-    //const std::size_t e2 = edge_to_new_vertex[e[i2].index()];
 
     if (rgb_count == 0) //straight copy of cell (1->1)
       p.new_cell(*cell);
     else if (rgb_count == 1) // "green" refinement (1->2)
     {
       // Always splitting the reference edge (only)
-      it = edge_to_new_vertex.find(e[i0].index());
-      dolfin_assert(it != edge_to_new_vertex.end());
-      const std::size_t e0 = it->second;
+      dolfin_assert(edge_to_new_vertex[e[i0].index()] != -1);
+      const std::size_t e0 = edge_to_new_vertex[e[i0].index()];
 
       p.new_cell(e0, v0, v1);
       p.new_cell(e0, v2, v0);
@@ -249,13 +232,11 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
       // FIXME: more possibilities here - need to do more tests
       if (p.is_marked(e[i2].index()))
       {
-        it = edge_to_new_vertex.find(e[i0].index());
-        dolfin_assert(it != edge_to_new_vertex.end());
-        const std::size_t e0 = it->second;
+        dolfin_assert(edge_to_new_vertex[e[i0].index()] != -1);
+        const std::size_t e0 = edge_to_new_vertex[e[i0].index()];
 
-        it = edge_to_new_vertex.find(e[i2].index());
-        dolfin_assert(it != edge_to_new_vertex.end());
-        const std::size_t e2 = it->second;
+        dolfin_assert(edge_to_new_vertex[e[i2].index()] != -1);
+        const std::size_t e2 = edge_to_new_vertex[e[i2].index()];
 
         p.new_cell(e2, v1, e0);
         p.new_cell(e2, e0, v0);
@@ -263,13 +244,11 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
       }
       else if (p.is_marked(e[i1].index()))
       {
-        it = edge_to_new_vertex.find(e[i0].index());
-        dolfin_assert(it != edge_to_new_vertex.end());
-        const std::size_t e0 = it->second;
+        dolfin_assert(edge_to_new_vertex[e[i0].index()] != -1);
+        const std::size_t e0 = edge_to_new_vertex[e[i0].index()];
 
-        it = edge_to_new_vertex.find(e[i1].index());
-        dolfin_assert(it != edge_to_new_vertex.end());
-        const std::size_t e1 = it->second;
+        dolfin_assert(edge_to_new_vertex[e[i1].index()] != -1);
+        const std::size_t e1 = edge_to_new_vertex[e[i1].index()];
 
         p.new_cell(e0, v0, v1);
         p.new_cell(e1, e0, v2);
@@ -278,17 +257,14 @@ void ParallelRefinement2D::refine(Mesh& new_mesh, const Mesh& mesh,
     }
     else if (rgb_count == 3) // "red" refinement - all split (1->4) cells
     {
-      it = edge_to_new_vertex.find(e[i0].index());
-      dolfin_assert(it != edge_to_new_vertex.end());
-      const std::size_t e0 = it->second;
+      dolfin_assert(edge_to_new_vertex[e[i0].index()] != -1);
+      const std::size_t e0 = edge_to_new_vertex[e[i0].index()];
 
-      it = edge_to_new_vertex.find(e[i1].index());
-      dolfin_assert(it != edge_to_new_vertex.end());
-      const std::size_t e1 = it->second;
+      dolfin_assert(edge_to_new_vertex[e[i1].index()] != -1);
+      const std::size_t e1 = edge_to_new_vertex[e[i1].index()];
 
-      it = edge_to_new_vertex.find(e[i2].index());
-      dolfin_assert(it != edge_to_new_vertex.end());
-      const std::size_t e2 = it->second;
+      dolfin_assert(edge_to_new_vertex[e[i2].index()] != -1);
+      const std::size_t e2 = edge_to_new_vertex[e[i2].index()];
 
       p.new_cell(v0, e2, e1);
       p.new_cell(e2, v1, e0);
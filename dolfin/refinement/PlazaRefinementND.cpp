@@ -16,20 +16,22 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First Added: 2014-05-21
+// Last Changed: 2026-10-19
 
-#include <boost/multi_array.hpp>
-
+#include <algorithm>
 #include <vector>
-#include <set>
-#include <map>
 
+#include <dolfin/common/MPI.h>
 #include <dolfin/common/Timer.h>
 #include <dolfin/mesh/Mesh.h>
+#include <dolfin/mesh/MeshData.h>
 #include <dolfin/mesh/MeshEntityIterator.h>
+#include <dolfin/mesh/MeshTopology.h>
 #include <dolfin/mesh/Cell.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Face.h>
 #include <dolfin/mesh/Vertex.h>
+#include <dolfin/parameter/GlobalParameters.h>
 
 #include "PlazaRefinementND.h" 
 #include "ParallelRefinement.h" 
@@ -38,7 +40,7 @@ using namespace dolfin;
 
 //-----------------------------------------------------------------------------
 void PlazaRefinementND::get_simplices
-(std::vector<std::vector<std::size_t> >& simplex_set,
+(std::vector<std::size_t>& simplex_set,
  const std::vector<bool>& marked_edges,
  const std::vector<std::size_t>& longest_edge,
  std::size_t tdim)
@@ -56,12 +58,10 @@ void PlazaRefinementND::get_simplices
 }
 //-----------------------------------------------------------------------------
 void PlazaRefinementND::get_triangles
-(std::vector<std::vector<std::size_t> >& tri_set,
+(std::vector<std::size_t>& tri_set,
  const std::vector<bool>& marked_edges,
  const std::size_t longest_edge)
 {
-  Timer t0("PLAZA: Get triangles");
-
   // Longest edge must be marked
   dolfin_assert(marked_edges[longest_edge]);
 
@@ -69,50 +69,53 @@ void PlazaRefinementND::get_triangles
 
   // v0 and v1 are at ends of longest_edge (e2)
   // opposite vertex has same index as longest_edge
-  const unsigned int v0 = (longest_edge + 1)%3;
-  const unsigned int v1 = (longest_edge + 2)%3;
-  const unsigned int v2 = longest_edge;
-  const unsigned int e0 = v0 + 3;
-  const unsigned int e1 = v1 + 3;
-  const unsigned int e2 = v2 + 3;
+  const std::size_t v0 = (longest_edge + 1)%3;
+  const std::size_t v1 = (longest_edge + 2)%3;
+  const std::size_t v2 = longest_edge;
+  const std::size_t e0 = v0 + 3;
+  const std::size_t e1 = v1 + 3;
+  const std::size_t e2 = v2 + 3;
 
   // Break each half of triangle into one or two sub-triangles
 
   if (marked_edges[v0])
   {
-    tri_set.push_back(std::vector<std::size_t>{e2, v2, e0});
-    tri_set.push_back(std::vector<std::size_t>{e2, e0, v1});
+    const std::size_t t[6] = {e2, v2, e0, e2, e0, v1};
+    tri_set.insert(tri_set.end(), t, t + 6);
   }
   else
-    tri_set.push_back(std::vector<std::size_t>{e2, v2, v1});
+  {
+    const std::size_t t[3] = {e2, v2, v1};
+    tri_set.insert(tri_set.end(), t, t + 3);
+  }
 
   if (marked_edges[v1])
   {
-    tri_set.push_back(std::vector<std::size_t>{e2, v2, e1});
-    tri_set.push_back(std::vector<std::size_t>{e2, e1, v0});
+    const std::size_t t[6] = {e2, v2, e1, e2, e1, v0};
+    tri_set.insert(tri_set.end(), t, t + 6);
   }
   else
-    tri_set.push_back(std::vector<std::size_t>{e2, v2, v0});
-
+  {
+    const std::size_t t[3] = {e2, v2, v0};
+    tri_set.insert(tri_set.end(), t, t + 3);
+  }
 }
 //-----------------------------------------------------------------------------
 void PlazaRefinementND::get_tetrahedra(
-            std::vector<std::vector<std::size_t> >& tet_set,
+            std::vector<std::size_t>& tet_set,
             const std::vector<bool>& marked_edges,
-            const std::vector<std::size_t> longest_edge)
+            const std::vector<std::size_t>& longest_edge)
 {
-  Timer t0("PLAZA: Get tetrahedra");
-
   tet_set.clear();
 
   // Connectivity matrix
   // Only need upper triangle, but sometimes it is easier just to insert
   // both entries (j,i) and (i,j).
-  boost::multi_array<bool, 2> conn(boost::extents[10][10]);
-  std::fill(conn.data(), conn.data() + 100, false);
+  bool conn[10][10];
+  std::fill(&conn[0][0], &conn[0][0] + 100, false);
 
   // Edge connectivity to vertices (and by extension facets)
-  static std::size_t edges[6][2] = {{2, 3}, 
+  static const std::size_t edges[6][2] = {{2, 3}, 
                                     {1, 3},
                                     {1, 2},
                                     {0, 3},
@@ -184,22 +187,24 @@ void PlazaRefinementND::get_tetrahedra(
     for (std::size_t j = i + 1; j < 10; ++j)
       if (conn[i][j])
       {
-        std::vector<std::size_t> facet_set;
+        std::size_t facet_set[10];
+        std::size_t num_facet = 0;
         for (std::size_t k = j + 1; k < 10; ++k)
         {
           if (conn[i][k] && conn[j][k])
-            facet_set.push_back(k);
+            facet_set[num_facet++] = k;
         }
-        // Note that j>i and k>j. facet_set is in increasing order, so *q > *p.
+        // Note that j>i and k>j. facet_set is in increasing order, so q > p.
         // Should never repeat same tetrahedron twice.
-        for(auto p = facet_set.begin(); p != facet_set.end(); ++p)
+        for (std::size_t p = 0; p < num_facet; ++p)
         {
-          for(auto q = p + 1; q != facet_set.end(); ++q)
+          for (std::size_t q = p + 1; q < num_facet; ++q)
           {
-            if(conn[*p][*q])
-            {     
-              std::vector<std::size_t> tet{i, j, *p, *q};
-              tet_set.push_back(tet);
+            if (conn[facet_set[p]][facet_set[q]])
+            {
+              const std::size_t tet[4]
+                = {i, j, facet_set[p], facet_set[q]};
+              tet_set.insert(tet_set.end(), tet, tet + 4);
             }
           }
         }
@@ -313,108 +318,167 @@ void PlazaRefinementND::refine(Mesh& new_mesh, const Mesh& mesh,
   do_refine(new_mesh, mesh, p_ref, long_edge, redistribute);
 }
 //-----------------------------------------------------------------------------
-void PlazaRefinementND::do_refine(Mesh& new_mesh, const Mesh& mesh, 
+void PlazaRefinementND::do_refine(Mesh& new_mesh, const Mesh& mesh,
                                   ParallelRefinement& p_ref,
                                   const std::vector<std::size_t>& long_edge,
                                   bool redistribute)
 {
+  Timer t0("PLAZA: Subdivide cells");
+
   const std::size_t tdim = mesh.topology().dim();
   const std::size_t num_cell_edges = tdim*3 - 3;
   const std::size_t num_cell_vertices = tdim + 1;
- 
+
+  // Only regular cells are subdivided (ghost cells are refined by
+  // their owner)
+  const std::size_t num_cells = mesh.topology().ghost_offset(tdim);
+
   // Make new vertices in parallel
   p_ref.create_new_vertices();
-  const std::map<std::size_t, std::size_t>& new_vertex_map 
+  const std::vector<std::int64_t>& new_vertex_map
     = p_ref.edge_to_new_vertex();
 
-  std::vector<std::size_t> parent_cell;
-  std::vector<std::size_t> indices(num_cell_vertices + num_cell_edges);
-  std::vector<std::size_t> marked_edge_list;
-
-  for (CellIterator cell(mesh); !cell.end(); ++cell)
+  // Cell-edge (and cell-face) connectivity must exist before
+  // entering the threaded loops
+  mesh.init(1);
+  if (tdim == 3)
+    mesh.init(2);
+
+  // Cells are subdivided in two passes: count the new cells of each
+  // cell, then fill the new topology at the computed offsets
+  std::vector<std::size_t> offsets(num_cells + 1, 0);
+  std::vector<std::size_t> cell_topology, parent_cell;
+  #ifdef HAS_OPENMP
+  const int num_threads = std::max(1, (int) parameters["num_threads"]);
+  #pragma omp parallel num_threads(num_threads)
+  #endif
   {
-    // Create vector of indices in the order
-    // [vertices][edges], 3+3 in 2D, 4+6 in 3D
-    std::size_t j = 0;
-    for (VertexIterator v(*cell); !v.end(); ++v)
-      indices[j++] = v->global_index();
-    
-    marked_edge_list = p_ref.marked_edge_list(*cell);
+    std::vector<std::size_t> simplex_set;
+    std::vector<bool> markers(num_cell_edges);
+    std::vector<std::size_t> longest_edge;
+
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int c = 0; c < (int) num_cells; c++)
+    {
+      cell_simplices(simplex_set, mesh, c, new_vertex_map, long_edge,
+                     markers, longest_edge);
+      offsets[c + 1] = simplex_set.size()/num_cell_vertices;
+    }
 
-    if (marked_edge_list.size() == 0)
+    #ifdef HAS_OPENMP
+    #pragma omp single
+    #endif
     {
-      indices.resize(num_cell_vertices);
-      p_ref.new_cell(indices);
-      parent_cell.push_back(cell->index());
+      for (std::size_t c = 0; c < num_cells; ++c)
+        offsets[c + 1] += offsets[c];
+      cell_topology.resize(offsets[num_cells]*num_cell_vertices);
+      parent_cell.resize(offsets[num_cells]);
     }
-    else
-    {    
-      indices.resize(num_cell_vertices + num_cell_edges);
-      // Get the marked edge indices for new vertices
-      // and make bool vector of marked edges
-      std::vector<bool> markers(num_cell_edges, false);      
-      EdgeIterator e(*cell);
-      for (auto p = marked_edge_list.begin(); p != marked_edge_list.end(); ++p)
-      {
-        markers[*p] = true;
-        const std::size_t edge_index = e[*p].index();
-        auto it = new_vertex_map.find(edge_index);
-        dolfin_assert (it != new_vertex_map.end());
-        indices[num_cell_vertices + *p] = it->second;
-      }    
-
-      // Need longest edges of each facet in cell local indexing
-      std::vector<std::size_t> longest_edge;
-      if (tdim == 3)
-      {        
-        for (FaceIterator f(*cell); !f.end(); ++f)
-          longest_edge.push_back(long_edge[f->index()]);
-      }
-      else if (tdim == 2)
-        longest_edge.push_back(long_edge[cell->index()]);
 
-      // Convert to cell local index
-      for (std::vector<std::size_t>::iterator 
-             p = longest_edge.begin(); p != longest_edge.end(); ++p)
-      {
-        for (EdgeIterator ej(*cell); !ej.end(); ++ej)
-        {
-          if (*p == ej->index())
-          {
-            *p = ej.pos();
-            break;
-          }
-        }
-      }
-      
-      std::vector<std::vector<std::size_t> > simplex_set;      
-      get_simplices(simplex_set, markers, longest_edge, tdim);
-      
-      // Convert from cell local index to mesh index
-      for (auto it = simplex_set.begin(); it != simplex_set.end(); ++it)
-      {
-        for (auto vit = it->begin(); vit != it->end(); ++vit)
-          *vit = indices[*vit];
-        p_ref.new_cell(*it);
-        parent_cell.push_back(cell->index());
-      }
+    #ifdef HAS_OPENMP
+    #pragma omp for schedule(static)
+    #endif
+    for (int c = 0; c < (int) num_cells; c++)
+    {
+      cell_simplices(simplex_set, mesh, c, new_vertex_map, long_edge,
+                     markers, longest_edge);
+      dolfin_assert(simplex_set.size()
+                    == (offsets[c + 1] - offsets[c])*num_cell_vertices);
+      std::copy(simplex_set.begin(), simplex_set.end(),
+                cell_topology.begin() + offsets[c]*num_cell_vertices);
+      std::fill(parent_cell.begin() + offsets[c],
+                parent_cell.begin() + offsets[c + 1], c);
     }
   }
-  
+  p_ref.new_cells(cell_topology);
+  t0.stop();
+
   const bool serial = (MPI::size(mesh.mpi_comm()) == 1);
 
   if (serial)
     p_ref.build_local(new_mesh);
   else
     p_ref.partition(new_mesh, redistribute);
-  
+
   if (serial || !redistribute)
   {
     // Create parent data on new mesh
-    std::vector<std::size_t>& new_parent_cell 
+    std::vector<std::size_t>& new_parent_cell
       = new_mesh.data().create_array("parent_cell", new_mesh.topology().dim());
-    
-    new_parent_cell = parent_cell;
+
+    new_parent_cell.swap(parent_cell);
+  }
+}
+//-----------------------------------------------------------------------------
+void PlazaRefinementND::cell_simplices
+(std::vector<std::size_t>& simplex_set, const Mesh& mesh,
+ std::size_t cell_index,
+ const std::vector<std::int64_t>& edge_to_new_vertex,
+ const std::vector<std::size_t>& long_edge,
+ std::vector<bool>& markers, std::vector<std::size_t>& longest_edge)
+{
+  const MeshTopology& topology = mesh.topology();
+  const std::size_t tdim = topology.dim();
+  const std::size_t num_cell_vertices = tdim + 1;
+  const std::size_t num_cell_edges = tdim*3 - 3;
+  const std::vector<std::size_t>& global_vertices = topology.global_indices(0);
+  const unsigned int* vertices = topology(tdim, 0)(cell_index);
+  const unsigned int* edges = topology(tdim, 1)(cell_index);
+
+  // Mark edges which have a new vertex
+  bool any_marked = false;
+  for (std::size_t i = 0; i < num_cell_edges; ++i)
+  {
+    markers[i] = (edge_to_new_vertex[edges[i]] >= 0);
+    any_marked |= markers[i];
+  }
+
+  simplex_set.clear();
+  if (!any_marked)
+  {
+    // Copy unrefined cell
+    for (std::size_t i = 0; i < num_cell_vertices; ++i)
+      simplex_set.push_back(global_vertices[vertices[i]]);
+    return;
+  }
+
+  // Need longest edges of each facet in cell local indexing
+  longest_edge.clear();
+  if (tdim == 3)
+  {
+    const unsigned int* faces = topology(tdim, 2)(cell_index);
+    for (std::size_t i = 0; i < 4; ++i)
+      longest_edge.push_back(long_edge[faces[i]]);
+  }
+  else if (tdim == 2)
+    longest_edge.push_back(long_edge[cell_index]);
+
+  // Convert to cell local index
+  for (std::size_t i = 0; i < longest_edge.size(); ++i)
+  {
+    const std::size_t local_edge
+      = std::find(edges, edges + num_cell_edges, longest_edge[i]) - edges;
+    dolfin_assert(local_edge < num_cell_edges);
+    longest_edge[i] = local_edge;
+  }
+
+  get_simplices(simplex_set, markers, longest_edge, tdim);
+
+  // Convert from cell local index to global vertex index, in the
+  // order [vertices][edges], 3+3 in 2D, 4+6 in 3D
+  for (std::size_t i = 0; i < simplex_set.size(); ++i)
+  {
+    const std::size_t local = simplex_set[i];
+    if (local < num_cell_vertices)
+      simplex_set[i] = global_vertices[vertices[local]];
+    else
+    {
+      const std::int64_t v = edge_to_new_vertex[edges[local - num_cell_vertices]];
+      dolfin_assert(v >= 0);
+      simplex_set[i] = v;
+    }
   }
-  
 }
+//-----------------------------------------------------------------------------
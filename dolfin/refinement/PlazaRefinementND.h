@@ -19,6 +19,9 @@
 #ifndef __PLAZA_REFINEMENT_ND_H
 #define __PLAZA_REFINEMENT_ND_H
 
+#include <cstdint>
+#include <vector>
+
 namespace dolfin
 {
   class Mesh;
@@ -43,9 +46,11 @@ namespace dolfin
 
     /// Get the subdivision of an original simplex into smaller
     /// simplices, for a given set of marked edges, and the
-    /// longest edge of each facet (cell local indexing)
+    /// longest edge of each facet (cell local indexing). The
+    /// simplices are stored contiguously in simplex_set, with tdim + 1
+    /// local indices each
     static void get_simplices
-      (std::vector<std::vector<std::size_t> >& simplex_set,
+      (std::vector<std::size_t>& simplex_set,
        const std::vector<bool>& marked_edges,
        const std::vector<std::size_t>& longest_edge,
        std::size_t tdim);
@@ -57,15 +62,24 @@ namespace dolfin
     
     // 2D version of subdivision
     static void get_triangles
-      (std::vector<std::vector<std::size_t> >& tri_set,
+      (std::vector<std::size_t>& tri_set,
        const std::vector<bool>& marked_edges,
        const std::size_t longest_edge);
 
     // 3D version of subdivision
     static void get_tetrahedra
-      (std::vector<std::vector<std::size_t> >& tet_set,
+      (std::vector<std::size_t>& tet_set,
        const std::vector<bool>& marked_edges,
-       const std::vector<std::size_t> longest_edge);
+       const std::vector<std::size_t>& longest_edge);
+
+    // Get the subdivision of a cell of the mesh, with global vertex
+    // indices (markers and longest_edge are work arrays)
+    static void cell_simplices
+      (std::vector<std::size_t>& simplex_set, const Mesh& mesh,
+       std::size_t cell_index,
+       const std::vector<std::int64_t>& edge_to_new_vertex,
+       const std::vector<std::size_t>& long_edge,
+       std::vector<bool>& markers, std::vector<std::size_t>& longest_edge);
     
     // Convenient interface for both uniform and marker refinement
     static void do_refine(Mesh& new_mesh, const Mesh& mesh, 
@@ -18,8 +18,10 @@
 // Modified by Garth N. Wells, 2010
 //
 // First added:  2006-06-08
-// Last changed: 2014-02-06
+// Last changed: 2026-10-19
 
+#include <algorithm>
+#include <vector>
 #include <dolfin/math/dolfin_math.h>
 #include <dolfin/log/dolfin_log.h>
 #include <dolfin/mesh/Mesh.h>
@@ -30,6 +32,8 @@
 #include <dolfin/mesh/Vertex.h>
 #include <dolfin/mesh/Edge.h>
 #include <dolfin/mesh/Cell.h>
+#include <dolfin/mesh/MeshData.h>
+#include "MarkerTransfer.h"
 #include "UniformMeshRefinement.h"
 
 using namespace dolfin;
@@ -105,5 +109,89 @@ void UniformMeshRefinement::refine(Mesh& refined_mesh,
 
   // Make sure that mesh is ordered after refinement
   //refined_mesh.order();
+
+  // Record parent maps and transfer subdomain markers
+  compute_parent_maps(refined_mesh, mesh);
+  MarkerTransfer::transfer_domains(refined_mesh, mesh);
+}
+//-----------------------------------------------------------------------------
+void UniformMeshRefinement::compute_parent_maps(Mesh& refined_mesh,
+                                                const Mesh& mesh)
+{
+  const std::size_t D = mesh.topology().dim();
+  const std::size_t num_vertices = mesh.num_vertices();
+
+  // Each cell is refined into 2^D consecutive cells
+  const std::size_t num_children = ipow(2, D);
+  std::vector<std::size_t>& parent_cell
+    = refined_mesh.data().create_array("parent_cell", D);
+  parent_cell.resize(refined_mesh.num_cells());
+  for (std::size_t i = 0; i < parent_cell.size(); ++i)
+    parent_cell[i] = i/num_children;
+
+  if (D == 0)
+    return;
+
+  // Facets of intervals are vertices, which keep their index
+  const std::size_t orphan = mesh.num_facets() + 1;
+  if (D == 1)
+  {
+    std::vector<std::size_t>& parent_facet
+      = refined_mesh.data().create_array("parent_facet", 0);
+    parent_facet.resize(refined_mesh.num_vertices());
+    for (std::size_t v = 0; v < parent_facet.size(); ++v)
+      parent_facet[v] = v < num_vertices ? v : orphan;
+    return;
+  }
+
+  // A refined facet lies on a facet of the parent cell if all its
+  // vertices lie on the closure of that facet. Refined vertices are
+  // either vertices of the mesh (index < num_vertices) or midpoints
+  // of edges (index - num_vertices)
+  refined_mesh.init(D - 1);
+  refined_mesh.init(D - 1, 0);
+  refined_mesh.init(D - 1, D);
+  mesh.init(D - 1);
+  mesh.init(D, D - 1);
+  mesh.init(D - 1, 0);
+  std::vector<std::size_t>& parent_facet
+    = refined_mesh.data().create_array("parent_facet", D - 1);
+  parent_facet.assign(refined_mesh.num_facets(), orphan);
+
+  const MeshConnectivity& refined_facet_cells
+    = refined_mesh.topology()(D - 1, D);
+  const MeshConnectivity& cell_facets = mesh.topology()(D, D - 1);
+  const MeshConnectivity& facet_vertices = mesh.topology()(D - 1, 0);
+  const MeshConnectivity& edge_vertices = mesh.topology()(1, 0);
+  const MeshConnectivity& refined_facet_vertices
+    = refined_mesh.topology()(D - 1, 0);
+  for (std::size_t f = 0; f < parent_facet.size(); ++f)
+  {
+    const unsigned int* vertices = refined_facet_vertices(f);
+    const std::size_t p = parent_cell[refined_facet_cells(f)[0]];
+    for (std::size_t j = 0; j < D + 1; ++j)
+    {
+      const std::size_t facet = cell_facets(p)[j];
+      const unsigned int* fv = facet_vertices(facet);
+      bool on_facet = true;
+      for (std::size_t k = 0; k < D && on_facet; ++k)
+      {
+        if (vertices[k] < num_vertices)
+          on_facet = (std::find(fv, fv + D, vertices[k]) != fv + D);
+        else
+        {
+          const unsigned int* ev = edge_vertices(vertices[k] - num_vertices);
+          on_facet = (std::find(fv, fv + D, ev[0]) != fv + D)
+                  && (std::find(fv, fv + D, ev[1]) != fv + D);
+        }
+      }
+
+      if (on_facet)
+      {
+        parent_facet[f] = facet;
+        break;
+      }
+    }
+  }
 }
 //-----------------------------------------------------------------------------
@@ -18,7 +18,7 @@
 // Modified by Garth N. Wells, 2010
 //
 // First added:  2006-06-07
-// Last changed: 2010-02-26
+// Last changed: 2026-10-19
 
 #ifndef __UNIFORM_MESH_REFINEMENT_H
 #define __UNIFORM_MESH_REFINEMENT_H
@@ -28,7 +28,11 @@ namespace dolfin
 
   class Mesh;
 
-  /// This class implements uniform mesh refinement.
+  /// This class implements uniform mesh refinement. The parent cell
+  /// and parent facet of each cell and facet of the refined mesh are
+  /// stored as "parent_cell" and "parent_facet" in the mesh data of
+  /// the refined mesh, and subdomain markers (MeshDomains) are
+  /// transferred to the refined mesh.
 
   class UniformMeshRefinement
   {
@@ -37,6 +41,11 @@ namespace dolfin
     /// Refine mesh uniformly
     static void refine(Mesh& refined_mesh, const Mesh& mesh);
 
+  private:
+
+    // Compute parent cell and parent facet maps of refined mesh
+    static void compute_parent_maps(Mesh& refined_mesh, const Mesh& mesh);
+
   };
 
 }
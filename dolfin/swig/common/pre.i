@@ -65,6 +65,11 @@
 //-----------------------------------------------------------------------------
 %ignore dolfin::Set::operator[];
 
+//-----------------------------------------------------------------------------
+// Ignore MPI functions operating on raw MPI requests
+//-----------------------------------------------------------------------------
+%ignore dolfin::MPI::wait_all;
+
 //-----------------------------------------------------------------------------
 // Copy Array construction typemaps from NumPy typemaps
 //-----------------------------------------------------------------------------
@@ -10,3 +10,4 @@
 // Instantiate template classes
 // ---------------------------------------------------------------------------
 %template(Graph) std::vector<dolfin::graph_set_type>;
+%template(CSRGraph) dolfin::CSRGraph<int>;
@@ -148,6 +148,10 @@
 %ignore dolfin::GenericVector::operator-=;
 %ignore dolfin::GenericVector::getitem;
 %ignore dolfin::GenericVector::setitem;
+%ignore dolfin::GenericVector::maxpy;
+%ignore dolfin::Vector::maxpy;
+%ignore dolfin::PETScVector::maxpy;
+%ignore dolfin::uBLASVector::maxpy;
 
 //-----------------------------------------------------------------------------
 // Ignore the get and set functions used for blocks
@@ -63,6 +63,7 @@
 %shared_ptr(dolfin::TimeSeriesHDF5)
 
 // ale
+%shared_ptr(dolfin::HarmonicSmoothing)
 %shared_ptr(dolfin::MeshDisplacement)
 
 // common
@@ -76,6 +77,7 @@
 %shared_ptr(dolfin::Form)
 %shared_ptr(dolfin::FiniteElement)
 %shared_ptr(dolfin::BasisFunction)
+%shared_ptr(dolfin::MatrixFreeOperator)
 %shared_ptr(dolfin::MultiStageScheme)
 
 %shared_ptr(dolfin::Hierarchical<dolfin::LinearVariationalProblem>)
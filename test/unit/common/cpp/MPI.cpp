@@ -0,0 +1,227 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+//
+// Unit tests for neighbour communication in MPI
+
+#include <algorithm>
+#include <vector>
+#include <dolfin.h>
+#include <dolfin/common/unittest.h>
+
+using namespace dolfin;
+
+class NeighborCommunication : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(NeighborCommunication);
+  CPPUNIT_TEST(test_compute_sources_ring);
+  CPPUNIT_TEST(test_compute_sources_asymmetric);
+  CPPUNIT_TEST(test_compute_sources_repeated);
+  CPPUNIT_TEST(test_neighbor_all_to_all);
+  CPPUNIT_TEST(test_neighbor_all_to_all_begin);
+  CPPUNIT_TEST(test_neighbor_all_to_all_empty);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void test_compute_sources_ring()
+  {
+    // Each process sends to the next process
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    const std::vector<int> destinations(1, (rank + 1) % size);
+    const std::vector<int> sources(1, (rank + size - 1) % size);
+    CPPUNIT_ASSERT(dolfin::MPI::compute_sources(comm, destinations)
+                   == sources);
+    CPPUNIT_ASSERT(dolfin::MPI::compute_sources_dense(comm, destinations)
+                   == sources);
+  }
+
+  void test_compute_sources_asymmetric()
+  {
+    // Process 0 sends to all other processes, which send nothing
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    std::vector<int> destinations, sources;
+    if (rank == 0)
+    {
+      for (int p = 1; p < size; ++p)
+        destinations.push_back(p);
+    }
+    else
+      sources.push_back(0);
+    CPPUNIT_ASSERT(dolfin::MPI::compute_sources(comm, destinations)
+                   == sources);
+    CPPUNIT_ASSERT(dolfin::MPI::compute_sources_dense(comm, destinations)
+                   == sources);
+  }
+
+  void test_compute_sources_repeated()
+  {
+    // Back-to-back calls with changing patterns (the tags of
+    // consecutive calls alternate, so messages of one call must not
+    // be received by the next)
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    for (int k = 0; k < 10; ++k)
+    {
+      // Send to the k + 1 following processes, or to none for odd
+      // ranks every third call
+      std::vector<int> destinations;
+      if (k % 3 != 0 || rank % 2 == 0)
+      {
+        for (int i = 1; i <= std::min(k + 1, size); ++i)
+          destinations.push_back((rank + i) % size);
+      }
+      std::sort(destinations.begin(), destinations.end());
+      destinations.erase(std::unique(destinations.begin(),
+                                     destinations.end()),
+                         destinations.end());
+
+      std::vector<int> sources;
+      for (int p = 0; p < size; ++p)
+      {
+        if (k % 3 != 0 || p % 2 == 0)
+        {
+          for (int i = 1; i <= std::min(k + 1, size); ++i)
+          {
+            if ((p + i) % size == rank)
+            {
+              sources.push_back(p);
+              break;
+            }
+          }
+        }
+      }
+
+      CPPUNIT_ASSERT(dolfin::MPI::compute_sources(comm, destinations)
+                     == sources);
+      CPPUNIT_ASSERT(dolfin::MPI::compute_sources_dense(comm, destinations)
+                     == sources);
+    }
+  }
+
+  void test_neighbor_all_to_all()
+  {
+    // Send p + 1 values to each process p that is a destination
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    std::vector<int> destinations, send_offsets;
+    std::vector<double> send_data;
+    create_data(rank, size, destinations, send_offsets, send_data);
+
+    std::vector<int> sources, recv_offsets;
+    std::vector<double> recv_data;
+    dolfin::MPI::neighbor_all_to_all(comm, destinations, send_offsets,
+                                     send_data, sources, recv_offsets,
+                                     recv_data);
+    check_data(rank, size, sources, recv_offsets, recv_data);
+  }
+
+  void test_neighbor_all_to_all_begin()
+  {
+    // Same as above, with known sources and a non-blocking exchange
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    std::vector<int> destinations, send_offsets;
+    std::vector<double> send_data;
+    create_data(rank, size, destinations, send_offsets, send_data);
+
+    const std::vector<int> sources
+      = dolfin::MPI::compute_sources_dense(comm, destinations);
+    std::vector<int> recv_offsets;
+    std::vector<double> recv_data;
+    std::vector<MPI_Request> requests;
+    dolfin::MPI::neighbor_all_to_all_begin(comm, destinations,
+                                           send_offsets, send_data,
+                                           sources, recv_offsets,
+                                           recv_data, requests);
+    CPPUNIT_ASSERT_EQUAL(sources.size() + 1, recv_offsets.size());
+    dolfin::MPI::wait_all(requests);
+    CPPUNIT_ASSERT(requests.empty());
+    check_data(rank, size, sources, recv_offsets, recv_data);
+  }
+
+  void test_neighbor_all_to_all_empty()
+  {
+    // No process sends anything
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const std::vector<int> destinations, send_offsets(1, 0);
+    const std::vector<double> send_data;
+    std::vector<int> sources, recv_offsets;
+    std::vector<double> recv_data;
+    dolfin::MPI::neighbor_all_to_all(comm, destinations, send_offsets,
+                                     send_data, sources, recv_offsets,
+                                     recv_data);
+    CPPUNIT_ASSERT(sources.empty());
+    CPPUNIT_ASSERT(recv_offsets == send_offsets);
+    CPPUNIT_ASSERT(recv_data.empty());
+  }
+
+private:
+
+  // Create data sent from process rank: process rank sends to the
+  // processes p >= rank (including itself), p + 1 values rank*100 +
+  // p*10 + i
+  static void create_data(int rank, int size, std::vector<int>& destinations,
+                          std::vector<int>& send_offsets,
+                          std::vector<double>& send_data)
+  {
+    send_offsets.assign(1, 0);
+    for (int p = rank; p < size; ++p)
+    {
+      destinations.push_back(p);
+      for (int i = 0; i <= p; ++i)
+        send_data.push_back(rank*100 + p*10 + i);
+      send_offsets.push_back(send_data.size());
+    }
+  }
+
+  // Check data received by process rank (from processes q <= rank)
+  static void check_data(int rank, int size, const std::vector<int>& sources,
+                         const std::vector<int>& recv_offsets,
+                         const std::vector<double>& recv_data)
+  {
+    CPPUNIT_ASSERT_EQUAL((std::size_t) rank + 1, sources.size());
+    CPPUNIT_ASSERT_EQUAL(sources.size() + 1, recv_offsets.size());
+    for (std::size_t j = 0; j < sources.size(); ++j)
+    {
+      const int q = sources[j];
+      CPPUNIT_ASSERT_EQUAL((int) j, q);
+      CPPUNIT_ASSERT_EQUAL(rank + 1, recv_offsets[j + 1] - recv_offsets[j]);
+      for (int i = 0; i <= rank; ++i)
+      {
+        CPPUNIT_ASSERT_EQUAL((double) (q*100 + rank*10 + i),
+                             recv_data[recv_offsets[j] + i]);
+      }
+    }
+  }
+
+};
+
+int main()
+{
+  CPPUNIT_TEST_SUITE_REGISTRATION(NeighborCommunication);
+  DOLFIN_TEST;
+}
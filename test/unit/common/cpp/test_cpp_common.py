@@ -0,0 +1,3 @@
+#!/usr/bin/env py.test
+from dolfin_utils.test import cpp_tester
+test_cpp_common = cpp_tester
@@ -0,0 +1,168 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+//
+// Unit tests for HaloExchange
+
+#include <utility>
+#include <vector>
+#include <dolfin.h>
+#include <dolfin/common/unittest.h>
+#include <dolfin/la/HaloExchange.h>
+
+using namespace dolfin;
+
+// Number of blocks owned by each process and block size
+static const std::size_t num_blocks = 4;
+static const std::size_t bs = 3;
+
+class TestHaloExchange : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestHaloExchange);
+  CPPUNIT_TEST(test_update);
+  CPPUNIT_TEST(test_accumulate);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void test_update()
+  {
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    std::vector<std::size_t> ghosts;
+    std::vector<int> owners;
+    create_ghosts(rank, size, ghosts, owners);
+    HaloExchange halo(comm, local_range(rank), ghosts, owners, bs);
+    CPPUNIT_ASSERT_EQUAL(bs, halo.block_size());
+    CPPUNIT_ASSERT_EQUAL(bs*num_blocks, halo.num_owned());
+    CPPUNIT_ASSERT_EQUAL(bs*ghosts.size(), halo.num_ghosts());
+
+    // Set owned values from global block index, and ghosts to -1
+    std::vector<double> x(halo.num_owned() + halo.num_ghosts(), -1.0);
+    for (std::size_t b = 0; b < num_blocks; ++b)
+      for (std::size_t k = 0; k < bs; ++k)
+        x[bs*b + k] = value(rank*num_blocks + b, k);
+
+    // Ghost values are set by update_end only
+    halo.update_begin(x);
+    for (std::size_t i = halo.num_owned(); i < x.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL(-1.0, x[i]);
+    halo.update_end(x);
+
+    for (std::size_t j = 0; j < ghosts.size(); ++j)
+    {
+      for (std::size_t k = 0; k < bs; ++k)
+      {
+        CPPUNIT_ASSERT_EQUAL(value(ghosts[j], k),
+                             x[halo.num_owned() + bs*j + k]);
+      }
+    }
+  }
+
+  void test_accumulate()
+  {
+    const MPI_Comm comm = MPI_COMM_WORLD;
+    const int rank = dolfin::MPI::rank(comm);
+    const int size = dolfin::MPI::size(comm);
+    std::vector<std::size_t> ghosts;
+    std::vector<int> owners;
+    create_ghosts(rank, size, ghosts, owners);
+    HaloExchange halo(comm, local_range(rank), ghosts, owners, bs);
+
+    // Set owned values to one and ghost values from rank and ghost
+    // number
+    std::vector<double> x(halo.num_owned() + halo.num_ghosts(), 1.0);
+    for (std::size_t j = 0; j < ghosts.size(); ++j)
+      for (std::size_t k = 0; k < bs; ++k)
+        x[halo.num_owned() + bs*j + k] = contribution(rank, j, k);
+
+    halo.accumulate_begin(x);
+    halo.accumulate_end(x);
+
+    // Compute expected sums from the ghosts of all processes
+    std::vector<double> sums(bs*num_blocks, 1.0);
+    for (int p = 0; p < size; ++p)
+    {
+      std::vector<std::size_t> p_ghosts;
+      std::vector<int> p_owners;
+      create_ghosts(p, size, p_ghosts, p_owners);
+      for (std::size_t j = 0; j < p_ghosts.size(); ++j)
+      {
+        if (p_owners[j] != rank)
+          continue;
+        const std::size_t b = p_ghosts[j] - rank*num_blocks;
+        for (std::size_t k = 0; k < bs; ++k)
+          sums[bs*b + k] += contribution(p, j, k);
+      }
+    }
+
+    for (std::size_t i = 0; i < halo.num_owned(); ++i)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(sums[i], x[i], 1.0e-12);
+  }
+
+private:
+
+  // Range of owned values on process
+  static std::pair<std::size_t, std::size_t> local_range(int rank)
+  {
+    return std::make_pair(bs*num_blocks*rank, bs*num_blocks*(rank + 1));
+  }
+
+  // Create ghosts of process rank: the first two blocks of the next
+  // process (in reverse order), and for process 0 also the first
+  // block of all other processes
+  static void create_ghosts(int rank, int size,
+                            std::vector<std::size_t>& ghosts,
+                            std::vector<int>& owners)
+  {
+    ghosts.clear();
+    owners.clear();
+    if (size == 1)
+      return;
+
+    const int next = (rank + 1) % size;
+    ghosts.push_back(next*num_blocks + 1);
+    ghosts.push_back(next*num_blocks);
+    owners.assign(2, next);
+    if (rank == 0)
+    {
+      for (int p = 2; p < size; ++p)
+      {
+        ghosts.push_back(p*num_blocks);
+        owners.push_back(p);
+      }
+    }
+  }
+
+  // Value of entry k of global block
+  static double value(std::size_t block, std::size_t k)
+  { return 10.0*block + k; }
+
+  // Value of entry k of ghost j on process rank
+  static double contribution(int rank, std::size_t j, std::size_t k)
+  { return 100.0*rank + 10.0*j + k; }
+
+};
+
+int main()
+{
+  CPPUNIT_TEST_SUITE_REGISTRATION(TestHaloExchange);
+  DOLFIN_TEST;
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2026 DOLFIN contributors
+//
+// This file is part of DOLFIN.
+//
+// DOLFIN is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DOLFIN is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+//
+// First added:  2026-10-19
+// Last changed:
+//
+// Unit tests for the uBLAS ILU preconditioner
+
+#include <dolfin.h>
+#include <dolfin/common/unittest.h>
+
+using namespace dolfin;
+
+class TestuBLASILUPreconditioner : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestuBLASILUPreconditioner);
+  CPPUNIT_TEST(test_exact_tridiagonal);
+  CPPUNIT_TEST(test_missing_diagonal);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void test_exact_tridiagonal()
+  {
+    // ILU(0) of a tridiagonal matrix has no fill-in and is exact
+    uBLASMatrix<ublas_sparse_matrix> A;
+    tridiagonal(A, 50, 50);
+    check_solve(A, 0.0);
+  }
+
+  void test_missing_diagonal()
+  {
+    // Row 5 has no diagonal entry in the sparsity pattern
+    uBLASMatrix<ublas_sparse_matrix> A;
+    tridiagonal(A, 50, 5);
+
+    // Without a shift this is a zero pivot
+    Parameters p = KrylovSolver::default_parameters();
+    uBLASILUPreconditioner pc(p);
+    CPPUNIT_ASSERT_THROW(pc.init(A), std::runtime_error);
+
+    // With a shift the diagonal entry is added, and ILU(0) is exact
+    // for the shifted matrix
+    check_solve(A, 1.0);
+  }
+
+private:
+
+  // Create tridiagonal matrix [-1 2 -1] without the diagonal entry
+  // in row skip
+  static void tridiagonal(uBLASMatrix<ublas_sparse_matrix>& A,
+                          std::size_t n, std::size_t skip)
+  {
+    ublas_sparse_matrix& M = A.mat();
+    M.resize(n, n, false);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (i > 0)
+        M.insert_element(i, i - 1, -1.0);
+      if (i != skip)
+        M.insert_element(i, i, 2.0);
+      if (i + 1 < n)
+        M.insert_element(i, i + 1, -1.0);
+    }
+    M.complete_index1_data();
+  }
+
+  // Check that the preconditioner solves (A + shift*I)x = b
+  static void check_solve(const uBLASMatrix<ublas_sparse_matrix>& A,
+                          double shift)
+  {
+    Parameters p = KrylovSolver::default_parameters();
+    p("preconditioner")["shift_nonzero"] = shift;
+    uBLASILUPreconditioner pc(p);
+    pc.init(A);
+
+    const std::size_t n = A.size(0);
+    uBLASVector b(n), x(n);
+    for (std::size_t i = 0; i < n; ++i)
+      b.vec()(i) = 1.0 + i % 3;
+    pc.solve(x, b);
+
+    const ublas_vector r = ublas::prod(A.mat(), x.vec()) + shift*x.vec()
+      - b.vec();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, ublas::norm_inf(r), 1.0e-10);
+  }
+
+};
+
+int main()
+{
+  CPPUNIT_TEST_SUITE_REGISTRATION(TestuBLASILUPreconditioner);
+  DOLFIN_TEST;
+}
@@ -18,12 +18,13 @@
 // Modified by Benjamin Kehlet 2012
 //
 // First added:  2007-05-14
-// Last changed: 2012-11-12
+// Last changed: 2026-10-19
 //
 // Unit tests for the mesh library
 
 #include <dolfin.h>
 #include <dolfin/common/unittest.h>
+#include <dolfin/refinement/PlazaRefinementND.h>
 
 using namespace dolfin;
 
@@ -59,6 +60,7 @@ class MeshRefinement : public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(MeshRefinement);
   CPPUNIT_TEST(testRefineUnitSquareMesh);
   CPPUNIT_TEST(testRefineUnitCubeMesh);
+  CPPUNIT_TEST(testPlazaRefinementThreaded);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -81,6 +83,46 @@ public:
     CPPUNIT_ASSERT(mesh1.num_cells() == 15120);
   }
 
+  void testPlazaRefinementThreaded()
+  {
+    // Partial refinement gives a varying number of new cells per
+    // cell, so the threaded two-pass subdivision must give the same
+    // mesh as the serial one
+    UnitSquareMesh mesh2(6, 5);
+    UnitCubeMesh mesh3(4, 3, 3);
+    check_plaza_threads(mesh2);
+    check_plaza_threads(mesh3);
+  }
+
+private:
+
+  void check_plaza_threads(const Mesh& mesh)
+  {
+    const std::size_t tdim = mesh.topology().dim();
+    CellFunction<bool> markers(mesh, false);
+    for (CellIterator c(mesh); !c.end(); ++c)
+      markers[*c] = (c->midpoint().x() < 0.5);
+
+    const int num_threads = parameters["num_threads"];
+    Mesh mesh0, mesh1;
+    parameters["num_threads"] = 1;
+    PlazaRefinementND::refine(mesh0, mesh, markers, false);
+    parameters["num_threads"] = 4;
+    PlazaRefinementND::refine(mesh1, mesh, markers, false);
+    parameters["num_threads"] = num_threads;
+
+    CPPUNIT_ASSERT(mesh0.num_cells() > mesh.num_cells());
+    CPPUNIT_ASSERT_EQUAL(mesh0.num_vertices(), mesh1.num_vertices());
+    CPPUNIT_ASSERT_EQUAL(mesh0.num_cells(), mesh1.num_cells());
+    CPPUNIT_ASSERT(mesh0.cells() == mesh1.cells());
+
+    const std::vector<std::size_t>& parent0
+      = mesh0.data().array("parent_cell", tdim);
+    const std::vector<std::size_t>& parent1
+      = mesh1.data().array("parent_cell", tdim);
+    CPPUNIT_ASSERT(parent0 == parent1);
+  }
+
 };
 
 class MeshIterators : public CppUnit::TestFixture
@@ -159,6 +201,118 @@ public:
 
 };
 
+class MeshRanges : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MeshRanges);
+  CPPUNIT_TEST(testCells);
+  CPPUNIT_TEST(testFacetCells);
+  CPPUNIT_TEST(testCoordinates);
+  CPPUNIT_TEST(testOptions);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testCells()
+  {
+    // Compare cell vertices with CellIterator
+    UnitCubeMesh mesh(3, 3, 3);
+    const StridedArray<unsigned int> cells = MeshRange::cells(mesh);
+    CPPUNIT_ASSERT_EQUAL(mesh.num_cells(), cells.size());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 4, cells.stride());
+    CPPUNIT_ASSERT(cells.data() == cells[0]);
+
+    const IndexRange range = MeshRange::entities(mesh, 3);
+    IndexRange::iterator c = range.begin();
+    std::size_t n = 0;
+    for (CellIterator cell(mesh); !cell.end(); ++cell, ++c, ++n)
+    {
+      CPPUNIT_ASSERT(c != range.end());
+      CPPUNIT_ASSERT_EQUAL(cell->index(), *c);
+      for (std::size_t i = 0; i < 4; ++i)
+        CPPUNIT_ASSERT_EQUAL(cell->entities(0)[i], cells[*c][i]);
+    }
+    CPPUNIT_ASSERT(c == range.end());
+    CPPUNIT_ASSERT_EQUAL(n, range.size());
+  }
+
+  void testFacetCells()
+  {
+    // Compare facet-cell and facet-vertex connectivity with
+    // FacetIterator
+    UnitSquareMesh mesh(4, 4);
+    const ConnectivityArray facet_cells = MeshRange::facet_cells(mesh);
+    const ConnectivityArray facet_vertices
+      = MeshRange::connectivity(mesh, 1, 0);
+    const StridedArray<unsigned int> edges
+      = MeshRange::entity_vertices(mesh, 1);
+    CPPUNIT_ASSERT_EQUAL(mesh.num_facets(), facet_cells.size());
+    CPPUNIT_ASSERT_EQUAL(mesh.num_facets(), edges.size());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, edges.stride());
+
+    for (FacetIterator f(mesh); !f.end(); ++f)
+    {
+      const std::size_t i = f->index();
+      CPPUNIT_ASSERT_EQUAL(f->num_entities(2), facet_cells.size(i));
+      CPPUNIT_ASSERT(facet_cells.end(i) - facet_cells.begin(i)
+                     == (int) facet_cells.size(i));
+      CPPUNIT_ASSERT(facet_cells[i]
+                     == facet_cells.data() + facet_cells.offsets()[i]);
+      for (std::size_t j = 0; j < facet_cells.size(i); ++j)
+        CPPUNIT_ASSERT_EQUAL(f->entities(2)[j], facet_cells[i][j]);
+
+      CPPUNIT_ASSERT_EQUAL((std::size_t) 2, facet_vertices.size(i));
+      for (std::size_t j = 0; j < 2; ++j)
+      {
+        CPPUNIT_ASSERT_EQUAL(f->entities(0)[j], facet_vertices[i][j]);
+        CPPUNIT_ASSERT_EQUAL(f->entities(0)[j], edges[i][j]);
+      }
+    }
+  }
+
+  void testCoordinates()
+  {
+    // Compare coordinates with VertexIterator
+    UnitCubeMesh mesh(2, 3, 4);
+    const StridedArray<double> x = MeshRange::coordinates(mesh);
+    CPPUNIT_ASSERT_EQUAL(mesh.num_vertices(), x.size());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 3, x.stride());
+    for (VertexIterator v(mesh); !v.end(); ++v)
+      for (std::size_t i = 0; i < 3; ++i)
+        CPPUNIT_ASSERT_EQUAL(v->x(i), x[v->index()][i]);
+  }
+
+  void testOptions()
+  {
+    // Compare regular, ghost and all cells with CellIterator, on a
+    // mesh with ghost cells in parallel
+    const std::string ghost_mode = parameters["ghost_mode"];
+    parameters["ghost_mode"] = "shared_vertex";
+    UnitSquareMesh mesh(6, 6);
+    parameters["ghost_mode"] = ghost_mode;
+
+    const std::string options[3] = {"regular", "ghost", "all"};
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      const IndexRange range = MeshRange::entities(mesh, 2, options[k]);
+      IndexRange::iterator c = range.begin();
+      for (CellIterator cell(mesh, options[k]); !cell.end(); ++cell, ++c)
+      {
+        CPPUNIT_ASSERT(c != range.end());
+        CPPUNIT_ASSERT_EQUAL(cell->index(), *c);
+      }
+      CPPUNIT_ASSERT(c == range.end());
+    }
+
+    const IndexRange all = MeshRange::entities(mesh, 2, "all");
+    CPPUNIT_ASSERT_EQUAL(mesh.num_cells(), all.size());
+    CPPUNIT_ASSERT_EQUAL(MeshRange::entities(mesh, 2).end_index(),
+                         MeshRange::entities(mesh, 2, "ghost").begin_index());
+    CPPUNIT_ASSERT_THROW(MeshRange::entities(mesh, 2, "owned"),
+                         std::runtime_error);
+  }
+
+};
+
 class BoundaryExtraction : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(BoundaryExtraction);
@@ -306,6 +460,7 @@ public:
 int main()
 {
   CPPUNIT_TEST_SUITE_REGISTRATION(MeshIterators);
+  CPPUNIT_TEST_SUITE_REGISTRATION(MeshRanges);
 
   // FIXME: The following test breaks in parallel
   if (dolfin::MPI::size(MPI_COMM_WORLD) == 1)
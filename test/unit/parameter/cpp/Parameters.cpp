@@ -16,7 +16,7 @@
 // along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
 //
 // First added:  2011-03-28
-// Last changed: 2011-03-31
+// Last changed: 2026-10-19
 //
 // Unit tests for the parameter library
 
@@ -116,9 +116,143 @@ public:
 
 };
 
+class ParameterHandles : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(ParameterHandles);
+  CPPUNIT_TEST(test_lookup);
+  CPPUNIT_TEST(test_errors);
+  CPPUNIT_TEST(test_unset);
+  CPPUNIT_TEST(test_relookup);
+  CPPUNIT_TEST(test_version);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void test_lookup()
+  {
+    Parameters p("test");
+    create_parameters(p, 0.001);
+
+    // Look up parameters, including nested parameters
+    ParameterHandle<std::string> foo(p, "foo");
+    ParameterHandle<double> tolerance(p, "sub0.tolerance");
+    ParameterHandle<int> maxiter(p, "sub0.maxiter");
+    ParameterHandle<bool> monitor(p, "sub0.sub1.monitor_convergence");
+    CPPUNIT_ASSERT(foo.value() == "bar");
+    CPPUNIT_ASSERT_EQUAL(0.001, tolerance.value());
+    CPPUNIT_ASSERT_EQUAL(100, maxiter.value());
+    CPPUNIT_ASSERT_EQUAL(true, monitor.value());
+
+    // Changed values are seen through the handles
+    p("sub0")["tolerance"] = 1.0e-6;
+    p("sub0")("sub1")["monitor_convergence"] = false;
+    const double t = tolerance;
+    CPPUNIT_ASSERT_EQUAL(1.0e-6, t);
+    CPPUNIT_ASSERT_EQUAL(false, monitor.value());
+  }
+
+  void test_errors()
+  {
+    Parameters p("test");
+    create_parameters(p, 0.001);
+
+    // Type of handle does not match type of parameter
+    CPPUNIT_ASSERT_THROW(ParameterHandle<int>(p, "sub0.tolerance"),
+                         std::runtime_error);
+    CPPUNIT_ASSERT_THROW(ParameterHandle<double>(p, "foo"),
+                         std::runtime_error);
+
+    // Missing parameter or parameter set
+    CPPUNIT_ASSERT_THROW(ParameterHandle<double>(p, "sub0.tol"),
+                         std::runtime_error);
+    CPPUNIT_ASSERT_THROW(ParameterHandle<double>(p, "sub2.tolerance"),
+                         std::runtime_error);
+    CPPUNIT_ASSERT_THROW(ParameterHandle<double>(p, "tolerance"),
+                         std::runtime_error);
+  }
+
+  void test_unset()
+  {
+    Parameters p("test");
+    p.add<double>("tolerance");
+
+    // Reading an unset parameter is an error
+    ParameterHandle<double> tolerance(p, "tolerance");
+    CPPUNIT_ASSERT_THROW(tolerance.value(), std::runtime_error);
+
+    p["tolerance"] = 0.5;
+    CPPUNIT_ASSERT_EQUAL(0.5, tolerance.value());
+  }
+
+  void test_relookup()
+  {
+    Parameters p("test");
+    create_parameters(p, 0.001);
+    ParameterHandle<double> tolerance(p, "sub0.tolerance");
+    CPPUNIT_ASSERT_EQUAL(0.001, tolerance.value());
+
+    // Remove and add parameter again
+    p("sub0").remove("tolerance");
+    CPPUNIT_ASSERT_THROW(tolerance.value(), std::runtime_error);
+    p("sub0").add("tolerance", 0.01);
+    CPPUNIT_ASSERT_EQUAL(0.01, tolerance.value());
+
+    // Assign parameter set (which replaces all parameters)
+    Parameters q("test");
+    create_parameters(q, 0.1);
+    p = q;
+    CPPUNIT_ASSERT_EQUAL(0.1, tolerance.value());
+    p("sub0")["tolerance"] = 0.2;
+    CPPUNIT_ASSERT_EQUAL(0.2, tolerance.value());
+
+    // Assign nested parameter set
+    q("sub0")["tolerance"] = 0.3;
+    p("sub0") = q("sub0");
+    CPPUNIT_ASSERT_EQUAL(0.3, tolerance.value());
+  }
+
+  void test_version()
+  {
+    // Creating, copying and destroying parameter sets does not change
+    // the version
+    const std::size_t version = Parameters::version();
+    {
+      Parameters p("test");
+      create_parameters(p, 0.001);
+      Parameters q(p);
+    }
+    CPPUNIT_ASSERT_EQUAL(version, Parameters::version());
+
+    // Changing a value or removing a parameter does
+    Parameters p("test");
+    create_parameters(p, 0.001);
+    p("sub0")["tolerance"] = 0.1;
+    const std::size_t changed_version = Parameters::version();
+    CPPUNIT_ASSERT(changed_version > version);
+    p("sub0").remove("maxiter");
+    CPPUNIT_ASSERT(Parameters::version() > changed_version);
+  }
+
+private:
+
+  // Create parameters with nested parameter sets
+  static void create_parameters(Parameters& p, double tolerance)
+  {
+    Parameters p0("sub0");
+    Parameters p1("sub1");
+    p1.add("monitor_convergence", true);
+    p0.add("tolerance", tolerance);
+    p0.add("maxiter", 100);
+    p0.add(p1);
+    p.add("foo", "bar");
+    p.add(p0);
+  }
+
+};
 
 int main()
 {
   CPPUNIT_TEST_SUITE_REGISTRATION(InputOutput);
+  CPPUNIT_TEST_SUITE_REGISTRATION(ParameterHandles);
   DOLFIN_TEST;
 }
@@ -140,3 +140,33 @@ def _test_adaptive_solve(problem, goal, u, mesh):
     # Compare computed goal with reference
     reference = 0.12583303389560166
     assert round(assemble(M) - reference, 7) == 0
+
+
+def test_dorfler_mark():
+    mesh = UnitSquareMesh(4, 4)
+    num_cells = MPI.sum(mesh.mpi_comm(), mesh.num_cells())
+
+    # Equal indicators must not be collapsed: 17 of 32 cells are
+    # needed to exceed half of the total
+    indicators = CellFunction("double", mesh, 1.0)
+    markers = CellFunction("bool", mesh, False)
+    dorfler_mark(markers, indicators, 0.5)
+    assert MPI.sum(mesh.mpi_comm(), int(markers.array().sum())) \
+        == num_cells//2 + 1
+
+    # A single dominant indicator is marked on its own
+    indicators.set_all(0.0)
+    for cell in cells(mesh):
+        if cell.global_index() == 0:
+            indicators[cell] = 10.0
+    dorfler_mark(markers, indicators, 0.5)
+    assert MPI.sum(mesh.mpi_comm(), int(markers.array().sum())) == 1
+
+    # All cells are marked for fraction 1
+    dorfler_mark(markers, indicators, 1.0)
+    assert MPI.sum(mesh.mpi_comm(), int(markers.array().sum())) == num_cells
+
+    # A single cell is marked if all indicators are zero
+    indicators.set_all(0.0)
+    dorfler_mark(markers, indicators, 0.5)
+    assert MPI.sum(mesh.mpi_comm(), int(markers.array().sum())) == 1
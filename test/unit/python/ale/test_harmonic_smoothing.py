@@ -23,7 +23,7 @@ from __future__ import print_function
 import pytest
 from dolfin import UnitSquareMesh, BoundaryMesh, Expression, \
                    CellFunction, SubMesh, Constant, MPI, MeshQuality,\
-                   mpi_comm_world
+                   mpi_comm_world, HarmonicSmoothing
 from dolfin_utils.test import skip_in_parallel
 
 def test_HarmonicSmoothing():
@@ -55,6 +55,24 @@ def test_HarmonicSmoothing():
     rmin = MeshQuality.radius_ratio_min_max(mesh)[0]
     assert rmin > magic_number
 
+def test_HarmonicSmoothing_reuse():
+    # Move mesh repeatedly with a persistent smoother
+    mesh = UnitSquareMesh(10, 10)
+    smoothing = HarmonicSmoothing(mesh)
+    disp = Constant((0.01, 0.02))
+    for i in range(3):
+        boundary = BoundaryMesh(mesh, 'exterior')
+        boundary.move(disp)
+        smoothing.smooth(boundary)
+
+        # A translation of the boundary translates the whole mesh
+        boundary_new = BoundaryMesh(mesh, 'exterior')
+        err = abs(boundary.coordinates() - boundary_new.coordinates()).max()
+        assert round(err, 5) == 0
+
+    rmin = MeshQuality.radius_ratio_min_max(mesh)[0]
+    assert rmin > 0.7
+
 @skip_in_parallel
 def test_ale():
     #print("Testing ALE::move(Mesh& mesh0, const Mesh& mesh1)")
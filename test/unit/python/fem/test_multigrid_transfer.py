@@ -0,0 +1,57 @@
+#!/usr/bin/env py.test
+
+"""Unit tests for multigrid transfer operators"""
+
+# Copyright (C) 2026 DOLFIN contributors
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+#
+# First added:  2026-10-19
+# Last changed:
+
+import pytest
+import numpy
+from dolfin import *
+from dolfin_utils.test import skip_in_parallel
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("mesh", [UnitSquareMesh(3, 3), UnitCubeMesh(2, 2, 2)])
+def test_prolongation_reproduces_linears(mesh):
+    hierarchy = MeshHierarchy(mesh, 1)
+    assert hierarchy.size() == 2
+
+    V0 = FunctionSpace(hierarchy.mesh(0), "CG", 1)
+    V1 = FunctionSpace(hierarchy.mesh(1), "CG", 1)
+
+    P = Matrix()
+    R = Matrix()
+    MultigridTransfer.build_prolongation(P, V0, V1, hierarchy)
+    MultigridTransfer.build_restriction(R, V0, V1, hierarchy)
+    assert P.size(0) == V1.dim() and P.size(1) == V0.dim()
+    assert R.size(0) == V0.dim() and R.size(1) == V1.dim()
+
+    # Linear functions are represented exactly on the fine mesh
+    f = Expression("1.0 + 2.0*x[0] - 3.0*x[1]", degree=1)
+    u0 = interpolate(f, V0)
+    u1 = interpolate(f, V1)
+    v = Vector()
+    P.init_vector(v, 0)
+    P.mult(u0.vector(), v)
+    assert numpy.allclose(v.array(), u1.vector().array())
+
+    # Restriction is the transpose of prolongation
+    assert numpy.allclose(R.array(), P.array().T)
@@ -216,6 +216,15 @@ def test_axpy(V, W):
         u.assign(axpy1)
         expr_scalar1 = expr_scalar0 - 4.0
 
+        assert round(u.vector().sum() - \
+                      float(expr_scalar1*u.vector().size()), 7) == 0
+
+        # Terms with the assigned function itself
+        u.vector()[:] = 1.0
+        axpy1 = FunctionAXPY([(2.0, u), (3.0, u1), (1.0, u)])
+        u.assign(axpy1)
+        expr_scalar1 = 2.0 + 3.0*3.0 + 1.0
+
         assert round(u.vector().sum() - \
                       float(expr_scalar1*u.vector().size()), 7) == 0
 
@@ -350,6 +359,25 @@ def test_extrapolation(V):
 
     parameters["allow_extrapolation"] = original_parameters
 
+@skip_in_parallel
+def test_extrapolate():
+    mesh = UnitSquareMesh(4, 4)
+    V = FunctionSpace(mesh, "CG", 1)
+    W = FunctionSpace(mesh, "CG", 2)
+
+    # Linear functions are reproduced exactly
+    v = interpolate(Expression("1.0 + x[0] - 2.0*x[1]", degree=1), V)
+    w = Function(W)
+    w.extrapolate(v)
+    w_exact = interpolate(Expression("1.0 + x[0] - 2.0*x[1]", degree=1), W)
+    assert round((w.vector() - w_exact.vector()).norm("linf"), 10) == 0
+
+    # Reuse of the patch operators gives the same result
+    extrapolation = Extrapolation(V, W)
+    v.vector()[:] = 2.0*v.vector().array()
+    extrapolation.apply(w, v)
+    assert round((w.vector() - 2.0*w_exact.vector()).norm("linf"), 10) == 0
+
 def test_interpolation_jit_rank1(W):
     f = Expression(("1.0", "1.0", "1.0"))
     w = interpolate(f, W)
@@ -220,3 +220,33 @@ def test_1_N_assigner(u0, u1, u2, w, qq, qqv, V, W):
 
     assert np.all(qqv.sub(0, deepcopy=True).vector().array() == qq.vector().array())
     assert np.all(qqv.sub(1, deepcopy=True).vector().array() == u1.vector().array())
+
+@pytest.mark.parametrize('backend', ["PETSc", "uBLAS"])
+def test_split_merge_round_trip(backend, mesh):
+
+    # Check whether backend is available
+    if not has_linear_algebra_backend(backend):
+        pytest.skip('Need %s as backend to run this test' % backend)
+    if backend == "uBLAS" and MPI.size(mesh.mpi_comm()) > 1:
+        pytest.skip('uBLAS backend is serial')
+
+    prev_backend = parameters["linear_algebra_backend"]
+    parameters["linear_algebra_backend"] = backend
+
+    V = FunctionSpace(mesh, "CG", 1)
+    W = VectorFunctionSpace(mesh, "CG", 1)
+    w = Function(W)
+    w.interpolate(Expression(("x[0]", "2*x[1]", "x[2] + x[0]")))
+
+    # Split into components and merge back
+    u = [Function(V) for i in range(3)]
+    FunctionAssigner([V, V, V], W).assign(u, w)
+    for i in range(3):
+        assert np.all(w.sub(i, deepcopy=True).vector().array() ==
+                      u[i].vector().array())
+
+    ww = Function(W)
+    FunctionAssigner(W, [V, V, V]).assign(ww, u)
+    assert np.all(ww.vector().array() == w.vector().array())
+
+    parameters["linear_algebra_backend"] = prev_backend
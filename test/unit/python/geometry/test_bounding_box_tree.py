@@ -26,7 +26,7 @@ import numpy
 from dolfin import BoundingBoxTree
 from dolfin import UnitIntervalMesh, UnitSquareMesh, UnitCubeMesh
 from dolfin import Point
-from dolfin import MPI, mpi_comm_world
+from dolfin import MPI, mpi_comm_world, parameters
 from dolfin_utils.test import skip_in_parallel
 
 
@@ -460,3 +460,57 @@ def test_compute_closest_entity_3d():
     entity, distance = tree.compute_closest_entity(p)
     assert entity == reference[0]
     assert round(distance - reference[1], 7) == 0
+
+#--- refit ---
+
+@skip_in_parallel
+def test_refit():
+
+    reference = set([136, 137])
+
+    mesh = UnitSquareMesh(16, 16)
+    tree = BoundingBoxTree()
+    tree.build(mesh)
+    cost = tree.compute_sah_cost()
+
+    # Translation keeps tree quality, so tree is refitted
+    mesh.translate(Point(1.0, 0.0))
+    assert not tree.refit()
+    assert round(tree.compute_sah_cost() - cost, 7) == 0
+    entities = tree.compute_entity_collisions(Point(1.3, 0.3))
+    assert set(entities) == reference
+
+    # Force rebuild
+    assert tree.refit(0.0)
+    entities = tree.compute_entity_collisions(Point(1.3, 0.3))
+    assert set(entities) == reference
+
+    # Tree attached to mesh is updated automatically
+    tree = mesh.bounding_box_tree()
+    mesh.translate(Point(-1.0, 0.0))
+    tree = mesh.bounding_box_tree()
+    entities = tree.compute_entity_collisions(Point(0.3, 0.3))
+    assert set(entities) == reference
+
+#--- build ---
+
+@skip_in_parallel
+def test_build_threaded():
+
+    mesh = UnitCubeMesh(8, 8, 8)
+    p = Point(0.3, 0.3, 0.3)
+
+    # Tree built with threads is identical to tree built in serial
+    num_threads = parameters["num_threads"]
+    results = []
+    for n in (0, 4):
+        parameters["num_threads"] = n
+        tree = BoundingBoxTree()
+        tree.build(mesh)
+        results.append((tree.compute_sah_cost(),
+                        set(tree.compute_entity_collisions(p)),
+                        tree.compute_closest_entity(Point(0.1, 0.05, -0.1))))
+    parameters["num_threads"] = num_threads
+
+    assert results[0] == results[1]
+    assert results[0][2][0] == 0
@@ -113,3 +113,22 @@ def test_mesh_domains_io(cd_tempdir):
             len(output_mesh.domains().markers(2))
     assert len(input_mesh.domains().markers(3)) == \
             len(output_mesh.domains().markers(3))
+
+@skip_in_parallel
+def test_base64_mesh_io(cd_tempdir):
+    "Test input/output of mesh with base64 encoded arrays"
+    output_mesh = UnitCubeMesh(3, 3, 3)
+
+    encoding = parameters["xml_array_encoding"]
+    parameters["xml_array_encoding"] = "base64"
+    try:
+        File("XMLMesh_test_base64.xml.gz") << output_mesh
+    finally:
+        parameters["xml_array_encoding"] = encoding
+
+    input_mesh = Mesh()
+    File("XMLMesh_test_base64.xml.gz") >> input_mesh
+    assert input_mesh.num_vertices() == output_mesh.num_vertices()
+    assert input_mesh.num_cells() == output_mesh.num_cells()
+    assert (input_mesh.coordinates() == output_mesh.coordinates()).all()
+    assert (input_mesh.cells() == output_mesh.cells()).all()
@@ -0,0 +1,50 @@
+#!/usr/bin/env py.test
+
+"""Unit tests for the binary io library"""
+
+# Copyright (C) 2026 DOLFIN contributors
+#
+# This file is part of DOLFIN.
+#
+# DOLFIN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# DOLFIN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with DOLFIN. If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+import numpy
+from dolfin import *
+from dolfin_utils.test import skip_in_parallel, fixture, cd_tempdir
+
+
+@skip_in_parallel
+@pytest.mark.parametrize("filename", ["mesh.bin", "mesh.bin.gz"])
+def test_mesh_io(cd_tempdir, filename):
+    mesh = UnitCubeMesh(5, 4, 3)
+    File(filename) << mesh
+
+    mesh_in = Mesh()
+    File(filename) >> mesh_in
+    assert mesh_in.num_vertices() == mesh.num_vertices()
+    assert mesh_in.num_cells() == mesh.num_cells()
+    assert numpy.array_equal(mesh_in.coordinates(), mesh.coordinates())
+    assert numpy.array_equal(mesh_in.cells(), mesh.cells())
+
+
+@skip_in_parallel
+def test_vector_io(cd_tempdir):
+    x = Vector(mpi_comm_self(), 197)
+    x[:] = numpy.arange(197, dtype=numpy.float64)
+    File("x.bin") << x
+
+    y = Vector()
+    File("x.bin") >> y
+    assert numpy.array_equal(y.array(), x.array())
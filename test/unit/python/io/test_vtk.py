@@ -25,7 +25,7 @@ from dolfin_utils.test import skip_in_parallel, fixture, tempdir
 # VTK file options
 @fixture
 def file_options():
-    return ["ascii", "base64", "compressed"]
+    return ["ascii", "base64", "compressed", "raw", "raw_compressed"]
 
 @fixture
 def mesh_functions():
@@ -206,3 +206,19 @@ def test_save_3d_tensor(tempfile, file_options):
     f << (u, 1.)
     for file_option in file_options:
         File(tempfile + "u.pvd", file_option) << u
+
+@skip_in_parallel
+def test_save_appended_series(tempfile):
+    mesh = UnitSquareMesh(16, 16)
+    u = Function(FunctionSpace(mesh, "Lagrange", 1))
+    f = File(tempfile + "u.pvd", "raw_compressed")
+    for t in range(3):
+        u.vector()[:] = float(t)
+        f << (u, float(t))
+
+    for t in range(3):
+        with open(tempfile + "u%06d.vtu" % t, "rb") as vtu:
+            data = vtu.read()
+        assert b'header_type="UInt64"' in data
+        assert b'<AppendedData encoding="raw">' in data
+        assert data.count(b'format="appended"') == 5
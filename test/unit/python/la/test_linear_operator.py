@@ -89,3 +89,48 @@ def test_linear_operator(backend):
 
     # Reset backend
     parameters["linear_algebra_backend"] = prev_backend
+
+
+@pytest.mark.parametrize('backend', ["PETSc", skip_in_parallel("uBLAS")])
+def test_matrix_free_operator(backend):
+
+    # Check whether backend is available
+    if not has_linear_algebra_backend(backend):
+        pytest.skip('Need %s as backend to run this test' % backend)
+
+    # Set linear algebra backend
+    prev_backend = parameters["linear_algebra_backend"]
+    parameters["linear_algebra_backend"] = backend
+
+    mesh = UnitSquareMesh(8, 8)
+    V = FunctionSpace(mesh, "Lagrange", 2)
+    u = TrialFunction(V)
+    v = TestFunction(V)
+    f = Constant(1.0)
+    a = dot(grad(u), grad(v))*dx + u*v*dx + u*v*ds
+    L = f*v*dx
+    A = assemble(a)
+    b = assemble(L)
+
+    # Compare action with assembled matrix
+    O = MatrixFreeOperator(Form(a))
+    y0 = Vector()
+    y1 = Vector()
+    A.init_vector(y0, 0)
+    A.init_vector(y1, 0)
+    A.mult(b, y0)
+    O.mult(b, y1)
+    y1.axpy(-1.0, y0)
+    assert round(y1.norm("linf"), 10) == 0
+
+    # Compare solution with Jacobi preconditioned solve of assembled
+    # system
+    x = Vector()
+    solve(A, x, b, "cg", "jacobi")
+    norm_ref = norm(x, "l2")
+    x.zero()
+    solve(O, x, b, "cg", "jacobi")
+    assert round(norm(x, "l2") - norm_ref, 6) == 0
+
+    # Reset backend
+    parameters["linear_algebra_backend"] = prev_backend
@@ -313,6 +313,33 @@ class TestMatrixForAnyBackend:
         B.mult(ones, resultsB)
         assert round(resultsA.norm("l2") - resultsB.norm("l2"), 7) == 0
 
+    def test_mult_vector_space(self, use_backend, any_backend):
+        self.backend, self.sub_backend = any_backend
+
+        # Matrices on vector-valued spaces may use a blocked product
+        mesh = UnitSquareMesh(12, 13)
+        for dim in [2, 3]:
+            V = VectorFunctionSpace(mesh, "Lagrange", 2, dim=dim)
+            u = TrialFunction(V)
+            v = TestFunction(V)
+            f = Function(V)
+            f.interpolate(Expression(["x[0]"] + ["x[1]"]*(dim - 1)))
+            a = inner(grad(u), grad(v))*dx + inner(u, v)*dx
+
+            if use_backend:
+                backend = globals()[self.backend + self.sub_backend + 'Factory'].instance()
+            else:
+                backend = None
+
+            A = assemble(a, backend=backend)
+            b = assemble(action(a, f))
+
+            y = Vector()
+            A.init_vector(y, 0)
+            A.mult(f.vector(), y)
+            y.axpy(-1.0, b)
+            assert round(y.norm("linf"), 10) == 0
+
     #def test_create_from_sparsity_pattern(self):
 
     #def test_size(self):
@@ -26,7 +26,7 @@
 # Modified by Oeyvind Evju 2013
 #
 # First added:  2006-08-08
-# Last changed: 2014-08-12
+# Last changed: 2026-10-19
 
 from __future__ import print_function
 import pytest
@@ -195,6 +195,35 @@ def test_RefineUnitCubeMesh():
     assert mesh.size_global(3) == 15120
 
 
+@skip_in_parallel
+def test_RefineTransfersSubdomainMarkers():
+    """Refine mesh with cell and facet subdomain markers."""
+    mesh = UnitSquareMesh(4, 4)
+    D = mesh.topology().dim()
+    mesh.init(D - 1)
+    mesh.domains().init(D)
+    for cell in cells(mesh):
+        marker = 1 if cell.midpoint().x() < 0.5 else 2
+        mesh.domains().set_marker((cell.index(), marker), D)
+    for facet in facets(mesh):
+        if facet.exterior():
+            mesh.domains().set_marker((facet.index(), 3), D - 1)
+
+    refined_mesh = refine(mesh)
+    assert refined_mesh.domains().num_marked(D) == refined_mesh.num_cells()
+    for cell in cells(refined_mesh):
+        marker = 1 if cell.midpoint().x() < 0.5 else 2
+        assert refined_mesh.domains().get_marker(cell.index(), D) == marker
+
+    refined_mesh.init(D - 1, D)
+    num_exterior = 0
+    for facet in facets(refined_mesh):
+        if facet.exterior():
+            num_exterior += 1
+            assert refined_mesh.domains().get_marker(facet.index(), D - 1) == 3
+    assert refined_mesh.domains().num_marked(D - 1) == num_exterior
+
+
 def test_BoundaryComputation():
     """Compute boundary of mesh."""
     mesh = UnitCubeMesh(2, 2, 2)
@@ -420,3 +449,42 @@ def test_shared_entities():
                     sharing = e.sharing_processes()
                     assert isinstance(sharing, numpy.ndarray)
                     assert (sharing.size > 0) == e.is_shared()
+
+
+def test_smooth():
+    # Distort mesh (boundary vertices stay on the boundary)
+    mesh = UnitSquareMesh(8, 8)
+    x = mesh.coordinates()
+    x[:] = x**2
+    boundary_before = BoundaryMesh(mesh, "exterior").coordinates().copy()
+    rmin_before = MeshQuality.radius_ratio_min_max(mesh)[0]
+
+    mesh.smooth(20)
+
+    # Boundary is unchanged and quality is improved
+    boundary_after = BoundaryMesh(mesh, "exterior").coordinates()
+    assert numpy.allclose(boundary_before, boundary_after)
+    assert MeshQuality.radius_ratio_min_max(mesh)[0] > rmin_before
+
+
+@skip_in_parallel
+def test_version():
+    mesh = UnitSquareMesh(4, 4)
+    version = mesh.version()
+    h = mesh.hash()
+
+    # Computing connectivity and hashing does not change the mesh
+    mesh.init(1)
+    assert mesh.hash() == h
+    assert mesh.version() == version
+
+    # Moving the mesh does
+    mesh.translate(Point(2.0, 0.0))
+    assert mesh.version() > version
+    assert mesh.hash() != h
+
+    # Bounding box tree is rebuilt after the mesh has moved
+    p = Point(2.5, 0.5)
+    assert len(mesh.bounding_box_tree().compute_entity_collisions(p)) > 0
+    mesh.coordinates()[:] *= 2.0
+    assert len(mesh.bounding_box_tree().compute_entity_collisions(p)) == 0
@@ -39,3 +39,22 @@ def test_by_entity_cell_coloring():
         mesh.color("facet")
 
     parameters["graph_coloring_library"] = default_parameter
+
+
+def test_greedy_cell_coloring():
+    """Check that greedy (and balanced) colorings are valid."""
+
+    default_library = parameters["graph_coloring_library"]
+    default_balanced = parameters["balanced_graph_coloring"]
+    parameters["graph_coloring_library"] = "greedy"
+    for balanced in [False, True]:
+        parameters["balanced_graph_coloring"] = balanced
+        mesh = UnitCubeMesh(8, 8, 8)
+        mesh.color("vertex")
+        colors = MeshColoring.cell_colors(mesh, "vertex")
+        for v in vertices(mesh):
+            cell_colors = [colors[c] for c in v.entities(3)]
+            assert len(cell_colors) == len(set(cell_colors))
+
+    parameters["graph_coloring_library"] = default_library
+    parameters["balanced_graph_coloring"] = default_balanced
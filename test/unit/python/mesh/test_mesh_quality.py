@@ -106,3 +106,39 @@ def test_radius_ratio_min_radius_ratio_max():
     rmin, rmax = MeshQuality.radius_ratio_min_max(mesh3d)
     assert round(rmin - 0.0, 7) == 0
     assert round(rmax - 1.0, 7) == 0
+
+
+def test_statistics():
+
+    # Right triangles: minimum angle 45 degrees, edge ratio 1/sqrt(2)
+    mesh = UnitSquareMesh(12, 12)
+    q = MeshQuality.statistics(mesh, 10)
+    assert q.num_cells() == mesh.size_global(2)
+    assert round(q.min("min_angle") - 45.0, 7) == 0
+    assert round(q.max("edge_ratio") - 1.0/sqrt(2.0), 7) == 0
+    for measure in ("radius_ratio", "min_angle", "edge_ratio"):
+        assert len(q.bins(measure)) == 10
+        assert round(sum(q.histogram(measure)) - q.num_cells(), 7) == 0
+
+    # Congruent tetrahedra: minimum dihedral angle 45 degrees, edge
+    # ratio 1/sqrt(3)
+    mesh = UnitCubeMesh(4, 4, 4)
+    q = MeshQuality.statistics(mesh)
+    assert round(q.min("radius_ratio") - 0.717438935214, 7) == 0
+    assert round(q.max("radius_ratio") - 0.717438935214, 7) == 0
+    assert round(q.min("min_angle") - 45.0, 7) == 0
+    assert round(q.min("edge_ratio") - 1.0/sqrt(3.0), 7) == 0
+    assert round(sum(q.histogram("edge_ratio")) - mesh.size_global(3), 7) == 0
+
+    # Distorted mesh: compare against the per-cell radius ratios
+    mesh = UnitSquareMesh(12, 12)
+    x = mesh.coordinates()
+    x[:, 0] = x[:, 0]**2
+    x[:, 1] = x[:, 1] + 0.3*x[:, 0]*x[:, 1]
+    q = MeshQuality.statistics(mesh)
+    r = [cell.radius_ratio() for cell in cells(mesh)]
+    rmin = MPI.min(mesh.mpi_comm(), min(r))
+    rmax = MPI.max(mesh.mpi_comm(), max(r))
+    assert rmin < rmax
+    assert round(q.min("radius_ratio") - rmin, 7) == 0
+    assert round(q.max("radius_ratio") - rmax, 7) == 0
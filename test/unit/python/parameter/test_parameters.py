@@ -146,3 +146,25 @@ def test_solver_parameters():
     # Reset parameters so that other tests will continue to work
     parameters["krylov_solver"]["absolute_tolerance"] = absolute_tolerance
     parameters["lu_solver"]["reuse_factorization"] = reuse_factorization
+
+def test_version():
+    "Test that the parameter version changes when parameters change"
+    p = Parameters("test")
+    p.add("tolerance", 1.0e-6)
+    p.add(Parameters("nested"))
+    p["nested"].add("flag", False)
+
+    version = Parameters.version()
+    assert version > 0
+    assert Parameters.version() == version
+
+    p["tolerance"] = 1.0e-8
+    assert Parameters.version() > version
+
+    version = Parameters.version()
+    p["nested"]["flag"] = True
+    assert Parameters.version() > version
+
+    version = Parameters.version()
+    p.remove("tolerance")
+    assert Parameters.version() > version